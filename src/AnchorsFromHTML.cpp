@@ -36,17 +36,175 @@
 #include "AnchorsFromHTML.h"
 #include "Extractor_Utils.h"
 
-#include <boost/regex.hpp>
+#include <algorithm>
+#include <cctype>
 
 #include "spdlog/spdlog.h"
 
-// gumbo-query
+using namespace std::string_literals;
 
-#include "gq/Document.h"
-#include "gq/Node.h"
-#include "gq/Selection.h"
+namespace
+{
+    bool IsSpace(char c)
+    {
+        return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\f';
+    }
 
-using namespace std::string_literals;
+    std::string ToLower(EM::sv text)
+    {
+        std::string result;
+        result.reserve(text.size());
+        std::transform(text.begin(), text.end(), std::back_inserter(result),
+                [] (unsigned char c) { return std::tolower(c); });
+        return result;
+    }
+
+    // '<a>', '<a ' or '<a\n' in any case.
+
+    bool IsAnchorStart(const char* pos, const char* end)
+    {
+        return end - pos > 2 && (pos[1] == 'a' || pos[1] == 'A') && (pos[2] == '>' || pos[2] == ' ' || pos[2] == '\n');
+    }
+
+    bool IsAnchorEnd(const char* pos, const char* end)
+    {
+        return end - pos > 3 && pos[1] == '/' && (pos[2] == 'a' || pos[2] == 'A') && pos[3] == '>';
+    }
+
+    void AppendCodePoint(char32_t code_point, std::string& text)
+    {
+        if (code_point < 0x80)
+        {
+            text += static_cast<char>(code_point);
+        }
+        else if (code_point < 0x800)
+        {
+            text += static_cast<char>(0xC0 | (code_point >> 6));
+            text += static_cast<char>(0x80 | (code_point & 0x3F));
+        }
+        else if (code_point < 0x10000)
+        {
+            text += static_cast<char>(0xE0 | (code_point >> 12));
+            text += static_cast<char>(0x80 | ((code_point >> 6) & 0x3F));
+            text += static_cast<char>(0x80 | (code_point & 0x3F));
+        }
+        else
+        {
+            text += static_cast<char>(0xF0 | (code_point >> 18));
+            text += static_cast<char>(0x80 | ((code_point >> 12) & 0x3F));
+            text += static_cast<char>(0x80 | ((code_point >> 6) & 0x3F));
+            text += static_cast<char>(0x80 | (code_point & 0x3F));
+        }
+    }
+
+    // anchor text and attribute values with their character references decoded.
+
+    void AppendDecodedText(EM::sv text, std::string& result, bool in_attribute)
+    {
+        while (! text.empty())
+        {
+            auto amp = text.find('&');
+            result += text.substr(0, amp);
+            if (amp == EM::sv::npos)
+            {
+                break;
+            }
+            auto reference_end = amp;
+            AppendCodePoint(DecodeHTMLEntity(text, reference_end, in_attribute), result);
+            text.remove_prefix(reference_end);
+        }
+    }
+
+    // the attributes of a start tag, first one wins, like the HTML parser does.
+
+    void ExtractAttributes(EM::sv attributes, AnchorData& anchor)
+    {
+        bool have_href{false};
+        bool have_name{false};
+        bool have_id{false};
+
+        std::size_t pos = 0;
+        while (pos < attributes.size())
+        {
+            while (pos < attributes.size() && (IsSpace(attributes[pos]) || attributes[pos] == '/'))
+            {
+                ++pos;
+            }
+            auto name_start = pos;
+            while (pos < attributes.size() && ! IsSpace(attributes[pos]) && attributes[pos] != '=' && attributes[pos] != '/')
+            {
+                ++pos;
+            }
+            if (pos == name_start)
+            {
+                break;
+            }
+            const auto attribute_name = ToLower(attributes.substr(name_start, pos - name_start));
+
+            while (pos < attributes.size() && IsSpace(attributes[pos]))
+            {
+                ++pos;
+            }
+            EM::sv value;
+            if (pos < attributes.size() && attributes[pos] == '=')
+            {
+                ++pos;
+                while (pos < attributes.size() && IsSpace(attributes[pos]))
+                {
+                    ++pos;
+                }
+                if (pos < attributes.size() && (attributes[pos] == '"' || attributes[pos] == '\''))
+                {
+                    const char quote = attributes[pos++];
+                    auto value_end = std::min(attributes.find(quote, pos), attributes.size());
+                    value = attributes.substr(pos, value_end - pos);
+                    pos = value_end + 1;
+                }
+                else
+                {
+                    auto value_start = pos;
+                    while (pos < attributes.size() && ! IsSpace(attributes[pos]))
+                    {
+                        ++pos;
+                    }
+                    value = attributes.substr(value_start, pos - value_start);
+                }
+            }
+
+            auto keep_value([value] (bool& have_it, std::string& destination)
+                {
+                    if (! have_it)
+                    {
+                        AppendDecodedText(value, destination, true);
+                        have_it = true;
+                    }
+                });
+            if (attribute_name == "href")
+            {
+                keep_value(have_href, anchor.href_);
+            }
+            else if (attribute_name == "name")
+            {
+                keep_value(have_name, anchor.name_);
+            }
+            else if (attribute_name == "id")
+            {
+                keep_value(have_id, anchor.id_);
+            }
+        }
+    }
+
+    // href and name sometimes are quoted twice so remove the extra quotes.
+
+    void RemoveQuotes(std::string& value)
+    {
+        if (value.size() > 1 && (value[0] == '"' || value[0] == '\''))
+        {
+            value.erase(0, 1);
+            value.resize(value.size() - 1);
+        }
+    }
+}
 
 /*
  *--------------------------------------------------------------------------------------
@@ -80,6 +238,32 @@ AnchorsFromHTML::const_iterator AnchorsFromHTML::end () const
     return {};
 }		/* -----  end of method AnchorsFromHTML::end  ----- */
 
+/*
+ * ===  FUNCTION  ======================================================================
+ *         Name:  AnchorsFromHTML::FindAnchorNamed
+ *  Description:  anchors are indexed as they are found so we only need to
+ *                look further into the HTML when we haven't seen the name yet.
+ * =====================================================================================
+ */
+AnchorsFromHTML::const_iterator AnchorsFromHTML::FindAnchorNamed (EM::sv name) const
+{
+    const auto looking_for = ToLower(name);
+
+    auto next_anchor = found_anchors_.empty() ? begin() : const_iterator(this, found_anchors_.size() - 1);
+    while (true)
+    {
+        if (auto found = anchor_index_.find(looking_for); found != anchor_index_.end())
+        {
+            return const_iterator(this, found->second);
+        }
+        if (next_anchor == end())
+        {
+            return end();
+        }
+        ++next_anchor;
+    }
+}		// -----  end of method AnchorsFromHTML::FindAnchorNamed  -----
+
 /*
  *--------------------------------------------------------------------------------------
  *       Class:  AnchorsFromHTML::iterator
@@ -108,6 +292,14 @@ AnchorsFromHTML::anchor_itor::anchor_itor (const AnchorsFromHTML* anchors)
 
 }  /* -----  end of method AnchorsFromHTML::iterator::AnchorsFromHTML::iterator  (constructor)  ----- */
 
+AnchorsFromHTML::anchor_itor::anchor_itor (const AnchorsFromHTML* anchors, std::size_t saved_anchor)
+    : anchors_{anchors}, html_{anchors->html_}, the_anchor_{anchors->found_anchors_[saved_anchor]},
+    using_saved_anchor{static_cast<int>(saved_anchor)}
+{
+    anchor_search_start = the_anchor_.anchor_content_.get().end();
+    anchor_search_end = html_.get().end();
+}  /* -----  end of method AnchorsFromHTML::iterator::AnchorsFromHTML::iterator  (constructor)  ----- */
+
 AnchorsFromHTML::anchor_itor& AnchorsFromHTML::anchor_itor::operator++ ()
 {
     auto next_anchor = FindNextAnchor(anchor_search_start, anchor_search_end);
@@ -126,26 +318,39 @@ AnchorsFromHTML::anchor_itor& AnchorsFromHTML::anchor_itor::operator++ ()
     return *this;
 }		/* -----  end of method AnchorsFromHTML::iterator::operator++  ----- */
 
+/*
+ * ===  FUNCTION  ======================================================================
+ *         Name:  AnchorsFromHTML::iterator::FindNextAnchor
+ *  Description:  an anchor starts with '<a>', '<a ' or '<a\n' (any case) and its
+ *                start tag runs to the next '>'.
+ * =====================================================================================
+ */
 std::optional<AnchorData> AnchorsFromHTML::iterator::FindNextAnchor (const char* begin, const char* end)
 {
     if (++using_saved_anchor < anchors_->found_anchors_.size())
     {
         return std::optional<AnchorData>{anchors_->found_anchors_[using_saved_anchor]};
     }
-    static const boost::regex re_anchor_begin{R"***((?:<a>|<a |<a\n)[^>]*?>)***",
-        boost::regex_constants::normal | boost::regex_constants::icase};
-
-    // we need to prime the pump by finding the beginning of the first anchor.
+    if (anchors_->found_all_anchors_)
+    {
+        return std::nullopt;
+    }
 
-    boost::cmatch anchor_begin_match;
-    bool found_it = boost::regex_search(begin, end, anchor_begin_match, re_anchor_begin);
-    if (! found_it)
+    const char* anchor_begin = std::find(begin, end, '<');
+    while (anchor_begin != end && ! IsAnchorStart(anchor_begin, end))
+    {
+        anchor_begin = std::find(anchor_begin + 1, end, '<');
+    }
+    const char* start_tag_end = anchor_begin == end ? end : std::find(anchor_begin + 2, end, '>');
+    if (start_tag_end == end)
     {
-        // we have no anchors in this document
+        // we have no more anchors in this document
+
+        anchors_->found_all_anchors_ = true;
         return std::nullopt;
     }
 
-    auto anchor_end = FindAnchorEnd(anchor_begin_match[0].first,  end, 1);
+    auto anchor_end = FindAnchorEnd(anchor_begin, end);
     if (anchor_end == nullptr)
     {
         // this should not happen -- we have an incomplete anchor element.
@@ -153,85 +358,88 @@ std::optional<AnchorData> AnchorsFromHTML::iterator::FindNextAnchor (const char*
         throw HTMLException("Missing anchor end.");
     }
 
-    AnchorData anchor{ExtractDataFromAnchor(anchor_begin_match[0].first, anchor_end , html_)};
+    AnchorData anchor{ExtractDataFromAnchor(anchor_begin, start_tag_end + 1, anchor_end, html_)};
  
-    // cache our anchor in case there is a 'next' time.
+    // cache and index our anchor in case there is a 'next' time.
 
     anchors_->found_anchors_.push_back(anchor);
+    for (const auto* key : {&anchor.name_, &anchor.id_})
+    {
+        if (! key->empty())
+        {
+            anchors_->anchor_index_.try_emplace(ToLower(*key), anchors_->found_anchors_.size() - 1);
+        }
+    }
     return std::optional<AnchorData>{anchor};
 }		/* -----  end of method AnchorsFromHTML::iterator::FindNextAnchor  ----- */
 
-const char* AnchorsFromHTML::iterator::FindAnchorEnd (const char* begin, const char* end, int level)
+/*
+ * ===  FUNCTION  ======================================================================
+ *         Name:  AnchorsFromHTML::iterator::FindAnchorEnd
+ *  Description:  handle 'nested' anchors by counting starts and ends until
+ *                we get back to our level.
+ * =====================================================================================
+ */
+const char* AnchorsFromHTML::iterator::FindAnchorEnd (const char* begin, const char* end)
 {
-    if (level >= 5)
-    {   
-        spdlog::info("Something wrong...anchors too deeply nested.");
-        return nullptr;
-    }
+    int level{1};
 
-    // handle 'nested' anchors.
-
-    static const boost::regex re_anchor_end_or_begin{R"***(</a>|(?:(?:<a>|<a |<a\n).*?>))***",
-        boost::regex_constants::normal | boost::regex_constants::icase};
-    static const boost::regex re_anchor_begin{R"***((?:<a |<a>|<a\n).*?>)***",
-        boost::regex_constants::normal | boost::regex_constants::icase};
-
-    boost::cmatch anchor_end_or_begin;
-    bool found_it = boost::regex_search(++begin, end, anchor_end_or_begin, re_anchor_end_or_begin);
-    if (found_it)
+    for (const char* next = std::find(begin + 1, end, '<'); next != end; next = std::find(next + 1, end, '<'))
     {
-        // we have either an end anchor or begin anchor
-
-        if (boost::regex_match(anchor_end_or_begin[0].first, anchor_end_or_begin[0].second, re_anchor_begin))
+        if (IsAnchorEnd(next, end))
         {
-            // found a nested anchor start
-
-            return FindAnchorEnd(anchor_end_or_begin[0].first, end, ++level);
+            --level;
+            if (level == 0)
+            {
+                return next + 4;
+            }
+            continue;
         }
-
-        // at this point, we are working with an anchor end. let's see if we're done
-
-        --level;
-        if (level > 0)
+        if (IsAnchorStart(next, end) && std::find(next + 2, end, '>') != end)
         {
-            // not finished but we have completed a nested anchor
-
-            return FindAnchorEnd(anchor_end_or_begin[0].first, end, level);
+            ++level;
+            if (level >= 5)
+            {   
+                spdlog::info("Something wrong...anchors too deeply nested.");
+                return nullptr;
+            }
         }
-
-        // now I should be looking for the end of the top-level anchor.
-
-        return anchor_end_or_begin[0].second;
     }
     return nullptr;
 }		/* -----  end of method AnchorsFromHTML::iterator::FindAnchorEnd  ----- */
 
-AnchorData AnchorsFromHTML::iterator::ExtractDataFromAnchor (const char* start, const char* end, EM::HTMLContent html)
+/*
+ * ===  FUNCTION  ======================================================================
+ *         Name:  AnchorsFromHTML::iterator::ExtractDataFromAnchor
+ *  Description:  attributes come from the start tag and the text is whatever is
+ *                outside of tags up to the '</a>'.
+ * =====================================================================================
+ */
+AnchorData AnchorsFromHTML::iterator::ExtractDataFromAnchor (const char* start, const char* start_tag_end, const char* end, EM::HTMLContent html)
 {
-    CDocument whole_anchor;
-    const std::string working_copy{start, end};
-    whole_anchor.parse(working_copy);
-    auto the_anchor = whole_anchor.find("a"s);
-    BOOST_ASSERT_MSG(the_anchor.nodeNum() > 0, "No anchor found in extractecd anchor!!");
+    AnchorData result;
+    result.anchor_content_ = EM::AnchorContent{EM::sv(start, end - start)};
+    result.html_document_ = html;
 
-    AnchorData result{the_anchor.nodeAt(0).attribute("href"), the_anchor.nodeAt(0).attribute("name"),
-        the_anchor.nodeAt(0).text(), EM::AnchorContent{EM::sv(start, end - start)}, html};
+    ExtractAttributes(EM::sv(start + 2, start_tag_end - start - 3), result);
 
-    // href sometimes is quoted, so remove them.
-
-    if (result.href_[0] == '"' || result.href_[0] == "(')"[0])
+    EM::sv content(start_tag_end, std::max<std::ptrdiff_t>(end - 4 - start_tag_end, 0));
+    while (! content.empty())
     {
-        result.href_.erase(0, 1);
-        result.href_.resize(result.href_.size() - 1);
+        auto tag_begin = content.find('<');
+        AppendDecodedText(content.substr(0, tag_begin), result.text_, false);
+        if (tag_begin == EM::sv::npos)
+        {
+            break;
+        }
+        auto tag_end = content.find('>', tag_begin);
+        content.remove_prefix(tag_end == EM::sv::npos ? content.size() : tag_end + 1);
     }
-    // check for name too
 
-    if (result.name_[0] == '"' || result.name_[0] == "(')"[0])
-    {
-        result.name_.erase(0, 1);
-        result.name_.resize(result.name_.size() - 1);
-    }
-//    result.CleanData();
+    RemoveQuotes(result.href_);
+    RemoveQuotes(result.name_);
+    RemoveQuotes(result.id_);
+
     return result;
 }		/* -----  end of method AnchorsFromHTML::iterator::ExtractDataFromAnchor  ----- */
 
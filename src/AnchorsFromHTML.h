@@ -40,6 +40,7 @@
 #include <iterator>
 #include <optional>
 #include <string>
+#include <unordered_map>
 #include <vector>
  
 #include "Extractor.h"
@@ -48,6 +49,7 @@ struct AnchorData
 {
     std::string href_;
     std::string name_;
+    std::string id_;
     std::string text_;
     EM::AnchorContent anchor_content_;
     EM::HTMLContent html_document_;
@@ -85,6 +87,11 @@ public:
 
     [[nodiscard]] bool empty() const { return html_.get().empty(); }
 
+    // the first anchor whose name or id matches, ignoring case.
+    // we only look as far into the HTML as we need to.
+
+    [[nodiscard]] const_iterator FindAnchorNamed(EM::sv name) const;
+
     /* ====================  MUTATORS      ======================================= */
 
     /* ====================  OPERATORS     ======================================= */
@@ -106,6 +113,11 @@ private:
 
     mutable AnchorList found_anchors_;
 
+    // lower case name or id -> position in found_anchors_
+
+    mutable std::unordered_map<std::string, std::size_t> anchor_index_;
+    mutable bool found_all_anchors_ = false;
+
 }; /* -----  end of class AnchorsFromHTML  ----- */
 
 
@@ -153,11 +165,18 @@ protected:
     // ====================  DATA MEMBERS  ======================================= 
 
 private:
+
+    friend class AnchorsFromHTML;
+
+    // positioned at an anchor we have already found.
+
+    anchor_itor(const AnchorsFromHTML* anchors, std::size_t saved_anchor);
+
     // ====================  METHODS       ======================================= 
 
     std::optional<AnchorData> FindNextAnchor(const char* begin, const char* end);
-    const char* FindAnchorEnd(const char* begin, const char* end, int level);
-    AnchorData ExtractDataFromAnchor (const char* start, const char* end, EM::HTMLContent html);
+    const char* FindAnchorEnd(const char* begin, const char* end);
+    AnchorData ExtractDataFromAnchor (const char* start, const char* start_tag_end, const char* end, EM::HTMLContent html);
 
     // ====================  DATA MEMBERS  ======================================= 
 
@@ -0,0 +1,149 @@
+// =====================================================================================
+//
+//       Filename:  BoundedQueue.h
+//
+//    Description:  Fixed capacity multi-producer, multi-consumer queue used to
+//                  connect the stages of our processing pipeline.
+//
+//        Version:  1.0
+//        Created:  10/17/2026 01:14:52 PM
+//       Revision:  none
+//       Compiler:  g++
+//
+//         Author:  David P. Riedel (), driedel@cox.net
+//        License:  GNU General Public License -v3
+//
+// =====================================================================================
+
+// =====================================================================================
+//        Class:  BoundedQueue
+//  Description:  Producers block when the queue is full so a fast stage can't
+//                run away from a slow one and pile up memory (each item we pass
+//                along keeps its input file mapped).  Consumers block when the
+//                queue is empty.
+//
+//                When the last producer is done, it closes the queue.  Consumers
+//                then drain whatever is left and Pop returns nothing.
+// =====================================================================================
+
+
+#ifndef  BoundedQueue_INC
+#define  BoundedQueue_INC
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <mutex>
+#include <optional>
+
+#include "Extractor_Utils.h"
+
+template<typename T>
+class BoundedQueue
+{
+public:
+    // ====================  LIFECYCLE     =======================================
+
+    explicit BoundedQueue (std::size_t max_depth)
+        : max_depth_{max_depth}
+    {
+        BOOST_ASSERT_MSG(max_depth_ > 0, "Queue depth must be at least 1.");
+    }
+    BoundedQueue(const BoundedQueue& rhs) = delete;
+    BoundedQueue(BoundedQueue&& rhs) = delete;
+
+    ~BoundedQueue () = default;
+
+    // ====================  ACCESSORS     =======================================
+
+    // ====================  MUTATORS      =======================================
+
+    // blocks until there is room.  Only producers close the queue
+    // so it is an error to push after closing.
+
+    void Push(T item)
+    {
+        {
+            std::unique_lock<std::mutex> lk{m_};
+            not_full_.wait(lk, [this] { return items_.size() < max_depth_ || closed_; });
+            BOOST_ASSERT_MSG(! closed_, "Can't add items to a closed queue.");
+            items_.push_back(std::move(item));
+        }
+        not_empty_.notify_one();
+    }
+
+    // blocks until there is something to take. Returns nothing when the
+    // queue has been closed and emptied.
+
+    std::optional<T> Pop()
+    {
+        std::optional<T> item;
+        {
+            std::unique_lock<std::mutex> lk{m_};
+            not_empty_.wait(lk, [this] { return ! items_.empty() || closed_; });
+            if (items_.empty())
+            {
+                return std::nullopt;
+            }
+            item.emplace(std::move(items_.front()));
+            items_.pop_front();
+        }
+        not_full_.notify_one();
+        return item;
+    }
+
+    // doesn't wait. Returns nothing if the queue is empty right now.
+
+    std::optional<T> TryPop()
+    {
+        std::optional<T> item;
+        {
+            std::lock_guard<std::mutex> lk{m_};
+            if (items_.empty())
+            {
+                return std::nullopt;
+            }
+            item.emplace(std::move(items_.front()));
+            items_.pop_front();
+        }
+        not_full_.notify_one();
+        return item;
+    }
+
+    void Close()
+    {
+        {
+            std::lock_guard<std::mutex> lk{m_};
+            closed_ = true;
+        }
+        not_empty_.notify_all();
+        not_full_.notify_all();
+    }
+
+    // ====================  OPERATORS     =======================================
+
+    BoundedQueue& operator = (const BoundedQueue& rhs) = delete;
+    BoundedQueue& operator = (BoundedQueue&& rhs) = delete;
+
+protected:
+    // ====================  METHODS       =======================================
+
+    // ====================  DATA MEMBERS  =======================================
+
+private:
+    // ====================  METHODS       =======================================
+
+    // ====================  DATA MEMBERS  =======================================
+
+    std::mutex m_;
+    std::condition_variable not_empty_;
+    std::condition_variable not_full_;
+
+    std::deque<T> items_;
+
+    std::size_t max_depth_;
+    bool closed_ = false;
+
+}; // -----  end of class BoundedQueue  -----
+
+#endif   // ----- #ifndef BoundedQueue_INC  -----
@@ -0,0 +1,211 @@
+// =====================================================================================
+//
+//       Filename:  CoverPageMatchers.cpp
+//
+//    Description:  Implementation of the cover page matchers
+//
+//        Version:  1.0
+//        Created:  10/18/2026 12:16:05 AM
+//       Revision:  none
+//       Compiler:  g++
+//
+//         Author:  David P. Riedel (), driedel@cox.net
+//        License:  GNU General Public License -v3
+//
+// =====================================================================================
+
+#include <algorithm>
+#include <cctype>
+#include <initializer_list>
+
+#include "CoverPageMatchers.h"
+#include "Extractor_Utils.h"
+
+namespace
+{
+    // what \b considers part of a word. ('.' matches anything at all.)
+
+    bool IsWord(char c)
+    {
+        return std::isalnum(static_cast<unsigned char>(c)) || c == '_';
+    }
+
+    bool IsDigit(char c)
+    {
+        return c >= '0' && c <= '9';
+    }
+
+    bool WordBoundary(EM::sv text, std::size_t pos)
+    {
+        const bool word_before = pos > 0 && IsWord(text[pos - 1]);
+        const bool word_after = pos < text.size() && IsWord(text[pos]);
+        return word_before != word_after;
+    }
+
+    // \b[1-9](?:[0-9]{0,2})(?:,[0-9]{3})+\b
+    //
+    // the digits before the first comma have to be all there is of them, so there is at
+    // most 1 way to start.  We take as many ',ddd' groups as we can.  If the last one
+    // runs into more word characters we give it back, in which case the next character
+    // is a ',' so the one before will do.
+
+    class NumberIndex
+    {
+    public:
+
+        explicit NumberIndex(EM::sv text)
+            : number_end_(text.size() + 1, npos), next_number_(text.size() + 1, npos)
+        {
+            std::vector<std::size_t> groups(text.size() + 1, 0);
+            for (std::size_t pos = text.size(); pos-- > 0; )
+            {
+                if (text[pos] == ',' && text.size() - pos > 3 && IsDigit(text[pos + 1]) && IsDigit(text[pos + 2]) && IsDigit(text[pos + 3]))
+                {
+                    groups[pos] = 1 + (pos + 4 <= text.size() ? groups[pos + 4] : 0);
+                }
+            }
+            for (std::size_t pos = text.size(); pos-- > 0; )
+            {
+                next_number_[pos] = next_number_[pos + 1];
+
+                if (text[pos] < '1' || text[pos] > '9' || (pos > 0 && IsWord(text[pos - 1])))
+                {
+                    continue;
+                }
+                std::size_t first_comma = pos + 1;
+                while (first_comma < text.size() && first_comma - pos < 4 && IsDigit(text[first_comma]))
+                {
+                    ++first_comma;
+                }
+                if (first_comma - pos > 3 || first_comma == text.size() || groups[first_comma] == 0)
+                {
+                    continue;
+                }
+                std::size_t end = first_comma + 4 * groups[first_comma];
+                if (end < text.size() && IsWord(text[end]))
+                {
+                    if (groups[first_comma] == 1)
+                    {
+                        continue;
+                    }
+                    end -= 4;
+                }
+                number_end_[pos] = end;
+                next_number_[pos] = pos;
+            }
+        }
+
+        // the first number starting in [from, to].  The end is npos if there isn't one.
+
+        [[nodiscard]] std::pair<std::size_t, std::size_t> FirstNumber(std::size_t from, std::size_t to) const
+        {
+            if (from >= next_number_.size() || next_number_[from] > to)
+            {
+                return {npos, npos};
+            }
+            return {next_number_[from], number_end_[next_number_[from]]};
+        }
+
+    private:
+
+        std::vector<std::size_t> number_end_;
+        std::vector<std::size_t> next_number_;
+    };
+
+    // the first of 'words' to start in [from, to], ignoring case.  The end is npos if none do.
+
+    std::size_t FirstWordEnd(EM::sv text, std::size_t from, std::size_t to, std::initializer_list<EM::sv> words)
+    {
+        for (std::size_t pos = from; pos <= to && pos < text.size(); ++pos)
+        {
+            for (auto word : words)
+            {
+                if (WordAt(text, pos, word))
+                {
+                    return pos + word.size();
+                }
+            }
+        }
+        return npos;
+    }
+}
+
+/*
+ * ===  FUNCTION  ======================================================================
+ *         Name:  FindYesNoShares
+ *  Description:  the regex would take the closest 'no' which has a number after it
+ *                and then the closest number.
+ * =====================================================================================
+ */
+void FindYesNoShares (EM::sv text, std::vector<EM::sv>& matches)
+{
+    const NumberIndex numbers{text};
+
+    std::size_t pos = 0;
+    while (pos + 3 <= text.size())
+    {
+        std::size_t match_end = npos;
+        if (WordAt(text, pos, "yes") && WordBoundary(text, pos) && WordBoundary(text, pos + 3))
+        {
+            for (std::size_t no = pos + 4; no <= pos + 13 && match_end == npos; ++no)
+            {
+                if (WordAt(text, no, "no"))
+                {
+                    match_end = numbers.FirstNumber(no + 3, no + 1002).second;
+                }
+            }
+        }
+        if (match_end == npos)
+        {
+            ++pos;
+            continue;
+        }
+        matches.emplace_back(text.substr(pos, match_end - pos));
+        pos = match_end;
+    }
+}		// -----  end of function FindYesNoShares  -----
+
+/*
+ * ===  FUNCTION  ======================================================================
+ *         Name:  FindIndicatorShares
+ *  Description:  the trailing words are optional so the first number after the
+ *                lead in is always the one the regex settles on.
+ * =====================================================================================
+ */
+void FindIndicatorShares (EM::sv text, std::vector<EM::sv>& matches)
+{
+    const NumberIndex numbers{text};
+
+    std::size_t pos = 0;
+    while (pos < text.size())
+    {
+        std::size_t lead_in_end = npos;
+        if (WordBoundary(text, pos))
+        {
+            if (WordAt(text, pos, "inidcate") && WordBoundary(text, pos + 8))
+            {
+                lead_in_end = pos + 8;
+            }
+            else if (WordAt(text, pos, "as of ") && WordBoundary(text, pos + 6))
+            {
+                lead_in_end = pos + 6;
+            }
+            else if (WordAt(text, pos, "number of") && WordBoundary(text, pos + 9))
+            {
+                lead_in_end = pos + 9;
+            }
+        }
+        std::size_t match_end = lead_in_end == npos ? npos : numbers.FirstNumber(lead_in_end + 1, lead_in_end + 200).second;
+        if (match_end == npos)
+        {
+            ++pos;
+            continue;
+        }
+        if (auto words_end = FirstWordEnd(text, match_end + 1, match_end + 100, {"shares", "common", "outstanding"}); words_end != npos)
+        {
+            match_end = words_end;
+        }
+        matches.emplace_back(text.substr(pos, match_end - pos));
+        pos = match_end;
+    }
+}		// -----  end of function FindIndicatorShares  -----
@@ -0,0 +1,44 @@
+// =====================================================================================
+//
+//       Filename:  CoverPageMatchers.h
+//
+//    Description:  Linear time replacements for the cover page shares outstanding regexes
+//
+//        Version:  1.0
+//        Created:  10/18/2026 12:16:05 AM
+//       Revision:  none
+//       Compiler:  g++
+//
+//         Author:  David P. Riedel (), driedel@cox.net
+//        License:  GNU General Public License -v3
+//
+// =====================================================================================
+
+
+// =====================================================================================
+//  Description:  Each function finds the same matches, in the same order, as running a
+//                boost::regex_iterator over the text with the pattern given.  The
+//                regexes can backtrack through 1000s of characters for each place a
+//                match might start.  Here we first note, for every position, whether a
+//                number starts there and where it ends so trying a start position
+//                takes constant time.
+// =====================================================================================
+
+
+#ifndef  CoverPageMatchers_INC
+#define  CoverPageMatchers_INC
+
+#include <vector>
+
+#include "Extractor.h"
+
+// \byes\b.{1,10}?no.{1,1000}?\b[1-9](?:[0-9]{0,2})(?:,[0-9]{3})+\b     (ignoring case)
+
+void FindYesNoShares(EM::sv text, std::vector<EM::sv>& matches);
+
+// (?:\binidcate\b|\bas of \b|\bnumber of\b).{1,200}?\b[1-9](?:[0-9]{0,2})(?:,[0-9]{3})+\b
+//      (?:.{1,100}?(?:shares|common|outstanding))?                      (ignoring case)
+
+void FindIndicatorShares(EM::sv text, std::vector<EM::sv>& matches);
+
+#endif   // ----- #ifndef CoverPageMatchers_INC  -----
@@ -0,0 +1,294 @@
+// =====================================================================================
+//
+//       Filename:  CoverPageText.cpp
+//
+//    Description:  Implementation of CoverPageText
+//
+//        Version:  1.0
+//        Created:  10/18/2026 01:07:42 AM
+//       Revision:  none
+//       Compiler:  g++
+//
+//         Author:  David P. Riedel (), driedel@cox.net
+//        License:  GNU General Public License -v3
+//
+// =====================================================================================
+
+#include <algorithm>
+#include <cctype>
+#include <utility>
+
+#include "CoverPageText.h"
+#include "Extractor_Utils.h"
+
+namespace
+{
+    // stands in for any character which is not ascii. We only ever turn it into a space.
+
+    constexpr char NOT_ASCII = '\x80';
+
+    // what the HTML tokenizer considers white space.
+
+    bool IsSpace(char c)
+    {
+        return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\f';
+    }
+
+    bool IsAlpha(char c)
+    {
+        return std::isalpha(static_cast<unsigned char>(c)) != 0;
+    }
+
+    // how the content of an element is tokenized and whether we keep it.
+
+    enum class ContentType
+    {
+        e_Markup,
+        e_Hidden,                   // raw text we don't show
+        e_RawText,                  // no tags or entities until the end tag
+        e_Text                      // no tags until the end tag but entities are decoded
+    };
+
+    ContentType ContentOf(EM::sv html, std::size_t name_begin, std::size_t name_end)
+    {
+        static const std::pair<EM::sv, ContentType> special_elements[]
+        {
+            {"script", ContentType::e_Hidden},
+            {"style", ContentType::e_Hidden},
+            {"xmp", ContentType::e_RawText},
+            {"iframe", ContentType::e_RawText},
+            {"noembed", ContentType::e_RawText},
+            {"noframes", ContentType::e_RawText},
+            {"title", ContentType::e_Text},
+            {"textarea", ContentType::e_Text}
+        };
+
+        auto found = std::find_if(std::begin(special_elements), std::end(special_elements),
+                [&] (const auto& element) { return element.first.size() == name_end - name_begin && WordAt(html, name_begin, element.first); });
+        return found == std::end(special_elements) ? ContentType::e_Markup : found->second;
+    }
+
+    // the next '<' which starts a tag, a comment or the like.  Any other '<' is just text.
+
+    std::size_t FindMarkup(EM::sv html, std::size_t pos)
+    {
+        for (pos = html.find('<', pos); pos != npos; pos = html.find('<', pos + 1))
+        {
+            if (pos + 1 < html.size())
+            {
+                char next = html[pos + 1];
+                if (IsAlpha(next) || next == '/' || next == '!' || next == '?')
+                {
+                    return pos;
+                }
+            }
+        }
+        return npos;
+    }
+
+    // from the end of the tag name to just past the '>'.  A '>' inside a quoted
+    // attribute value doesn't count.
+
+    std::size_t SkipAttributes(EM::sv html, std::size_t pos)
+    {
+        for (; pos < html.size(); ++pos)
+        {
+            if (html[pos] == '>')
+            {
+                return pos + 1;
+            }
+            if (html[pos] == '=')
+            {
+                auto value = pos + 1;
+                while (value < html.size() && IsSpace(html[value]))
+                {
+                    ++value;
+                }
+                if (value < html.size() && (html[value] == '"' || html[value] == '\''))
+                {
+                    pos = html.find(html[value], value + 1);
+                    if (pos == npos)
+                    {
+                        return npos;
+                    }
+                }
+            }
+        }
+        return npos;
+    }
+
+    // from the '<' to just past the end of whatever is not a tag.
+
+    std::size_t SkipComment(EM::sv html, std::size_t pos)
+    {
+        if (html.substr(pos, 4) == "<!--")
+        {
+            if (html.substr(pos + 4, 1) == ">")
+            {
+                return pos + 5;
+            }
+            if (html.substr(pos + 4, 2) == "->")
+            {
+                return pos + 6;
+            }
+            auto comment_end = html.find("-->", pos + 4);
+            return comment_end == npos ? npos : comment_end + 3;
+        }
+        if (html.substr(pos, 3) == "</>")
+        {
+            return pos + 3;
+        }
+
+        // <!DOCTYPE ...>, <?xml ...> and such.
+
+        auto bogus_end = html.find('>', pos + 2);
+        return bogus_end == npos ? npos : bogus_end + 1;
+    }
+
+    // where '</name' is followed by the end of the name.
+
+    std::size_t FindEndTag(EM::sv html, std::size_t pos, EM::sv lower_case_name)
+    {
+        for (pos = html.find("</", pos); pos != npos; pos = html.find("</", pos + 1))
+        {
+            auto name_end = pos + 2 + lower_case_name.size();
+            if (WordAt(html, pos + 2, lower_case_name) && name_end < html.size()
+                    && (IsSpace(html[name_end]) || html[name_end] == '/' || html[name_end] == '>'))
+            {
+                return pos;
+            }
+        }
+        return npos;
+    }
+
+    // cleans up the text as it goes.
+
+    class TextCollector
+    {
+    public:
+
+        explicit TextCollector(std::size_t max_length)
+            : max_length_{max_length} {}
+
+        [[nodiscard]] bool Full() const { return max_length_ > 0 && text_.size() >= max_length_; }
+
+        // 1 text node's worth.  false once we have all we want.
+
+        bool AppendRun(EM::sv run, bool decode_entities)
+        {
+            if (std::all_of(run.begin(), run.end(), IsSpace))
+            {
+                return ! Full();
+            }
+            for (std::size_t pos = 0; pos < run.size(); )
+            {
+                char c = run[pos];
+                if (decode_entities && c == '&')
+                {
+                    auto code_point = DecodeHTMLEntity(run, pos);
+                    c = code_point < 0x80 ? static_cast<char>(code_point) : NOT_ASCII;
+                }
+                else
+                {
+                    ++pos;
+                }
+                if (! Append(c))
+                {
+                    return false;
+                }
+            }
+
+            // sometimes, the number of shares runs together with some text so
+            // separate them.
+
+            return Append(' ');
+        }
+
+        [[nodiscard]] std::string TakeText() { return std::move(text_); }
+
+    private:
+
+        bool Append(char c)
+        {
+            if (auto uc = static_cast<unsigned char>(c); uc > 0x7f || uc < 0x20)
+            {
+                c = ' ';
+            }
+            if (c != ' ' || text_.empty() || text_.back() != ' ')
+            {
+                text_ += c;
+            }
+            return ! Full();
+        }
+
+        std::size_t max_length_;
+        std::string text_;
+    };
+}
+
+/*
+ * ===  FUNCTION  ======================================================================
+ *         Name:  CoverPageText
+ *  Description:  a tag or comment which never ends ends the document, as it does for
+ *                gumbo.
+ * =====================================================================================
+ */
+std::string CoverPageText (EM::sv html, std::size_t max_length_of_text)
+{
+    TextCollector text{max_length_of_text};
+
+    std::size_t pos{0};
+    while (pos < html.size())
+    {
+        auto markup = FindMarkup(html, pos);
+        if (! text.AppendRun(html.substr(pos, markup == npos ? npos : markup - pos), true) || markup == npos)
+        {
+            break;
+        }
+        const char next = html[markup + 1];
+        if (! IsAlpha(next) && ! (next == '/' && markup + 2 < html.size() && IsAlpha(html[markup + 2])))
+        {
+            pos = SkipComment(html, markup);
+            if (pos == npos)
+            {
+                break;
+            }
+            continue;
+        }
+
+        const bool is_end_tag = next == '/';
+        const auto name_begin = markup + (is_end_tag ? 2 : 1);
+        auto name_end = std::min(html.find_first_of(" \t\n\r\f/>", name_begin), html.size());
+
+        pos = SkipAttributes(html, name_end);
+        if (pos == npos)
+        {
+            break;
+        }
+        if (is_end_tag)
+        {
+            continue;
+        }
+
+        auto content_type = ContentOf(html, name_begin, name_end);
+        if (content_type == ContentType::e_Markup)
+        {
+            continue;
+        }
+
+        // everything up to our end tag is text.  We'll find the end tag itself next time round.
+
+        std::string lower_case_name;
+        std::transform(html.begin() + name_begin, html.begin() + name_end, std::back_inserter(lower_case_name),
+                [] (unsigned char c) { return std::tolower(c); });
+        auto end_tag = FindEndTag(html, pos, lower_case_name);
+        auto content = html.substr(pos, end_tag == npos ? npos : end_tag - pos);
+
+        if (content_type != ContentType::e_Hidden && ! text.AppendRun(content, content_type == ContentType::e_Text))
+        {
+            break;
+        }
+        pos = end_tag;
+    }
+    return text.TakeText();
+}		// -----  end of function CoverPageText  -----
@@ -0,0 +1,43 @@
+// =====================================================================================
+//
+//       Filename:  CoverPageText.h
+//
+//    Description:  Pull the visible text from the start of an HTML document
+//
+//        Version:  1.0
+//        Created:  10/18/2026 01:07:42 AM
+//       Revision:  none
+//       Compiler:  g++
+//
+//         Author:  David P. Riedel (), driedel@cox.net
+//        License:  GNU General Public License -v3
+//
+// =====================================================================================
+
+
+// =====================================================================================
+//  Description:  We tokenize the HTML as we go and build no tree.  Each run of text
+//                between tags, the same text gumbo would put in a text node, is
+//                appended followed by a space.  Runs which are only white space and
+//                the contents of comments, <script> and <style> are left out.
+//
+//                Hi ascii and control characters become spaces and spaces never
+//                repeat, which is what the cover page regexes expect.  Entities are
+//                decoded though all we need to know of most of them is that they are
+//                not ascii.
+//
+//                We stop as soon as we have 'max_length_of_text' characters.  0 means
+//                no limit.
+// =====================================================================================
+
+
+#ifndef  CoverPageText_INC
+#define  CoverPageText_INC
+
+#include <string>
+
+#include "Extractor.h"
+
+[[nodiscard]] std::string CoverPageText(EM::sv html, std::size_t max_length_of_text);
+
+#endif   // ----- #ifndef CoverPageText_INC  -----
@@ -0,0 +1,164 @@
+// =====================================================================================
+//
+//       Filename:  DBConnectionPool.cpp
+//
+//    Description:  Implementation of DBConnectionPool
+//
+//        Version:  1.0
+//        Created:  10/17/2026 02:40:51 PM
+//       Revision:  none
+//       Compiler:  g++
+//
+//         Author:  David P. Riedel (), driedel@cox.net
+//        License:  GNU General Public License -v3
+//
+// =====================================================================================
+
+#include "spdlog/spdlog.h"
+
+#include "DBConnectionPool.h"
+#include "Extractor_Utils.h"
+
+//--------------------------------------------------------------------------------------
+//       Class:  DBConnectionPool::Connection
+//      Method:  ~Connection
+// Description:  destructor
+//--------------------------------------------------------------------------------------
+DBConnectionPool::Connection::~Connection ()
+{
+    if (pool_ != nullptr)
+    {
+        pool_->ReturnConnection(std::move(pooled_connection_));
+    }
+}		// -----  end of method DBConnectionPool::Connection::~Connection  -----
+
+//--------------------------------------------------------------------------------------
+//       Class:  DBConnectionPool
+//      Method:  DBConnectionPool
+// Description:  constructor
+//--------------------------------------------------------------------------------------
+DBConnectionPool::DBConnectionPool (std::string connection_string, int pool_size)
+    : connection_string_{std::move(connection_string)}, pool_size_{pool_size}
+{
+    BOOST_ASSERT_MSG(! connection_string_.empty(), "DB connection string must not be empty.");
+    BOOST_ASSERT_MSG(pool_size_ > 0, "DB connection pool needs at least 1 connection.");
+
+    idle_connections_.reserve(pool_size_);
+}  // -----  end of method DBConnectionPool::DBConnectionPool  (constructor)  -----
+
+/*
+ * ===  FUNCTION  ======================================================================
+ *         Name:  DBConnectionPool::GetConnection
+ *  Description:  hand out an idle connection, open a new one if we are not yet
+ *                at our limit or wait for one to be returned.
+ * =====================================================================================
+ */
+DBConnectionPool::Connection DBConnectionPool::GetConnection ()
+{
+    PooledConnection pooled_connection;
+    {
+        std::unique_lock<std::mutex> lk{m_};
+        connection_available_.wait(lk, [this] { return ! idle_connections_.empty() || connections_in_use_ < pool_size_; });
+
+        if (! idle_connections_.empty())
+        {
+            pooled_connection = std::move(idle_connections_.back());
+            idle_connections_.pop_back();
+        }
+        ++connections_in_use_;
+    }
+
+    // connecting and pinging can take a while so we don't hold the lock.
+
+    try
+    {
+        if (pooled_connection.connection_ && ! IsHealthy(pooled_connection))
+        {
+            spdlog::info("Replacing unhealthy DB connection.");
+            pooled_connection = PooledConnection{};
+        }
+        if (! pooled_connection.connection_)
+        {
+            pooled_connection = OpenConnection();
+        }
+    }
+    catch (...)
+    {
+        // give back our slot so others don't wait forever.
+
+        {
+            std::lock_guard<std::mutex> lk{m_};
+            --connections_in_use_;
+        }
+        connection_available_.notify_one();
+        throw;
+    }
+    return Connection{this, std::move(pooled_connection)};
+}		// -----  end of method DBConnectionPool::GetConnection  -----
+
+/*
+ * ===  FUNCTION  ======================================================================
+ *         Name:  DBConnectionPool::OpenConnection
+ *  Description:  pqxx takes ownership of the raw connection. We just keep a pointer.
+ * =====================================================================================
+ */
+DBConnectionPool::PooledConnection DBConnectionPool::OpenConnection () const
+{
+    PGconn* raw_connection = PQconnectdb(connection_string_.c_str());
+    if (PQstatus(raw_connection) != CONNECTION_OK)
+    {
+        std::string message = raw_connection != nullptr ? PQerrorMessage(raw_connection) : "Out of memory.";
+        PQfinish(raw_connection);
+        throw pqxx::broken_connection{catenate("Unable to connect to DB: ", message)};
+    }
+    return {std::make_unique<pqxx::connection>(pqxx::connection::seize_raw_connection(raw_connection)), raw_connection, {}};
+}		// -----  end of method DBConnectionPool::OpenConnection  -----
+
+/*
+ * ===  FUNCTION  ======================================================================
+ *         Name:  DBConnectionPool::IsHealthy
+ *  Description:  a recently used open connection is assumed to be OK.
+ * =====================================================================================
+ */
+bool DBConnectionPool::IsHealthy (PooledConnection& pooled_connection) const
+{
+    if (! pooled_connection.connection_->is_open())
+    {
+        return false;
+    }
+    if (std::chrono::steady_clock::now() - pooled_connection.last_used_ < health_check_interval_)
+    {
+        return true;
+    }
+    try
+    {
+        pqxx::nontransaction trxn{*pooled_connection.connection_};
+        trxn.exec("SELECT 1");
+    }
+    catch (const pqxx::failure& e)
+    {
+        spdlog::info(catenate("DB connection health check failed: ", e.what()));
+        return false;
+    }
+    return true;
+}		// -----  end of method DBConnectionPool::IsHealthy  -----
+
+/*
+ * ===  FUNCTION  ======================================================================
+ *         Name:  DBConnectionPool::ReturnConnection
+ *  Description:  broken connections are dropped. We'll open a new one when needed.
+ * =====================================================================================
+ */
+void DBConnectionPool::ReturnConnection (PooledConnection pooled_connection)
+{
+    {
+        std::lock_guard<std::mutex> lk{m_};
+        --connections_in_use_;
+        if (pooled_connection.connection_ && pooled_connection.connection_->is_open())
+        {
+            pooled_connection.last_used_ = std::chrono::steady_clock::now();
+            idle_connections_.push_back(std::move(pooled_connection));
+        }
+    }
+    connection_available_.notify_one();
+}		// -----  end of method DBConnectionPool::ReturnConnection  -----
@@ -0,0 +1,147 @@
+// =====================================================================================
+//
+//       Filename:  DBConnectionPool.h
+//
+//    Description:  Pool of persistent Postgres connections shared by all our
+//                  DB related functions.
+//
+//        Version:  1.0
+//        Created:  10/17/2026 02:21:08 PM
+//       Revision:  none
+//       Compiler:  g++
+//
+//         Author:  David P. Riedel (), driedel@cox.net
+//        License:  GNU General Public License -v3
+//
+// =====================================================================================
+
+// =====================================================================================
+//        Class:  DBConnectionPool
+//  Description:  Opening a connection costs a full Postgres handshake.  We used to do
+//                that at least twice per filing (filter check and load) so now we
+//                keep a fixed number of connections open for the whole run.
+//
+//                Connections are opened the first time they are needed.  A caller
+//                borrows one with GetConnection and it goes back to the pool when
+//                the returned handle goes away.  If all connections are in use,
+//                GetConnection waits.
+//
+//                Before handing out a connection, we check it is still open.  If it
+//                has been idle for a while, we also ping the server.  A connection
+//                which fails either check is replaced.
+//
+//                We open connections with libpq ourselves and hand them to pqxx so
+//                we can still reach the raw connection for things pqxx doesn't do,
+//                like binary COPY.
+// =====================================================================================
+
+
+#ifndef  DBConnectionPool_INC
+#define  DBConnectionPool_INC
+
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <libpq-fe.h>
+
+#include <pqxx/pqxx>
+
+class DBConnectionPool
+{
+    struct PooledConnection
+    {
+        std::unique_ptr<pqxx::connection> connection_;
+        PGconn* raw_connection_ = nullptr;          // owned by connection_
+        std::chrono::steady_clock::time_point last_used_;
+    };
+
+public:
+
+    // ====================  NESTED CLASS  =======================================
+
+    // borrowed connection. Returns itself to the pool when destroyed.
+
+    class Connection
+    {
+    public:
+
+        Connection(DBConnectionPool* pool, PooledConnection pooled_connection)
+            : pool_{pool}, pooled_connection_{std::move(pooled_connection)} {}
+        Connection(const Connection& rhs) = delete;
+        Connection(Connection&& rhs) noexcept
+            : pool_{rhs.pool_}, pooled_connection_{std::move(rhs.pooled_connection_)} { rhs.pool_ = nullptr; }
+
+        ~Connection();
+
+        [[nodiscard]] pqxx::connection& get() const { return *pooled_connection_.connection_; }
+        pqxx::connection& operator*() const { return get(); }
+
+        // only for use while a pqxx transaction on this connection is open.
+
+        [[nodiscard]] PGconn* raw() const { return pooled_connection_.raw_connection_; }
+
+        Connection& operator = (const Connection& rhs) = delete;
+        Connection& operator = (Connection&& rhs) = delete;
+
+    private:
+
+        DBConnectionPool* pool_;
+        PooledConnection pooled_connection_;
+    };
+
+    // ====================  LIFECYCLE     =======================================
+
+    DBConnectionPool (std::string connection_string, int pool_size);    // constructor
+    DBConnectionPool(const DBConnectionPool& rhs) = delete;
+    DBConnectionPool(DBConnectionPool&& rhs) = delete;
+
+    ~DBConnectionPool () = default;
+
+    // ====================  ACCESSORS     =======================================
+
+    [[nodiscard]] const std::string& ConnectionString() const { return connection_string_; }
+    [[nodiscard]] int PoolSize() const { return pool_size_; }
+
+    // ====================  MUTATORS      =======================================
+
+    Connection GetConnection();
+
+    // ====================  OPERATORS     =======================================
+
+    DBConnectionPool& operator = (const DBConnectionPool& rhs) = delete;
+    DBConnectionPool& operator = (DBConnectionPool&& rhs) = delete;
+
+protected:
+    // ====================  METHODS       =======================================
+
+    // ====================  DATA MEMBERS  =======================================
+
+private:
+    // ====================  METHODS       =======================================
+
+    [[nodiscard]] bool IsHealthy(PooledConnection& pooled_connection) const;
+    [[nodiscard]] PooledConnection OpenConnection() const;
+    void ReturnConnection(PooledConnection pooled_connection);
+
+    // ====================  DATA MEMBERS  =======================================
+
+    // connections which have been idle this long get pinged before use.
+
+    static constexpr auto health_check_interval_ = std::chrono::seconds{60};
+
+    std::mutex m_;
+    std::condition_variable connection_available_;
+
+    std::vector<PooledConnection> idle_connections_;
+
+    const std::string connection_string_;
+    const int pool_size_;
+    int connections_in_use_ = 0;
+
+}; // -----  end of class DBConnectionPool  -----
+
+#endif   // ----- #ifndef DBConnectionPool_INC  -----
@@ -0,0 +1,375 @@
+// =====================================================================================
+//
+//       Filename:  DBCopyWriter.cpp
+//
+//    Description:  Implementation of DBCopyWriter
+//
+//        Version:  1.0
+//        Created:  10/17/2026 05:31:04 PM
+//       Revision:  none
+//       Compiler:  g++
+//
+//         Author:  David P. Riedel (), driedel@cox.net
+//        License:  GNU General Public License -v3
+//
+// =====================================================================================
+
+#include <algorithm>
+#include <charconv>
+#include <cstdlib>
+#include <cstdint>
+
+#include "date/date.h"
+#include "fmt/format.h"
+
+#include "DBCopyWriter.h"
+
+// see the 'Binary Format' section of the Postgres COPY documentation for the layout.
+// everything is in network byte order.
+
+namespace
+{
+    constexpr char COPY_SIGNATURE[] = "PGCOPY\n\377\r\n";      // plus its terminating 0 makes 11 bytes
+
+    // Postgres dates count from here.
+
+    constexpr int POSTGRES_EPOCH_DAYS = 10'957;                 // days from 1970-01-01 to 2000-01-01
+
+    // NUMERIC is stored as base 10000 digits.
+
+    constexpr int NUMERIC_DIGITS_PER_GROUP = 4;
+    constexpr uint16_t NUMERIC_POSITIVE = 0x0000;
+    constexpr uint16_t NUMERIC_NEGATIVE = 0x4000;
+    constexpr int MAX_EXPONENT = 1'000;
+
+    template<typename T>
+    void AppendBigEndian(std::string& buffer, T value)
+    {
+        auto bits = static_cast<std::make_unsigned_t<T>>(value);
+        for (int shift = (sizeof(T) - 1) * 8; shift >= 0; shift -= 8)
+        {
+            buffer.push_back(static_cast<char>((bits >> shift) & 0xFF));
+        }
+    }
+
+    EM::sv TrimSpaces(EM::sv value)
+    {
+        while (! value.empty() && value.front() == ' ')
+        {
+            value.remove_prefix(1);
+        }
+        while (! value.empty() && value.back() == ' ')
+        {
+            value.remove_suffix(1);
+        }
+        return value;
+    }
+
+    // powers of 10 can be negative so we need to round towards -infinity.
+
+    int GroupOf(int power_of_10)
+    {
+        return power_of_10 >= 0 ? power_of_10 / NUMERIC_DIGITS_PER_GROUP
+            : -((-power_of_10 + NUMERIC_DIGITS_PER_GROUP - 1) / NUMERIC_DIGITS_PER_GROUP);
+    }
+
+    void AppendBigInt(std::string& buffer, EM::sv value)
+    {
+        value = TrimSpaces(value);
+        int64_t result{0};
+        auto [ptr, ec] = std::from_chars(value.data(), value.data() + value.size(), result);
+        if (ec != std::errc() || ptr != value.data() + value.size())
+        {
+            throw ExtractorException(catenate("Can't convert: '", value, "' to bigint for COPY."));
+        }
+        AppendBigEndian<int32_t>(buffer, sizeof(int64_t));
+        AppendBigEndian(buffer, result);
+    }
+
+    // our dates are always yyyy-mm-dd.
+
+    void AppendDate(std::string& buffer, EM::sv value)
+    {
+        value = TrimSpaces(value);
+        int year{0};
+        unsigned month{0};
+        unsigned day{0};
+        auto parse([] (EM::sv digits, auto& result)
+            {
+                auto [ptr, ec] = std::from_chars(digits.data(), digits.data() + digits.size(), result);
+                return ec == std::errc() && ptr == digits.data() + digits.size();
+            });
+        bool parsed = value.size() == 10 && value[4] == '-' && value[7] == '-'
+            && parse(value.substr(0, 4), year) && parse(value.substr(5, 2), month) && parse(value.substr(8, 2), day);
+
+        date::year_month_day ymd{date::year{year}, date::month{month}, date::day{day}};
+        if (! parsed || ! ymd.ok())
+        {
+            throw ExtractorException(catenate("Can't convert: '", value, "' to date for COPY."));
+        }
+        AppendBigEndian<int32_t>(buffer, sizeof(int32_t));
+        AppendBigEndian<int32_t>(buffer, date::sys_days{ymd}.time_since_epoch().count() - POSTGRES_EPOCH_DAYS);
+    }
+
+    // accepts the same plain and scientific notation the server does except for NaN.
+    // the server rounds to the column's scale just as it does for text.
+
+    void AppendNumeric(std::string& buffer, EM::sv value)
+    {
+        const EM::sv original_value = value;
+        auto bad_value([original_value] ()
+            {
+                return ExtractorException(catenate("Can't convert: '", original_value, "' to numeric for COPY."));
+            });
+
+        value = TrimSpaces(value);
+        bool is_negative{false};
+        if (! value.empty() && (value.front() == '-' || value.front() == '+'))
+        {
+            is_negative = value.front() == '-';
+            value.remove_prefix(1);
+        }
+
+        std::string digits;
+        digits.reserve(value.size());
+        int decimal_point{-1};
+        std::size_t pos{0};
+        for (; pos < value.size() && value[pos] != 'e' && value[pos] != 'E'; ++pos)
+        {
+            if (value[pos] >= '0' && value[pos] <= '9')
+            {
+                digits.push_back(value[pos]);
+            }
+            else if (value[pos] == '.' && decimal_point < 0)
+            {
+                decimal_point = digits.size();
+            }
+            else
+            {
+                throw bad_value();
+            }
+        }
+        if (digits.empty())
+        {
+            throw bad_value();
+        }
+        if (decimal_point < 0)
+        {
+            decimal_point = digits.size();
+        }
+        int display_scale = digits.size() - decimal_point;
+
+        if (pos < value.size())
+        {
+            EM::sv exponent_digits = value.substr(pos + 1);
+            if (! exponent_digits.empty() && exponent_digits.front() == '+')
+            {
+                exponent_digits.remove_prefix(1);
+            }
+            int exponent{0};
+            auto [ptr, ec] = std::from_chars(exponent_digits.data(), exponent_digits.data() + exponent_digits.size(), exponent);
+            if (exponent_digits.empty() || ec != std::errc() || ptr != exponent_digits.data() + exponent_digits.size()
+                    || std::abs(exponent) > MAX_EXPONENT)
+            {
+                throw bad_value();
+            }
+            decimal_point += exponent;
+            display_scale -= exponent;
+        }
+        display_scale = std::max(display_scale, 0);
+
+        // digit i is worth 10^(decimal_point - 1 - i). Collect them into base 10000 groups,
+        // most significant first. 'weight' is the power of 10000 of the first group.
+
+        int weight = GroupOf(decimal_point - 1);
+        const int last_group = GroupOf(decimal_point - static_cast<int>(digits.size()));
+        std::vector<int16_t> groups(weight - last_group + 1, 0);
+
+        static constexpr int16_t place_values[NUMERIC_DIGITS_PER_GROUP] = {1, 10, 100, 1000};
+        for (std::size_t i = 0; i < digits.size(); ++i)
+        {
+            const int power_of_10 = decimal_point - 1 - static_cast<int>(i);
+            const int group = GroupOf(power_of_10);
+            groups[weight - group] += (digits[i] - '0') * place_values[power_of_10 - group * NUMERIC_DIGITS_PER_GROUP];
+        }
+
+        auto first_non_zero = std::find_if(groups.begin(), groups.end(), [] (int16_t group) { return group != 0; });
+        weight -= first_non_zero - groups.begin();
+        groups.erase(groups.begin(), first_non_zero);
+        while (! groups.empty() && groups.back() == 0)
+        {
+            groups.pop_back();
+        }
+        if (groups.empty())
+        {
+            weight = 0;
+            is_negative = false;
+        }
+
+        AppendBigEndian<int32_t>(buffer, (4 + groups.size()) * sizeof(int16_t));
+        AppendBigEndian<int16_t>(buffer, groups.size());
+        AppendBigEndian<int16_t>(buffer, weight);
+        AppendBigEndian<uint16_t>(buffer, is_negative ? NUMERIC_NEGATIVE : NUMERIC_POSITIVE);
+        AppendBigEndian<int16_t>(buffer, display_scale);
+        for (auto group : groups)
+        {
+            AppendBigEndian(buffer, group);
+        }
+    }
+
+    void AppendText(std::string& buffer, EM::sv value)
+    {
+        AppendBigEndian<int32_t>(buffer, value.size());
+        buffer.append(value);
+    }
+}
+
+//--------------------------------------------------------------------------------------
+//       Class:  DBCopyWriter
+//      Method:  DBCopyWriter
+// Description:  constructor
+//--------------------------------------------------------------------------------------
+DBCopyWriter::DBCopyWriter (DBConnectionPool::Connection& c, pqxx::transaction_base& trxn, const std::string& table_name,
+        const std::vector<Column>& columns, CopyFormat copy_format)
+    : columns_{columns}, table_name_{table_name}
+{
+    BOOST_ASSERT_MSG(! columns_.empty(), "Must have at least 1 column to COPY.");
+
+    std::vector<std::string> column_names;
+    column_names.reserve(columns_.size());
+    std::transform(columns_.begin(), columns_.end(), std::back_inserter(column_names), [] (const Column& column) { return column.name_; });
+
+    if (copy_format == CopyFormat::e_Text)
+    {
+        text_inserter_.emplace(trxn, table_name_, column_names);
+        return;
+    }
+
+    // our transaction has already started on this connection so the COPY is part of it.
+
+    raw_connection_ = c.raw();
+    BOOST_ASSERT_MSG(raw_connection_ != nullptr, "Binary COPY needs a raw DB connection.");
+
+    auto copy_cmd = fmt::format("COPY {0} ({1}) FROM STDIN WITH (FORMAT binary)", table_name_, fmt::join(column_names, ", "));
+    PGresult* copy_result = PQexec(raw_connection_, copy_cmd.c_str());
+    const bool copy_started = PQresultStatus(copy_result) == PGRES_COPY_IN;
+    std::string message = copy_started ? "" : PQerrorMessage(raw_connection_);
+    PQclear(copy_result);
+    if (! copy_started)
+    {
+        throw pqxx::sql_error{catenate("Unable to start binary COPY to: ", table_name_, '\n', message)};
+    }
+
+    buffer_.reserve(max_buffer_size_ + 1024);
+    buffer_.append(COPY_SIGNATURE, sizeof(COPY_SIGNATURE));
+    AppendBigEndian<int32_t>(buffer_, 0);                       // flags
+    AppendBigEndian<int32_t>(buffer_, 0);                       // header extension length
+}  // -----  end of method DBCopyWriter::DBCopyWriter  (constructor)  -----
+
+//--------------------------------------------------------------------------------------
+//       Class:  DBCopyWriter
+//      Method:  ~DBCopyWriter
+// Description:  destructor
+//--------------------------------------------------------------------------------------
+DBCopyWriter::~DBCopyWriter ()
+{
+    if (raw_connection_ == nullptr || completed_)
+    {
+        return;
+    }
+
+    // make sure the connection is usable for the rollback which follows.
+
+    PQputCopyEnd(raw_connection_, "COPY abandoned.");
+    while (PGresult* a_result = PQgetResult(raw_connection_))
+    {
+        PQclear(a_result);
+    }
+}  // -----  end of method DBCopyWriter::~DBCopyWriter  (destructor)  -----
+
+/*
+ * ===  FUNCTION  ======================================================================
+ *         Name:  DBCopyWriter::Complete
+ *  Description:
+ * =====================================================================================
+ */
+void DBCopyWriter::Complete ()
+{
+    if (text_inserter_)
+    {
+        text_inserter_->complete();
+        return;
+    }
+    BOOST_ASSERT_MSG(next_column_ == 0 || next_column_ == columns_.size(), "Last row is incomplete.");
+
+    AppendBigEndian<int16_t>(buffer_, -1);                      // trailer
+    SendBuffer();
+
+    completed_ = true;
+    if (PQputCopyEnd(raw_connection_, nullptr) != 1)
+    {
+        throw pqxx::failure{catenate("Unable to finish binary COPY to: ", table_name_, '\n', PQerrorMessage(raw_connection_))};
+    }
+
+    std::string message;
+    while (PGresult* a_result = PQgetResult(raw_connection_))
+    {
+        if (PQresultStatus(a_result) != PGRES_COMMAND_OK && message.empty())
+        {
+            message = PQresultErrorMessage(a_result);
+        }
+        PQclear(a_result);
+    }
+    if (! message.empty())
+    {
+        throw pqxx::sql_error{catenate("Binary COPY to: ", table_name_, " failed.\n", message)};
+    }
+}		// -----  end of method DBCopyWriter::Complete  -----
+
+void DBCopyWriter::StartBinaryRow ()
+{
+    BOOST_ASSERT_MSG(next_column_ == 0 || next_column_ == columns_.size(), "Previous row is incomplete.");
+    BOOST_ASSERT_MSG(! completed_, "Can't add rows after completing COPY.");
+
+    if (buffer_.size() >= max_buffer_size_)
+    {
+        SendBuffer();
+    }
+    AppendBigEndian<int16_t>(buffer_, columns_.size());
+    next_column_ = 0;
+}		// -----  end of method DBCopyWriter::StartBinaryRow  -----
+
+void DBCopyWriter::AddBinaryValue (EM::sv value)
+{
+    switch (columns_[next_column_++].type_)
+    {
+        case ColumnType::e_Text:
+            AppendText(buffer_, value);
+            break;
+
+        case ColumnType::e_BigInt:
+            AppendBigInt(buffer_, value);
+            break;
+
+        case ColumnType::e_Numeric:
+            AppendNumeric(buffer_, value);
+            break;
+
+        case ColumnType::e_Date:
+            AppendDate(buffer_, value);
+            break;
+    }
+}		// -----  end of method DBCopyWriter::AddBinaryValue  -----
+
+void DBCopyWriter::SendBuffer ()
+{
+    if (buffer_.empty())
+    {
+        return;
+    }
+    if (PQputCopyData(raw_connection_, buffer_.data(), buffer_.size()) != 1)
+    {
+        throw pqxx::failure{catenate("Unable to send binary COPY data to: ", table_name_, '\n', PQerrorMessage(raw_connection_))};
+    }
+    buffer_.clear();
+}		// -----  end of method DBCopyWriter::SendBuffer  -----
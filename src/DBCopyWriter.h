@@ -0,0 +1,127 @@
+// =====================================================================================
+//
+//       Filename:  DBCopyWriter.h
+//
+//    Description:  COPY rows into a table using either Postgres' text or binary format.
+//
+//        Version:  1.0
+//        Created:  10/17/2026 05:12:36 PM
+//       Revision:  none
+//       Compiler:  g++
+//
+//         Author:  David P. Riedel (), driedel@cox.net
+//        License:  GNU General Public License -v3
+//
+// =====================================================================================
+
+// =====================================================================================
+//        Class:  DBCopyWriter
+//  Description:  In text format, the server has to parse every value we send.  For our
+//                data tables, that means every NUMERIC value and, for XBRL, 2 dates per
+//                row.  In binary format, we do the conversions here and the server just
+//                copies the bytes in.
+//
+//                Text format goes through pqxx::stream_to just as before.  Binary
+//                format talks to libpq directly since pqxx only does text.
+//
+//                Values are always passed as strings, the same strings we would send
+//                as text, and are converted according to the column's type.
+// =====================================================================================
+
+
+#ifndef  DBCopyWriter_INC
+#define  DBCopyWriter_INC
+
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <pqxx/pqxx>
+#include <pqxx/stream_to>
+
+#include "DBConnectionPool.h"
+#include "Extractor.h"
+#include "Extractor_Utils.h"
+
+enum class CopyFormat { e_Text, e_Binary };
+
+class DBCopyWriter
+{
+public:
+
+    enum class ColumnType { e_Text, e_BigInt, e_Numeric, e_Date };
+
+    struct Column
+    {
+        std::string name_;
+        ColumnType type_;
+    };
+
+    // ====================  LIFECYCLE     =======================================
+
+    DBCopyWriter (DBConnectionPool::Connection& c, pqxx::transaction_base& trxn, const std::string& table_name,
+            const std::vector<Column>& columns, CopyFormat copy_format);
+    DBCopyWriter(const DBCopyWriter& rhs) = delete;
+    DBCopyWriter(DBCopyWriter&& rhs) = delete;
+
+    // if we haven't completed, the COPY is abandoned.
+
+    ~DBCopyWriter ();
+
+    // ====================  ACCESSORS     =======================================
+
+    // ====================  MUTATORS      =======================================
+
+    // 1 value for each column, in column order.
+
+    template<typename... Values>
+    void WriteValues(const Values&... values)
+    {
+        BOOST_ASSERT_MSG(sizeof...(values) == columns_.size(), "Must have 1 value for each column.");
+        if (text_inserter_)
+        {
+            text_inserter_->write_values(values...);
+            return;
+        }
+        StartBinaryRow();
+        (AddBinaryValue(EM::sv{values}), ...);
+    }
+
+    void Complete();
+
+    // ====================  OPERATORS     =======================================
+
+    DBCopyWriter& operator = (const DBCopyWriter& rhs) = delete;
+    DBCopyWriter& operator = (DBCopyWriter&& rhs) = delete;
+
+protected:
+    // ====================  METHODS       =======================================
+
+    // ====================  DATA MEMBERS  =======================================
+
+private:
+    // ====================  METHODS       =======================================
+
+    void StartBinaryRow();
+    void AddBinaryValue(EM::sv value);
+    void SendBuffer();
+
+    // ====================  DATA MEMBERS  =======================================
+
+    // we hand libpq this much data at a time.
+
+    static constexpr std::size_t max_buffer_size_ = 64 * 1024;
+
+    std::vector<Column> columns_;
+    std::string table_name_;
+
+    std::optional<pqxx::stream_to> text_inserter_;
+
+    PGconn* raw_connection_ = nullptr;
+    std::string buffer_;
+    std::size_t next_column_ = 0;
+    bool completed_ = false;
+
+}; // -----  end of class DBCopyWriter  -----
+
+#endif   // ----- #ifndef DBCopyWriter_INC  -----
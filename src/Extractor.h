@@ -37,11 +37,15 @@
 
 #include <filesystem>
 #include <map>
+#include <memory_resource>
 #include <string>
 #include <string_view>
 #include <type_traits>
+#include <unordered_map>
 #include <vector>
 
+#include "InternTable.h"
+
 namespace Extractor
 {
     // thanks to Jonathan Boccara of fluentcpp.com for his articles on
@@ -152,13 +156,46 @@ namespace Extractor
 
 	using ContextPeriod = std::map<std::string, Extractor_TimePeriod>;
 
+    // a filing has thousands of facts but only a few hundred distinct names,
+    // contexts, units and decimals so each fact refers to its filing's copy.
+
     struct GAAP_Data
     {
-        std::string label;
-        std::string context_ID;
-        std::string units;
-        std::string decimals;
-        std::string value;
+        InternTable::Handle label;
+        InternTable::Handle context_ID;
+        InternTable::Handle units;
+        InternTable::Handle decimals;
+        sv value;
+    };
+
+    class GAAP_DataList
+    {
+    public:
+
+        GAAP_DataList() = default;
+        explicit GAAP_DataList(std::pmr::memory_resource* resource) : strings_{resource}, fields_{resource} { }
+
+        void Add(sv label, sv context_ID, sv units, sv decimals, sv value)
+        {
+            fields_.push_back({strings_.Intern(label), strings_.Intern(context_ID), strings_.Intern(units),
+                    strings_.Intern(decimals), strings_.Store(value)});
+        }
+
+        [[nodiscard]] sv Text(InternTable::Handle handle) const { return strings_[handle]; }
+
+        // handles run from 0 to this - 1 so callers can keep per handle results in a vector.
+
+        [[nodiscard]] std::size_t DistinctStrings() const { return strings_.size(); }
+
+        [[nodiscard]] std::size_t size() const { return fields_.size(); }
+        [[nodiscard]] bool empty() const { return fields_.empty(); }
+        [[nodiscard]] auto begin() const { return fields_.begin(); }
+        [[nodiscard]] auto end() const { return fields_.end(); }
+
+    private:
+
+        InternTable strings_;
+        std::pmr::vector<GAAP_Data> fields_;
     };
 
 	// struct Extractor_Labels
@@ -166,7 +203,7 @@ namespace Extractor
 	// 	std::string system_label;
 	// 	std::string user_label;
 	// };
-	using Extractor_Labels = std::map<std::string, std::string>;
+	using Extractor_Labels = std::unordered_map<std::string, std::string>;
     using Extracted_Value = std::pair<std::string, std::string>;
 	using Extractor_Values = std::vector<Extracted_Value>;
 
@@ -189,7 +226,21 @@ namespace Extractor
     using AnchorContent = UniqType<sv, struct AnchorContentTag>;
     using TableContent = UniqType<sv, struct TableContentTag>;
 
-    using DocumentSectionList = std::vector<DocumentSection>;
+    // what we know about each <DOCUMENT> in a filing.
+    // we collect all of this in a single pass over the file when we split it up
+    // so nothing downstream needs to go back and search the document text again.
+
+    struct DocumentSectionData
+    {
+        DocumentSection document_;      // <DOCUMENT> through </DOCUMENT>
+        FileType file_type_;            // from the <TYPE> line
+        sv file_name_;                  // from the <FILENAME> line
+        sv extension_;                  // of file_name_, including the '.'
+        sv text_;                       // starts with the line end after <TEXT>, ends at the last </TEXT>
+        bool has_XBRL_ = false;         // there is an <XBRL> tag in the text
+    };
+
+    using DocumentSectionList = std::vector<DocumentSectionData>;
 
 }		// namespace Extractor
 
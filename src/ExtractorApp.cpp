@@ -41,16 +41,17 @@
 
 #include <algorithm>
 #include <cerrno>
+#include <condition_variable>
 #include <csignal>
 #include <exception>
 #include <fstream>
-#include <future>
 #include <iostream>
 #include <iterator>
 #include <map>
 #include <string>
 #include <system_error>
 #include <thread>
+#include <unordered_set>
 #include <vector>
 
 #include <range/v3/action/transform.hpp>
@@ -65,9 +66,15 @@
 
 #include <pqxx/pqxx>
 
+#include "BoundedQueue.h"
 #include "Extractor_HTML_FileFilter.h"
 #include "Extractor_XBRL_FileFilter.h"
+#include "FilingArena.h"
+#include "MappedFile.h"
+#include "RegexRegistry.h"
 #include "SEC_Header.h"
+#include "WorkStealingPool.h"
+#include "XBRL_InstanceReader.h"
 
 using namespace std::string_literals;
 using namespace std::chrono_literals;
@@ -90,48 +97,239 @@ using namespace std::chrono_literals;
 
 bool ExtractorApp::had_signal_ = false;
 
-// code from "The C++ Programming Language" 4th Edition. p. 1243.
-// with modifications.
-//
-// return index of ready future
-// if no future is ready, wait for d before trying again
+// SEC headers are usually only a few KB but filings with many filers can
+// have much longer ones.
+
+constexpr std::size_t SEC_HEADER_PREFIX_SIZE = 8 * 1024;
+constexpr std::size_t MAX_SEC_HEADER_PREFIX_SIZE = 128 * 1024;
 
-template<typename T>
-int wait_for_any(std::vector<std::future<T>>& vf, int continue_here, std::chrono::steady_clock::duration d)
+// our concurrent workers hand back their results using these.
+
+namespace
 {
-    while(true)
+    struct CompletedTask
+    {
+        std::tuple<int, int, int> counters_{0, 0, 0};
+        std::exception_ptr error_{nullptr};
+    };
+
+    // returns false if we need to stop processing.
+
+    bool TallyCompletedTask(const CompletedTask& task, std::tuple<int, int, int>& counters, std::exception_ptr& ep)
     {
-        for (int i=continue_here; i!=vf.size(); ++i)
+        try
         {
-            if (!vf[i].valid())
+            if (task.error_)
             {
-                continue;
+                std::rethrow_exception(task.error_);
             }
-            switch (vf[i].wait_for(std::chrono::seconds{0}))
+            counters = AddTs(counters, task.counters_);
+        }
+        catch (const std::system_error& e)
+        {
+            // any system problems, we eventually abort, but only after finishing work in process.
+
+            spdlog::error(e.what());
+            auto ec = e.code();
+            spdlog::error(catenate("Category: ", ec.category().name(), ". Value: ", ec.value(),
+                    ". Message: ", ec.message()));
+            counters = AddTs(counters, {0, 0, 1});
+
+            // OK, let's be sure this propagates
+
+            ep = std::current_exception();
+            return false;
+        }
+        catch (const MaxFilesException& e)
+        {
+            // any 'expected' problems, we'll document them and continue on.
+
+            spdlog::error(e.what());
+            counters = AddTs(counters, {0, 0, 1});
+
+            if (! ep)
             {
-            case std::future_status::ready:
-                    return i;
+                ep = std::current_exception();
+            }
+            return false;
+        }
+        catch(const pqxx::failure& e)
+        {
+            spdlog::error(catenate("Database error: ", e.what()));
+            counters = AddTs(counters, {0, 0, 1});
+        }
+        catch (const std::exception& e)
+        {
+            // any 'expected' problems, we'll document them and continue on.
 
-            case std::future_status::timeout:
-                break;
+            spdlog::error(e.what());
+            counters = AddTs(counters, {0, 0, 1});
+        }
+        catch (...)
+        {
+            // any other problems, we'll document them and stop.
+
+            spdlog::error("Unknown problem with async file processing. Stopping...");
+            counters = AddTs(counters, {0, 0, 1});
+
+            // OK, let's remember our first time here.
+
+            if (! ep)
+            {
+                ep = std::current_exception();
+            }
+            return false;
+        }
+        return true;
+    }
 
-            case std::future_status::deferred:
-                throw std::runtime_error("wait_for_all(): deferred future");
+    // tasks which finish after we have decided to stop.
+
+    void TallyLeftOverTask(const CompletedTask& task, std::tuple<int, int, int>& counters, std::exception_ptr& ep)
+    {
+        try
+        {
+            if (task.error_)
+            {
+                std::rethrow_exception(task.error_);
             }
+            counters = AddTs(counters, task.counters_);
         }
-        continue_here = 0;
+        catch (const ExtractorException& e)
+        {
+            // any problems, we'll document them and continue.
 
-        if (ExtractorApp::SignalReceived())
+            spdlog::error(e.what());
+            counters = AddTs(counters, {0, 0, 1});
+        }
+        catch(const std::exception& e)
         {
-            break;
+            counters = AddTs(counters, {0, 0, 1});
+            spdlog::error(e.what());
         }
+        catch (...)
+        {
+            // any other problems, we'll document them and stop.
 
-        std::this_thread::sleep_for(d);
-    }
+            spdlog::error("Unknown problem with async file clean-up. ");
+            counters = AddTs(counters, {0, 0, 1});
+
+            // OK, let's remember our first time here.
 
-    return -1;
+            if (! ep)
+            {
+                ep = std::current_exception();
+            }
+        }
+    }
 }
 
+// everything we know about a file as it moves through the pipeline.
+// the mapped content must stay put while we hold views into it so
+// these are always passed along by pointer.
+
+struct ExtractorApp::PipelineFile
+{
+    explicit PipelineFile(const EM::FileName& file_name) : file_name_{file_name}, gaap_data_{arena_.resource()} {}
+
+    // must come before anything which uses it.
+
+    FilingArena arena_;
+
+    EM::FileName file_name_;
+    MappedFile content_;
+    SEC_Header SEC_data_;
+    EM::DocumentSectionList document_sections_;
+    FileMode file_mode_ = FileMode::e_HTML;
+
+    // XBRL
+
+    EM::FilingData filing_data_;
+    EM::GAAP_DataList gaap_data_;
+    EM::Extractor_Labels label_data_;
+    EM::ContextPeriod context_data_;
+
+    // XLS and HTML
+
+    XLS_FinancialStatements XLS_tables_;
+    FinancialStatements HTML_tables_;
+
+    CompletedTask result_;
+};
+
+// loaders only get in each other's way when 2 files are for the same filing (an
+// original and its amendment, say) since the original-vs-amended check and replace
+// must see what the other did.  So a loader locks just the keys of its filings and
+// everything else goes to the DB at the same time.
+
+struct ExtractorApp::FilingLocks
+{
+    static std::string KeyFor(const EM::SEC_Header_fields& SEC_fields, EM::sv period_ending)
+    {
+        EM::sv base_form_type{SEC_fields.at("form_type")};
+        if (base_form_type.ends_with("_A"))
+        {
+            base_form_type.remove_suffix(2);
+        }
+        return catenate(SEC_fields.at("cik"), '|', base_form_type, '|', period_ending);
+    }
+
+    // XBRL loaders look for existing data using the XBRL period but replace using
+    // the header's so we need both.
+
+    static void AddKeys(const PipelineFile& pipeline_file, std::vector<std::string>& keys)
+    {
+        const auto& SEC_fields = pipeline_file.SEC_data_.GetFields();
+        keys.push_back(KeyFor(SEC_fields, SEC_fields.at("quarter_ending")));
+        if (pipeline_file.file_mode_ == FileMode::e_XBRL)
+        {
+            keys.push_back(KeyFor(SEC_fields, pipeline_file.filing_data_.period_end_date));
+        }
+    }
+
+    // waits until no other loader holds any of the keys then takes them all at once
+    // so 2 loaders can't deadlock.
+
+    class Lock
+    {
+    public:
+
+        Lock(FilingLocks& filing_locks, std::vector<std::string> keys)
+            : filing_locks_{filing_locks}, keys_{std::move(keys)}
+        {
+            std::unique_lock<std::mutex> lk{filing_locks_.m_};
+            filing_locks_.keys_released_.wait(lk, [this] ()
+                {
+                    return std::none_of(keys_.begin(), keys_.end(), [this] (const auto& key) { return filing_locks_.held_keys_.contains(key); });
+                });
+            filing_locks_.held_keys_.insert(keys_.begin(), keys_.end());
+        }
+        Lock(const Lock& rhs) = delete;
+        Lock& operator=(const Lock& rhs) = delete;
+
+        ~Lock()
+        {
+            {
+                std::lock_guard<std::mutex> lk{filing_locks_.m_};
+                for (const auto& key : keys_)
+                {
+                    filing_locks_.held_keys_.erase(key);
+                }
+            }
+            filing_locks_.keys_released_.notify_all();
+        }
+
+    private:
+
+        FilingLocks& filing_locks_;
+        std::vector<std::string> keys_;
+    };
+
+    std::mutex m_;
+    std::condition_variable keys_released_;
+    std::unordered_set<std::string> held_keys_;
+};
+
 /*
  *--------------------------------------------------------------------------------------
  *       Class:  ExtractorApp
@@ -252,10 +450,24 @@ void ExtractorApp::SetupProgramOptions ()
 		("UpdateSharesOutstanding", po::value<bool>(&update_shares_outstanding_)->default_value(false)->implicit_value(true),
             "Update Shares outstanding value in DB.")
 		("list-file", po::value<EM::FileName>(&list_of_files_to_process_path_),"path to file with list of files to process.")
+		("share-XBRL-labels", po::value<bool>(&share_XBRL_labels_)->default_value(false)->implicit_value(true),
+            "re-use us-gaap field labels from earlier filings instead of reading each filing's own. Default is 'false'")
+		("label-cache-file", po::value<EM::FileName>(&label_cache_file_),
+         "file to load shared XBRL labels from at startup and save them to at the end. Implies 'share-XBRL-labels'.")
+		("regex-stats", po::value<bool>(&log_regex_stats_)->default_value(false)->implicit_value(true),
+            "count calls, bytes scanned and time spent for each registered regex and log them at the end. Default is 'false'")
+		("regex-backend", po::value<std::string>(&regex_backend_)->default_value("linear"),
+         "Matcher to use for regexes which have a linear time version. Must be either 'linear' or 'boost'. Default is 'linear'.")
 		("log-level,l", po::value<std::string>(&logging_level_),
          "logging level. Must be 'none|error|information|debug'. Default is 'information'.")
 		("mode,m", po::value<std::string>(&data_source_)->required(), "Must be either 'BOTH' or 'HTML' or 'XBRL'.")
 		("DB-mode", po::value<std::string>(&DB_mode_), "Must be either 'test' or 'live'. Default is 'test'.")
+		("DB-connection", po::value<std::string>(&DB_connection_string_)->default_value("dbname=sec_extracts user=extractor_pg"),
+         "Postgres connection string. Default is 'dbname=sec_extracts user=extractor_pg'.")
+		("DB-pool-size", po::value<int>(&DB_pool_size_)->default_value(-1),
+         "Number of DB connections to keep open. Default of -1 means one for each thread which uses the DB.")
+		("DB-copy-format", po::value<std::string>(&DB_copy_format_name_)->default_value("text"),
+         "Format used to COPY data values to the DB. Must be either 'text' or 'binary'. Default is 'text'.")
 		("form", po::value<std::string>(&form_)->default_value("10-Q"),
          "name of form type we are processing. May be comma-delimited list. Default is '10-Q'.")
 		("CIK",	po::value<std::string>(&CIK_),
@@ -267,6 +479,18 @@ void ExtractorApp::SetupProgramOptions ()
          "Maximun number of forms to process -- mainly for testing. Default of -1 means no limit.")
 		("concurrent,k", po::value<int>(&max_at_a_time_)->default_value(-1),
          "Maximun number of concurrent processes. Default of -1 -- system defined.")
+		("read-threads", po::value<int>(&read_threads_)->default_value(1),
+         "Number of threads reading and splitting files in the pipeline. Default is 1.")
+		("extract-threads", po::value<int>(&extract_threads_)->default_value(-1),
+         "Number of threads extracting data in the pipeline. Using this runs the pipeline instead of 'concurrent'. Default of -1 means no pipeline.")
+		("load-threads", po::value<int>(&load_threads_)->default_value(1),
+         "Number of threads loading data to the DB in the pipeline. Default is 1.")
+		("queue-depth", po::value<int>(&queue_depth_)->default_value(8),
+         "Maximum number of files waiting between pipeline stages. Default is 8.")
+		("DB-batch-files", po::value<int>(&DB_batch_files_)->default_value(1),
+         "Maximum number of XBRL files the pipeline loads in a single transaction. Default of 1 means no batching.")
+		("DB-batch-rows", po::value<int>(&DB_batch_rows_)->default_value(100'000),
+         "Load a batch of XBRL files once it has this many data rows. Default is 100000.")
 		("filename-has-form", po::value<bool>(&filename_has_form_)->default_value(false)->implicit_value(true),
             "form number is in file path. Default is 'false'")
 		("resume-at", po::value<std::string>(&resume_at_this_filename_),
@@ -360,6 +584,9 @@ bool ExtractorApp::CheckArgs ()
         schema_prefix_ = (DB_mode_ == "test" ? "" : "live_");
     }
 
+    BOOST_ASSERT_MSG(DB_copy_format_name_ == "text" || DB_copy_format_name_ == "binary", "DB-copy-format must be: 'text' or 'binary'.");
+    DB_copy_format_ = DB_copy_format_name_ == "binary" ? CopyFormat::e_Binary : CopyFormat::e_Text;
+
     //  the user may specify multiple form types in a comma delimited list. We need to parse the entries out
     //  of that list and place into ultimate home.  If just a single entry, copy it to our form list destination too.
 
@@ -419,6 +646,16 @@ bool ExtractorApp::CheckArgs ()
     BOOST_ASSERT_MSG(NotAllEmpty(single_file_to_process_.get(), local_form_file_directory_.get(), list_of_files_to_process_),
             "No files to process found.");
 
+    // every DB function shares this so we need it before we build our filters.
+    // we don't open any connections until they are needed.
+    // in the pipeline, only the load threads talk to the DB.
+
+    if (DB_pool_size_ < 1)
+    {
+        DB_pool_size_ = std::max(1, extract_threads_ > 0 ? load_threads_ : max_at_a_time_);
+    }
+    db_pool_ = std::make_unique<DBConnectionPool>(DB_connection_string_, DB_pool_size_);
+
     BuildFilterList();
 
     // make sure we don't have too many threads allocated.
@@ -426,6 +663,16 @@ bool ExtractorApp::CheckArgs ()
 
     max_at_a_time_ = std::min<int>(max_at_a_time_, list_of_files_to_process_.size());
 
+    if (extract_threads_ > 0)
+    {
+        BOOST_ASSERT_MSG(read_threads_ > 0, "Pipeline needs at least 1 read thread.");
+        BOOST_ASSERT_MSG(load_threads_ > 0, "Pipeline needs at least 1 load thread.");
+        BOOST_ASSERT_MSG(queue_depth_ > 0, "Pipeline queue depth must be at least 1.");
+        BOOST_ASSERT_MSG(DB_batch_files_ > 0, "DB batch must have at least 1 file.");
+        BOOST_ASSERT_MSG(DB_batch_rows_ > 0, "DB batch must have at least 1 row.");
+        read_threads_ = std::min<int>(read_threads_, list_of_files_to_process_.size());
+    }
+
     if (export_XLS_files_)
     {
         BOOST_ASSERT_MSG(! SS_export_directory_.get().empty(), "Must specify XLS export directory.");
@@ -443,6 +690,31 @@ bool ExtractorApp::CheckArgs ()
         BOOST_ASSERT_MSG(data_source_ == "HTML", "Must use HTML mode.");
     }
 
+    // labels can differ from filer to filer for the same field so sharing them
+    // is something the user has to ask for.
+
+    if (! label_cache_file_.get().empty())
+    {
+        share_XBRL_labels_ = true;
+    }
+    if (share_XBRL_labels_)
+    {
+        auto label_cache = std::make_unique<XBRL_LabelCache>();
+        if (! label_cache_file_.get().empty() && fs::exists(label_cache_file_.get()))
+        {
+            label_cache->Load(label_cache_file_);
+        }
+        label_cache_ = std::move(label_cache);
+    }
+
+    // compile our shared regexes now, before any threads start.
+
+    BOOST_ASSERT_MSG(regex_backend_ == "linear" || regex_backend_ == "boost", "regex-backend must be: 'linear' or 'boost'.");
+
+    RegexRegistry::Initialize();
+    RegexRegistry::CountUses(log_regex_stats_);
+    RegexRegistry::UseLinearMatchers(regex_backend_ == "linear");
+
     return true;
 }       // -----  end of method ExtractorApp::CheckArgs  -----
 
@@ -485,7 +757,10 @@ void ExtractorApp::BuildFilterList()
 
     if ((! export_HTML_forms_ && ! update_shares_outstanding_))
     {
-        filters_.emplace_back(NeedToUpdateDBContent{schema_prefix_, data_source_, replace_DB_content_});
+        // one scan of the existing keys up front saves a query for every file.
+
+        filing_id_index_.Load(*db_pool_, schema_prefix_ + "unified_extracts");
+        filters_.emplace_back(NeedToUpdateDBContent{&filing_id_index_, data_source_, replace_DB_content_});
     }
 
     if (! form_.empty())
@@ -519,7 +794,11 @@ std::tuple<int, int, int> ExtractorApp::Run()
 
     if (! list_of_files_to_process_.empty())
     {
-        if (max_at_a_time_ < 1)
+        if (extract_threads_ > 0)
+        {
+            list_counters = this->LoadFilesFromListToDBPipelined();
+        }
+        else if (max_at_a_time_ < 1)
         {
             list_counters = this->LoadFilesFromListToDB();
         }
@@ -546,16 +825,21 @@ std::tuple<int, int, int> ExtractorApp::Run()
     spdlog::info(catenate("Processed: ", SumT(counters), " files. Successes: ",
             success_counter, ". Skips: ", skipped_counter , ". Errors: ", error_counter, "."));
 
+    if (log_regex_stats_)
+    {
+        RegexRegistry::LogCounters();
+    }
+
     return counters;
 }		/* -----  end of method ExtractorApp::Run  ----- */
 
-std::optional<ExtractorApp::FileMode> ExtractorApp::ApplyFilters(const EM::SEC_Header_fields& SEC_fields, const EM::FileName& file_name, const EM::DocumentSectionList& sections,
+std::optional<ExtractorApp::FileMode> ExtractorApp::ApplyFilters(const SEC_HeaderRecord& SEC_record, const EM::FileName& file_name, const EM::DocumentSectionList& sections,
         std::atomic<int>* forms_processed)
 {
     bool use_file{true};
     for (const auto& filter : filters_)
     {
-        use_file = std::visit([&SEC_fields, sections](auto& f) -> bool { return f(SEC_fields, sections); }, filter);
+        use_file = std::visit([&SEC_record, &sections](auto& f) -> bool { return f(SEC_record, sections); }, filter);
         if (! use_file)
         {
             spdlog::info(catenate(file_name.get(), ": File skipped because of filter: ",
@@ -570,14 +854,14 @@ std::optional<ExtractorApp::FileMode> ExtractorApp::ApplyFilters(const EM::SEC_H
     if (data_source_ == "BOTH" || data_source_ == "XBRL")
     {
         FileHasXBRL filter1;
-        use_file = filter1(SEC_fields, sections);
+        use_file = filter1(SEC_record, sections);
         if (use_file)
         {
             // OK, now let's look for the Financial Report spreadsheet.
             // We'll use that if available.
 
             FileHasXLS filter1a;
-            use_file = filter1a(SEC_fields, sections);
+            use_file = filter1a(SEC_record, sections);
             if (use_file)
             {
                 auto x = forms_processed->fetch_add(1);
@@ -603,7 +887,7 @@ std::optional<ExtractorApp::FileMode> ExtractorApp::ApplyFilters(const EM::SEC_H
     if (data_source_ == "BOTH" || data_source_ == "HTML")
     {
         FileHasHTML filter1{form_list_};
-        use_file = filter1(SEC_fields, sections);
+        use_file = filter1(SEC_record, sections);
         if (use_file)
         {
             auto x = forms_processed->fetch_add(1);
@@ -619,23 +903,73 @@ std::optional<ExtractorApp::FileMode> ExtractorApp::ApplyFilters(const EM::SEC_H
     return std::nullopt;
 }
 
+/*
+ * ===  FUNCTION  ======================================================================
+ *         Name:  ExtractorApp::HeaderPassesFilters
+ *  Description:  read just enough of the file to get its SEC header and run our
+ *                filters on that. If we can't find the whole header, we let the full
+ *                check decide.
+ * =====================================================================================
+ */
+bool ExtractorApp::HeaderPassesFilters (const EM::FileName& file_name)
+{
+    if (filters_.empty())
+    {
+        return true;
+    }
+
+    for (auto prefix_size : {SEC_HEADER_PREFIX_SIZE, MAX_SEC_HEADER_PREFIX_SIZE})
+    {
+        const auto file_prefix = MappedFile::ReadFilePrefix(file_name, prefix_size);
+        if (! SEC_Header::FindHeader(file_prefix))
+        {
+            if (file_prefix.size() < prefix_size)
+            {
+                // we have the whole file so there's no point in reading more.
+
+                break;
+            }
+            continue;
+        }
+
+        SEC_Header SEC_data;
+        SEC_data.UseData(EM::FileContent{file_prefix});
+        SEC_data.ExtractHeaderFields();
+
+        const EM::DocumentSectionList no_sections;
+        for (const auto& filter : filters_)
+        {
+            bool use_file = std::visit([&SEC_data, &no_sections](auto& f) -> bool { return f(SEC_data.GetRecord(), no_sections); }, filter);
+            if (! use_file)
+            {
+                spdlog::info(catenate(file_name.get(), ": File skipped because of filter: ",
+                    std::visit([](auto& f) -> std::string { return f.filter_name_; }, filter), "."));
+                return false;
+            }
+        }
+        return true;
+    }
+    return true;
+}		/* -----  end of method ExtractorApp::HeaderPassesFilters  ----- */
+
 std::tuple<int, int, int> ExtractorApp::LoadSingleFileToDB(const EM::FileName& input_file_name)
 {
     std::atomic<int> forms_processed{0};
     try
     {
-        const std::string content{LoadDataFileForUse(input_file_name)};
-        EM::FileContent file_content{content};
+        const MappedFile content{input_file_name};
+        const EM::FileContent file_content{content.GetContent()};
         const auto document_sections = LocateDocumentSections(file_content);
 
         SEC_Header SEC_data;
         SEC_data.UseData(file_content);
         SEC_data.ExtractHeaderFields();
-        decltype(auto) SEC_fields = SEC_data.GetFields();
 
-        auto use_file = this->ApplyFilters(SEC_fields, input_file_name, document_sections, &forms_processed);
+        auto use_file = this->ApplyFilters(SEC_data.GetRecord(), input_file_name, document_sections, &forms_processed);
         BOOST_ASSERT_MSG(use_file, "Specified file does not meet other criteria.");
 
+        decltype(auto) SEC_fields = SEC_data.GetFields();
+
         if (use_file.value() == FileMode::e_XLS)
         {
             return LoadSingleFileToDB_XLS(file_content, document_sections, SEC_data.GetHeader(), SEC_fields, input_file_name);
@@ -664,7 +998,7 @@ std::tuple<int, int, int> ExtractorApp::LoadSingleFileToDB_XLS(const EM::FileCon
 {
     //TODO: check for and handle exporting spreadsheets
     //
-    auto the_tables = FindAndExtractXLSContent(document_sections, input_file_name);
+    auto the_tables = FindAndExtractXLSContent(document_sections);
     BOOST_ASSERT_MSG(the_tables.has_data(), catenate("Can't find required XLS financial tables: ",
         input_file_name.get()).c_str());
 
@@ -672,9 +1006,10 @@ std::tuple<int, int, int> ExtractorApp::LoadSingleFileToDB_XLS(const EM::FileCon
         input_file_name.get()).c_str());
 
 //        did_load = true;
-    bool did_load = LoadDataToDB_XLS(SEC_fields, the_tables, schema_prefix_ + "unified_extracts", replace_DB_content_);
+    bool did_load = LoadDataToDB_XLS(*db_pool_, SEC_fields, the_tables, schema_prefix_ + "unified_extracts", replace_DB_content_, DB_copy_format_);
     if (did_load)
     {
+        RecordLoadedFiling(SEC_fields, SEC_fields.at("quarter_ending"), "XLS");
         return {1, 0, 0};
     }
     return {0, 1, 0};
@@ -683,21 +1018,18 @@ std::tuple<int, int, int> ExtractorApp::LoadSingleFileToDB_XLS(const EM::FileCon
 std::tuple<int, int, int> ExtractorApp::LoadSingleFileToDB_XBRL(const EM::FileContent& file_content, const EM::DocumentSectionList& document_sections,
         const EM::SEC_Header_fields& SEC_fields, const EM::FileName& input_file_name)
 {
-    auto labels_document = LocateLabelDocument(document_sections, input_file_name);
-    auto labels_xml = ParseXMLContent(labels_document);
+    FilingArena arena;
 
-    auto instance_document = LocateInstanceDocument(document_sections, input_file_name);
-    auto instance_xml = ParseXMLContent(instance_document);
+    auto instance_document = LocateInstanceDocument(document_sections);
+    auto [filing_data, gaap_data, context_data] = ExtractInstanceData(instance_document, arena.resource());
+    auto label_data = FindFieldLabels(document_sections, gaap_data);
+    spdlog::debug(catenate("XBRL facts: ", gaap_data.size(), " using: ", arena.BytesReserved(), " bytes."));
 
-    auto filing_data = ExtractFilingData(instance_xml);
-    auto gaap_data = ExtractGAAPFields(instance_xml);
-    auto context_data = ExtractContextDefinitions(instance_xml);
-    auto label_data = ExtractFieldLabels(labels_xml);
-
-    bool did_load = LoadDataToDB(SEC_fields, filing_data, gaap_data, label_data, context_data, schema_prefix_ + "unified_extracts", replace_DB_content_);
+    bool did_load = LoadDataToDB(*db_pool_, SEC_fields, filing_data, gaap_data, label_data, context_data, schema_prefix_ + "unified_extracts", replace_DB_content_, DB_copy_format_);
 
     if (did_load)
     {
+        RecordLoadedFiling(SEC_fields, filing_data.period_end_date, "XBRL");
         return {1, 0, 0};
     }
     return {0, 1, 0};
@@ -708,7 +1040,7 @@ std::tuple<int, int, int> ExtractorApp::LoadSingleFileToDB_HTML(const EM::FileCo
 {
     if (update_shares_outstanding_)
     {
-        UpdateOutstandingShares(so_, document_sections, SEC_fields, form_list_, schema_prefix_ + "unified_extracts", input_file_name);
+        UpdateOutstandingShares(*db_pool_, so_, document_sections, SEC_fields, form_list_, schema_prefix_ + "unified_extracts", input_file_name);
         return {1, 0, 0};
     }
 
@@ -729,9 +1061,10 @@ std::tuple<int, int, int> ExtractorApp::LoadSingleFileToDB_HTML(const EM::FileCo
         input_file_name.get()).c_str());
 
 //        did_load = true;
-    bool did_load = LoadDataToDB(SEC_fields, the_tables, schema_prefix_ + "unified_extracts", replace_DB_content_);
+    bool did_load = LoadDataToDB(*db_pool_, SEC_fields, the_tables, schema_prefix_ + "unified_extracts", replace_DB_content_, DB_copy_format_);
     if (did_load)
     {
+        RecordLoadedFiling(SEC_fields, SEC_fields.at("quarter_ending"), "HTML");
         return {1, 0, 0};
     }
     return {0, 1, 0};
@@ -859,20 +1192,24 @@ void ExtractorApp::Do_SingleFile(std::atomic<int>* forms_processed, int& success
                     return;
                 }
             }
+            if (! HeaderPassesFilters(file_name))
+            {
+                ++skipped_counter;
+                return;
+            }
             spdlog::info(catenate("Scanning file: ", file_name.get()));
-            const std::string content{LoadDataFileForUse(file_name)};
-            EM::FileContent file_content{content};
+            const MappedFile content{file_name};
+            const EM::FileContent file_content{content.GetContent()};
             const auto document_sections = LocateDocumentSections(file_content);
 
             SEC_Header SEC_data;
             SEC_data.UseData(file_content);
             SEC_data.ExtractHeaderFields();
-            decltype(auto) SEC_fields = SEC_data.GetFields();
             auto sec_header = SEC_data.GetHeader();
 
-            if (auto use_file = this->ApplyFilters(SEC_fields, file_name,  document_sections, forms_processed); use_file)
+            if (auto use_file = this->ApplyFilters(SEC_data.GetRecord(), file_name,  document_sections, forms_processed); use_file)
             {
-                LoadFileFromFolderToDB(file_name, SEC_fields, document_sections, sec_header, use_file.value()) ? ++success_counter : ++skipped_counter;
+                LoadFileFromFolderToDB(file_name, SEC_data.GetFields(), document_sections, sec_header, use_file.value()) ? ++success_counter : ++skipped_counter;
             }
             else
             {
@@ -955,39 +1292,53 @@ bool ExtractorApp::LoadFileFromFolderToDB_XLS(const EM::FileName& file_name, con
 {
     //TODO: check for and handle exporting spreadsheets.
 
-    auto the_tables = FindAndExtractXLSContent(sections, file_name);
+    auto the_tables = FindAndExtractXLSContent(sections);
     BOOST_ASSERT_MSG(the_tables.has_data(), catenate("Can't find required XLS financial tables: ", file_name.get()).c_str());
 
     BOOST_ASSERT_MSG(! the_tables.ListValues().empty(), catenate("Can't find any data fields in tables: ", file_name.get()).c_str());
+    bool did_load{false};
     if (db_mutex == nullptr)
     {
-        return LoadDataToDB_XLS(SEC_fields, the_tables, schema_prefix_ + "unified_extracts", replace_DB_content_);
+        did_load = LoadDataToDB_XLS(*db_pool_, SEC_fields, the_tables, schema_prefix_ + "unified_extracts", replace_DB_content_, DB_copy_format_);
+    }
+    else
+    {
+        std::lock_guard<std::mutex> lock(*db_mutex);
+        did_load = LoadDataToDB_XLS(*db_pool_, SEC_fields, the_tables, schema_prefix_ + "unified_extracts", replace_DB_content_, DB_copy_format_);
+    }
+    if (did_load)
+    {
+        RecordLoadedFiling(SEC_fields, SEC_fields.at("quarter_ending"), "XLS");
     }
-    std::lock_guard<std::mutex> lock(*db_mutex);
-    return LoadDataToDB_XLS(SEC_fields, the_tables, schema_prefix_ + "unified_extracts", replace_DB_content_);
+    return did_load;
 
 }		/* -----  end of method ExtractorApp::LoadFileFromFolderToDB_HTML  ----- */
 
 bool ExtractorApp::LoadFileFromFolderToDB_XBRL(const EM::FileName& file_name, const EM::SEC_Header_fields& SEC_fields,
         const EM::DocumentSectionList& document_sections, std::mutex* db_mutex)
 {
-    auto labels_document = LocateLabelDocument(document_sections, file_name);
-    auto labels_xml = ParseXMLContent(labels_document);
-
-    auto instance_document = LocateInstanceDocument(document_sections, file_name);
-    auto instance_xml = ParseXMLContent(instance_document);
+    FilingArena arena;
 
-    auto filing_data = ExtractFilingData(instance_xml);
-    auto gaap_data = ExtractGAAPFields(instance_xml);
-    auto context_data = ExtractContextDefinitions(instance_xml);
-    auto label_data = ExtractFieldLabels(labels_xml);
+    auto instance_document = LocateInstanceDocument(document_sections);
+    auto [filing_data, gaap_data, context_data] = ExtractInstanceData(instance_document, arena.resource());
+    auto label_data = FindFieldLabels(document_sections, gaap_data);
+    spdlog::debug(catenate("XBRL facts: ", gaap_data.size(), " using: ", arena.BytesReserved(), " bytes."));
 
+    bool did_load{false};
     if (db_mutex == nullptr)
     {
-        return LoadDataToDB(SEC_fields, filing_data, gaap_data, label_data, context_data, schema_prefix_ + "unified_extracts", replace_DB_content_);
+        did_load = LoadDataToDB(*db_pool_, SEC_fields, filing_data, gaap_data, label_data, context_data, schema_prefix_ + "unified_extracts", replace_DB_content_, DB_copy_format_);
+    }
+    else
+    {
+        std::lock_guard<std::mutex> lock(*db_mutex);
+        did_load = LoadDataToDB(*db_pool_, SEC_fields, filing_data, gaap_data, label_data, context_data, schema_prefix_ + "unified_extracts", replace_DB_content_, DB_copy_format_);
+    }
+    if (did_load)
+    {
+        RecordLoadedFiling(SEC_fields, filing_data.period_end_date, "XBRL");
     }
-    std::lock_guard<std::mutex> lock(*db_mutex);
-    return LoadDataToDB(SEC_fields, filing_data, gaap_data, label_data, context_data, schema_prefix_ + "unified_extracts", replace_DB_content_);
+    return did_load;
 }		/* -----  end of method ExtractorApp::LoadFileFromFolderToDB_XBRL  ----- */
 
 bool ExtractorApp::LoadFileFromFolderToDB_HTML(const EM::FileName& file_name, const EM::SEC_Header_fields& SEC_fields,
@@ -995,7 +1346,7 @@ bool ExtractorApp::LoadFileFromFolderToDB_HTML(const EM::FileName& file_name, co
 {
     if (update_shares_outstanding_)
     {
-        UpdateOutstandingShares(so_, sections, SEC_fields, form_list_, schema_prefix_ + "unified_extracts", file_name);
+        UpdateOutstandingShares(*db_pool_, so_, sections, SEC_fields, form_list_, schema_prefix_ + "unified_extracts", file_name);
         return true;
     }
 
@@ -1008,12 +1359,21 @@ bool ExtractorApp::LoadFileFromFolderToDB_HTML(const EM::FileName& file_name, co
     BOOST_ASSERT_MSG(the_tables.has_data(), catenate("Can't find required HTML financial tables: ", file_name.get()).c_str());
 
     BOOST_ASSERT_MSG(! the_tables.ListValues().empty(), catenate("Can't find any data fields in tables: ", file_name.get()).c_str());
+    bool did_load{false};
     if (db_mutex == nullptr)
     {
-        return LoadDataToDB(SEC_fields, the_tables, schema_prefix_ + "unified_extracts", replace_DB_content_);
+        did_load = LoadDataToDB(*db_pool_, SEC_fields, the_tables, schema_prefix_ + "unified_extracts", replace_DB_content_, DB_copy_format_);
+    }
+    else
+    {
+        std::lock_guard<std::mutex> lock(*db_mutex);
+        did_load = LoadDataToDB(*db_pool_, SEC_fields, the_tables, schema_prefix_ + "unified_extracts", replace_DB_content_, DB_copy_format_);
+    }
+    if (did_load)
+    {
+        RecordLoadedFiling(SEC_fields, SEC_fields.at("quarter_ending"), "HTML");
     }
-    std::lock_guard<std::mutex> lock(*db_mutex);
-    return LoadDataToDB(SEC_fields, the_tables, schema_prefix_ + "unified_extracts", replace_DB_content_);
+    return did_load;
 }		/* -----  end of method ExtractorApp::LoadFileFromFolderToDB_HTML  ----- */
 
 std::tuple<int, int, int> ExtractorApp::LoadFileAsync(const EM::FileName& file_name, std::atomic<int>* forms_processed, std::mutex* db_mutex)
@@ -1032,24 +1392,26 @@ std::tuple<int, int, int> ExtractorApp::LoadFileAsync(const EM::FileName& file_n
         }
     }
     
+    if (! HeaderPassesFilters(file_name))
+    {
+        ++skipped_counter;
+        return {success_counter, skipped_counter, error_counter};
+    }
     spdlog::info(catenate("Scanning file: ", file_name.get()));
-    const std::string content(LoadDataFileForUse(file_name));
-    EM::FileContent file_content{content};
+    const MappedFile content{file_name};
+    const EM::FileContent file_content{content.GetContent()};
     const auto document_sections = LocateDocumentSections(file_content);
 
     SEC_Header SEC_data;
     SEC_data.UseData(file_content);
     SEC_data.ExtractHeaderFields();
-    decltype(auto) SEC_fields = SEC_data.GetFields();
     auto sec_header = SEC_data.GetHeader();
 
-    auto locking_id = catenate(SEC_fields.at("cik"), '_', SEC_fields.at("quarter_ending"));
-
-    if (auto use_file = this->ApplyFilters(SEC_fields, file_name, document_sections, forms_processed); use_file)
+    if (auto use_file = this->ApplyFilters(SEC_data.GetRecord(), file_name, document_sections, forms_processed); use_file)
     {
         try
         {
-            LoadFileFromFolderToDB(file_name, SEC_fields, document_sections, sec_header, use_file.value(), db_mutex) ? ++success_counter : ++skipped_counter;
+            LoadFileFromFolderToDB(file_name, SEC_data.GetFields(), document_sections, sec_header, use_file.value(), db_mutex) ? ++success_counter : ++skipped_counter;
         }
         catch(const pqxx::failure& e)
         {
@@ -1099,162 +1461,421 @@ std::tuple<int, int, int> ExtractorApp::LoadFilesFromListToDBConcurrently()
 
     std::atomic<int> forms_processed{0};
 
-    // keep track of our async processes here.
-
-    std::vector<std::future<std::tuple<int, int, int>>> tasks;
-    tasks.reserve(max_at_a_time_);
-
     // use this to manage potential concurrent access when processing amended forms.
 
     std::mutex db_mutex;
 //    ExtractMutex active_forms;
 
-    // prime the pump...
+    // our workers hand back their results here and let us know.
+    // we don't poll, we wait to be told.
 
-    size_t current_file{0};
-    for ( ; tasks.size() < max_at_a_time_ && current_file < list_of_files_to_process_.size(); ++current_file)
-    {
-        // queue up our tasks up to the limit.
+    std::mutex completed_tasks_mutex;
+    std::condition_variable task_completed;
+    std::vector<CompletedTask> completed_tasks;
 
-        tasks.emplace_back(std::async(std::launch::async, &ExtractorApp::LoadFileAsync, this,
-        EM::FileName{list_of_files_to_process_[current_file]}, &forms_processed, &db_mutex));
-    }
+    auto process_file([this, &forms_processed, &db_mutex, &completed_tasks_mutex, &task_completed, &completed_tasks] (std::size_t file_index)
+        {
+            CompletedTask result;
+            try
+            {
+                result.counters_ = LoadFileAsync(EM::FileName{list_of_files_to_process_[file_index]}, &forms_processed, &db_mutex);
+            }
+            catch (...)
+            {
+                result.error_ = std::current_exception();
+            }
+            {
+                std::lock_guard<std::mutex> lk{completed_tasks_mutex};
+                completed_tasks.push_back(std::move(result));
+            }
+            task_completed.notify_one();
+        });
 
-    int continue_here{0};
-    int ready_task{-1};
+    WorkStealingPool workers{max_at_a_time_, process_file};
+    workers.Start(list_of_files_to_process_.size());
 
-    for ( ; current_file < list_of_files_to_process_.size(); ++current_file)
+    // a signal handler can't safely notify a condition variable so we
+    // wake up every so often to see if we've been interrupted.
+
+    constexpr auto signal_check_interval = std::chrono::milliseconds{250};
+
+    std::vector<CompletedTask> ready_tasks;
+    std::vector<CompletedTask> left_over_tasks;
+    size_t files_completed{0};
+    bool keep_going{true};
+
+    while (keep_going && files_completed < list_of_files_to_process_.size())
     {
-        // we want to keep max_at_a_time_ tasks going so, as one finishes,
-        // we replace it with another
-    
-        ready_task = wait_for_any(tasks, continue_here, std::chrono::microseconds{100});
-        if (ready_task < 0)
         {
-            break;
+            std::unique_lock<std::mutex> lk{completed_tasks_mutex};
+            task_completed.wait_for(lk, signal_check_interval, [&completed_tasks] { return ! completed_tasks.empty(); });
+            ready_tasks.swap(completed_tasks);
         }
-        try
+
+        for (auto& ready_task : ready_tasks)
         {
-            auto result = tasks[ready_task].get();
-            counters = AddTs(counters, result);
+            ++files_completed;
+            if (! keep_going)
+            {
+                // we are shutting down. these get handled with the clean up.
+
+                left_over_tasks.push_back(std::move(ready_task));
+                continue;
+            }
+            if (! TallyCompletedTask(ready_task, counters, ep))
+            {
+                keep_going = false;
+            }
         }
-        catch (const std::system_error& e)
+        ready_tasks.clear();
+
+        if (ExtractorApp::had_signal_)
         {
-            // any system problems, we eventually abort, but only after finishing work in process.
+            keep_going = false;
+        }
+    }
 
-            spdlog::error(e.what());
-            auto ec = e.code();
-            spdlog::error(catenate("Category: ", ec.category().name(), ". Value: ", ec.value(),
-                    ". Message: ", ec.message()));
-            counters = AddTs(counters, {0, 0, 1});
+    // no new files get started but we let work in process finish.
 
-            // OK, let's be sure this propagates
+    workers.Stop();
+    workers.Wait();
 
-            ep = std::current_exception();
-            break;
-        }
-        catch (const MaxFilesException& e)
-        {
-            // any 'expected' problems, we'll document them and continue on.
+    // need to clean up the last set of tasks
 
-            spdlog::error(e.what());
-            counters = AddTs(counters, {0, 0, 1});
+    std::move(completed_tasks.begin(), completed_tasks.end(), std::back_inserter(left_over_tasks));
 
-            if (! ep)
+    for (const auto& ready_task : left_over_tasks)
+    {
+        TallyLeftOverTask(ready_task, counters, ep);
+    }
+
+    auto [success_counter, skipped_counter, error_counter] = counters;
+
+    if (ep)
+    {
+        spdlog::error(catenate("Processed: ", SumT(counters), " files. Successes: ", success_counter,
+                ". Skips: ", skipped_counter, ". Errors: ", error_counter, "."));
+        std::rethrow_exception(ep);
+    }
+
+    if (ExtractorApp::had_signal_)
+    {
+        spdlog::error(catenate("Processed: ", SumT(counters), " files. Successes: ", success_counter,
+                ". Skips: ", skipped_counter, ". Errors: ", error_counter, "."));
+        throw std::runtime_error("Received keyboard interrupt.  Processing manually terminated after loading: "
+            + std::to_string(success_counter) + " files.");
+    }
+
+    // if we return successfully, let's just restore the default
+
+    sigaction(SIGINT, &sa_old, 0);
+
+    return counters;
+
+}		/* -----  end of method ExtractorApp::LoadFilesFromListToDBConcurrently  ----- */
+
+/*
+ * ===  FUNCTION  ======================================================================
+ *         Name:  ExtractorApp::LoadFilesFromListToDBPipelined
+ *  Description:  run our list of files through 3 stages, each with its own threads:
+ *
+ *                read: map the file, split it into documents and apply our filters.
+ *                extract: pull the financial data out of the XBRL, XLS or HTML.
+ *                load: write the extracted data to the DB.
+ *
+ *                The stages are connected by bounded queues so reading can't get
+ *                too far ahead of the DB. Files which are skipped or fail at any
+ *                stage report back directly.
+ * =====================================================================================
+ */
+std::tuple<int, int, int> ExtractorApp::LoadFilesFromListToDBPipelined()
+{
+    // since this code can potentially run for hours on end (depending on database throughput)
+    // it's a good idea to provide a way to break into this processing and shut it down cleanly.
+
+    struct sigaction sa_old;
+    struct sigaction sa_new;
+
+    sa_new.sa_handler = ExtractorApp::HandleSignal;
+    sigemptyset(&sa_new.sa_mask);
+    sa_new.sa_flags = 0;
+    sigaction(SIGINT, &sa_new, &sa_old);
+
+    ExtractorApp::had_signal_= false;
+
+    std::exception_ptr ep{nullptr};
+
+    std::tuple<int, int, int> counters{0, 0, 0};  // success, skips, errors
+
+    std::atomic<int> forms_processed{0};
+
+    std::mutex completed_tasks_mutex;
+    std::condition_variable task_completed;
+    std::vector<CompletedTask> completed_tasks;
+
+    // we're done with this file, one way or another.
+    // this releases its content too.
+
+    auto report_file([&completed_tasks_mutex, &task_completed, &completed_tasks] (std::unique_ptr<PipelineFile> pipeline_file)
+        {
             {
-                ep = std::current_exception();
+                std::lock_guard<std::mutex> lk{completed_tasks_mutex};
+                completed_tasks.push_back(pipeline_file->result_);
             }
-            break;
-        }
-        catch(const pqxx::failure& e)
+            task_completed.notify_one();
+        });
+
+    using FileQueue = BoundedQueue<std::unique_ptr<PipelineFile>>;
+
+    FileQueue files_to_extract{static_cast<std::size_t>(queue_depth_)};
+    FileQueue files_to_load{static_cast<std::size_t>(queue_depth_)};
+
+    std::atomic<std::size_t> next_file{0};
+    std::atomic<bool> stop_reading{false};
+
+    // the last thread out of each stage closes the queue to the next stage.
+
+    std::atomic<int> readers_running{read_threads_};
+    std::atomic<int> extractors_running{extract_threads_};
+
+    // a stage which fails outside of a file's own processing can't be trusted to keep
+    // files moving so we shut the whole pipeline down.  Closing the queues wakes every
+    // stage and any which then tries to hand on a file fails too.  We keep the first problem.
+
+    std::atomic<bool> stage_failed{false};
+    std::exception_ptr stage_error{nullptr};
+
+    auto fail_pipeline([&completed_tasks_mutex, &task_completed, &files_to_extract, &files_to_load, &stop_reading, &stage_failed, &stage_error] ()
         {
-            spdlog::error(catenate("Database error: ", e.what()));
-            counters = AddTs(counters, {0, 0, 1});
-        }
-        catch (const std::exception& e)
+            {
+                std::lock_guard<std::mutex> lk{completed_tasks_mutex};
+                if (! stage_error)
+                {
+                    stage_error = std::current_exception();
+                }
+            }
+            stage_failed = true;
+            stop_reading = true;
+            files_to_extract.Close();
+            files_to_load.Close();
+            task_completed.notify_one();
+        });
+
+    auto read_files([this, &forms_processed, &report_file, &fail_pipeline, &files_to_extract, &next_file, &stop_reading, &readers_running] ()
         {
-            // any 'expected' problems, we'll document them and continue on.
+            try
+            {
+                while (! stop_reading)
+                {
+                    auto file_index = next_file.fetch_add(1);
+                    if (file_index >= list_of_files_to_process_.size())
+                    {
+                        break;
+                    }
+                    auto pipeline_file = std::make_unique<PipelineFile>(EM::FileName{list_of_files_to_process_[file_index]});
+                    bool use_file{false};
+                    try
+                    {
+                        use_file = ReadAndSplitFile(pipeline_file.get(), &forms_processed);
+                    }
+                    catch (...)
+                    {
+                        pipeline_file->result_.error_ = std::current_exception();
+                    }
+                    if (use_file)
+                    {
+                        files_to_extract.Push(std::move(pipeline_file));
+                    }
+                    else
+                    {
+                        report_file(std::move(pipeline_file));
+                    }
+                }
+            }
+            catch (...)
+            {
+                fail_pipeline();
+            }
+            if (readers_running.fetch_sub(1) == 1)
+            {
+                files_to_extract.Close();
+            }
+        });
 
-            spdlog::error(e.what());
-            counters = AddTs(counters, {0, 0, 1});
-        }
-        catch (...)
+    auto extract_files([this, &report_file, &fail_pipeline, &files_to_extract, &files_to_load, &extractors_running] ()
         {
-            // any other problems, we'll document them and stop.
+            try
+            {
+                while (auto pipeline_file = files_to_extract.Pop())
+                {
+                    auto& the_file = pipeline_file.value();
+                    bool need_to_load{false};
+                    try
+                    {
+                        need_to_load = ExtractFileContent(the_file.get());
+                    }
+                    catch (...)
+                    {
+                        the_file->result_.error_ = std::current_exception();
+                    }
+                    if (need_to_load)
+                    {
+                        files_to_load.Push(std::move(the_file));
+                    }
+                    else
+                    {
+                        report_file(std::move(the_file));
+                    }
+                }
+            }
+            catch (...)
+            {
+                fail_pipeline();
+            }
+            if (extractors_running.fetch_sub(1) == 1)
+            {
+                files_to_load.Close();
+            }
+        });
 
-            spdlog::error("Unknown problem with async file processing. Stopping...");
-            counters = AddTs(counters, {0, 0, 1});
+    // each loader uses its own DB connection.
 
-            // OK, let's remember our first time here.
+    FilingLocks filing_locks;
 
-            if (! ep)
+    // XBRL files can be batched so several go to the DB in 1 transaction.
+    // we never hold a partial batch while waiting for more work, though.
+
+    auto load_files([this, &report_file, &fail_pipeline, &files_to_load, &filing_locks] ()
+        {
+            std::vector<std::unique_ptr<PipelineFile>> batch;
+            std::size_t batch_rows{0};
+
+            auto flush_batch([this, &report_file, &batch, &batch_rows, &filing_locks] ()
+                {
+                    if (batch.empty())
+                    {
+                        return;
+                    }
+                    LoadXBRLBatchToDB(batch, &filing_locks);
+                    for (auto& the_file : batch)
+                    {
+                        report_file(std::move(the_file));
+                    }
+                    batch.clear();
+                    batch_rows = 0;
+                });
+
+            try
             {
-                ep = std::current_exception();
+                while (true)
+                {
+                    auto pipeline_file = files_to_load.TryPop();
+                    if (! pipeline_file)
+                    {
+                        flush_batch();
+                        pipeline_file = files_to_load.Pop();
+                        if (! pipeline_file)
+                        {
+                            break;
+                        }
+                    }
+                    auto& the_file = pipeline_file.value();
+                    if (DB_batch_files_ > 1 && the_file->file_mode_ == FileMode::e_XBRL)
+                    {
+                        batch_rows += the_file->gaap_data_.size();
+                        batch.push_back(std::move(the_file));
+                        if (batch.size() >= static_cast<std::size_t>(DB_batch_files_) || batch_rows >= static_cast<std::size_t>(DB_batch_rows_))
+                        {
+                            flush_batch();
+                        }
+                        continue;
+                    }
+                    LoadPipelineFileToDB(the_file.get(), &filing_locks);
+                    report_file(std::move(the_file));
+                }
             }
-            break;
-        }
+            catch (...)
+            {
+                fail_pipeline();
+            }
+        });
 
-        if (ExtractorApp::had_signal_)
-        {
-            break;
-        }
+    std::vector<std::thread> stage_threads;
+    stage_threads.reserve(read_threads_ + extract_threads_ + load_threads_);
+    for (int i = 0; i < load_threads_; ++i)
+    {
+        stage_threads.emplace_back(load_files);
+    }
+    for (int i = 0; i < extract_threads_; ++i)
+    {
+        stage_threads.emplace_back(extract_files);
+    }
+    for (int i = 0; i < read_threads_; ++i)
+    {
+        stage_threads.emplace_back(read_files);
+    }
+
+    // a signal handler can't safely notify a condition variable so we
+    // wake up every so often to see if we've been interrupted.
+
+    constexpr auto signal_check_interval = std::chrono::milliseconds{250};
 
-        //  let's keep going
+    std::vector<CompletedTask> ready_tasks;
+    std::vector<CompletedTask> left_over_tasks;
+    size_t files_completed{0};
+    bool keep_going{true};
 
-        if (current_file < list_of_files_to_process_.size())
+    while (keep_going && files_completed < list_of_files_to_process_.size())
+    {
         {
-            tasks[ready_task] = std::async(std::launch::async, &ExtractorApp::LoadFileAsync, this,
-                    EM::FileName{list_of_files_to_process_[current_file]}, &forms_processed, &db_mutex);
-            continue_here = (ready_task + 1) % max_at_a_time_;
-            ready_task = -1;
+            std::unique_lock<std::mutex> lk{completed_tasks_mutex};
+            task_completed.wait_for(lk, signal_check_interval, [&completed_tasks] { return ! completed_tasks.empty(); });
+            ready_tasks.swap(completed_tasks);
         }
-    }
 
-    // need to clean up the last set of tasks
-    for(int i = 0; i < max_at_a_time_; ++i)
-    {
-        try
+        for (auto& ready_task : ready_tasks)
         {
-            if (ready_task > -1 && i == ready_task)
+            ++files_completed;
+            if (! keep_going)
             {
+                // we are shutting down. these get handled with the clean up.
+
+                left_over_tasks.push_back(std::move(ready_task));
                 continue;
             }
-            if (tasks[i].valid())
+            if (! TallyCompletedTask(ready_task, counters, ep))
             {
-                auto result = tasks[i].get();
-                counters = AddTs(counters, result);
+                keep_going = false;
             }
         }
-        catch (const ExtractorException& e)
+        ready_tasks.clear();
+
+        if (ExtractorApp::had_signal_ || stage_failed)
         {
-            // any problems, we'll document them and continue.
+            keep_going = false;
+        }
+    }
 
-            spdlog::error(e.what());
-            counters = AddTs(counters, {0, 0, 1});
+    // no new files get read but we let files already in the pipeline finish.
 
-            // we ignore these...
+    stop_reading = true;
+    for (auto& stage_thread : stage_threads)
+    {
+        stage_thread.join();
+    }
 
-            continue;
-        }
-        catch(const std::exception& e)
-        {
-            counters = AddTs(counters, {0, 0, 1});
-            spdlog::error(e.what());
-        }
-        catch (...)
-        {
-            // any other problems, we'll document them and stop.
+    // need to clean up the last set of tasks
 
-            spdlog::error("Unknown problem with async file clean-up. ");
-            counters = AddTs(counters, {0, 0, 1});
+    std::move(completed_tasks.begin(), completed_tasks.end(), std::back_inserter(left_over_tasks));
 
-            // OK, let's remember our first time here.
+    for (const auto& ready_task : left_over_tasks)
+    {
+        TallyLeftOverTask(ready_task, counters, ep);
+    }
 
-            if (! ep)
-            {
-                ep = std::current_exception();
-            }
-        }
+    if (stage_error && ! ep)
+    {
+        ep = stage_error;
     }
 
     auto [success_counter, skipped_counter, error_counter] = counters;
@@ -1279,8 +1900,297 @@ std::tuple<int, int, int> ExtractorApp::LoadFilesFromListToDBConcurrently()
     sigaction(SIGINT, &sa_old, 0);
 
     return counters;
+}		/* -----  end of method ExtractorApp::LoadFilesFromListToDBPipelined  ----- */
 
-}		/* -----  end of method ExtractorApp::LoadFilesFromListToDBConcurrently  ----- */
+/*
+ * ===  FUNCTION  ======================================================================
+ *         Name:  ExtractorApp::ReadAndSplitFile
+ *  Description:  first pipeline stage. Returns false if the file is finished with.
+ * =====================================================================================
+ */
+bool ExtractorApp::ReadAndSplitFile (PipelineFile* pipeline_file, std::atomic<int>* forms_processed)
+{
+    const auto& file_name = pipeline_file->file_name_;
+    auto& [success_counter, skipped_counter, error_counter] = pipeline_file->result_.counters_;
+
+    if (filename_has_form_)
+    {
+        if (! FormIsInFileName(form_list_, file_name))
+        {
+            ++skipped_counter;
+            spdlog::debug(catenate(file_name.get(), ": File skipped because path is supposed to contain form name but doesn't."));
+            return false;
+        }
+    }
+
+    if (! HeaderPassesFilters(file_name))
+    {
+        ++skipped_counter;
+        return false;
+    }
+    spdlog::info(catenate("Scanning file: ", file_name.get()));
+    pipeline_file->content_ = MappedFile{file_name};
+    const EM::FileContent file_content{pipeline_file->content_.GetContent()};
+    pipeline_file->document_sections_ = LocateDocumentSections(file_content);
+
+    pipeline_file->SEC_data_.UseData(file_content);
+    pipeline_file->SEC_data_.ExtractHeaderFields();
+
+    auto use_file = this->ApplyFilters(pipeline_file->SEC_data_.GetRecord(), file_name, pipeline_file->document_sections_, forms_processed);
+    if (! use_file)
+    {
+        spdlog::info(catenate("Skipping file: ", file_name.get(), " Failed to meet criteria."));
+        ++skipped_counter;
+        return false;
+    }
+    pipeline_file->file_mode_ = use_file.value();
+    return true;
+}		/* -----  end of method ExtractorApp::ReadAndSplitFile  ----- */
+
+/*
+ * ===  FUNCTION  ======================================================================
+ *         Name:  ExtractorApp::ExtractFileContent
+ *  Description:  second pipeline stage. Returns false if there is nothing to load.
+ * =====================================================================================
+ */
+bool ExtractorApp::ExtractFileContent (PipelineFile* pipeline_file)
+{
+    const auto& file_name = pipeline_file->file_name_;
+    const auto& document_sections = pipeline_file->document_sections_;
+
+    spdlog::info(catenate("Extracting contents from file: ", file_name.get()));
+
+    if (pipeline_file->file_mode_ == FileMode::e_XLS)
+    {
+        pipeline_file->XLS_tables_ = FindAndExtractXLSContent(document_sections);
+        BOOST_ASSERT_MSG(pipeline_file->XLS_tables_.has_data(), catenate("Can't find required XLS financial tables: ", file_name.get()).c_str());
+        BOOST_ASSERT_MSG(! pipeline_file->XLS_tables_.ListValues().empty(), catenate("Can't find any data fields in tables: ", file_name.get()).c_str());
+        return true;
+    }
+
+    if (pipeline_file->file_mode_ == FileMode::e_XBRL)
+    {
+        auto instance_document = LocateInstanceDocument(document_sections);
+        auto instance_data = ExtractInstanceData(instance_document, pipeline_file->arena_.resource());
+
+        pipeline_file->filing_data_ = std::move(instance_data.filing_data_);
+        pipeline_file->gaap_data_ = std::move(instance_data.gaap_data_);
+        pipeline_file->context_data_ = std::move(instance_data.context_data_);
+        pipeline_file->label_data_ = FindFieldLabels(document_sections, pipeline_file->gaap_data_);
+        spdlog::debug(catenate("XBRL facts: ", pipeline_file->gaap_data_.size(), " using: ", pipeline_file->arena_.BytesReserved(), " bytes."));
+        return true;
+    }
+
+    // updating shares outstanding is all DB work so leave it to the loaders.
+
+    if (update_shares_outstanding_)
+    {
+        return true;
+    }
+
+    if (export_HTML_forms_)
+    {
+        auto& [success_counter, skipped_counter, error_counter] = pipeline_file->result_.counters_;
+        ExportHtmlFromSingleFile(document_sections, file_name, pipeline_file->SEC_data_.GetHeader()) ? ++success_counter : ++skipped_counter;
+        return false;
+    }
+
+    pipeline_file->HTML_tables_ = FindAndExtractFinancialStatements(so_, &document_sections, form_list_, file_name);
+    BOOST_ASSERT_MSG(pipeline_file->HTML_tables_.has_data(), catenate("Can't find required HTML financial tables: ", file_name.get()).c_str());
+    BOOST_ASSERT_MSG(! pipeline_file->HTML_tables_.ListValues().empty(), catenate("Can't find any data fields in tables: ", file_name.get()).c_str());
+    return true;
+}		/* -----  end of method ExtractorApp::ExtractFileContent  ----- */
+
+/*
+ * ===  FUNCTION  ======================================================================
+ *         Name:  ExtractorApp::LoadExtractedContentToDB
+ *  Description:  last pipeline stage.
+ * =====================================================================================
+ */
+bool ExtractorApp::LoadExtractedContentToDB (const PipelineFile& pipeline_file)
+{
+    const auto& SEC_fields = pipeline_file.SEC_data_.GetFields();
+
+    spdlog::info(catenate("Loading contents from file: ", pipeline_file.file_name_.get()));
+
+    if (pipeline_file.file_mode_ == FileMode::e_XLS)
+    {
+        bool did_load = LoadDataToDB_XLS(*db_pool_, SEC_fields, pipeline_file.XLS_tables_, schema_prefix_ + "unified_extracts", replace_DB_content_, DB_copy_format_);
+        if (did_load)
+        {
+            RecordLoadedFiling(SEC_fields, SEC_fields.at("quarter_ending"), "XLS");
+        }
+        return did_load;
+    }
+    if (pipeline_file.file_mode_ == FileMode::e_XBRL)
+    {
+        bool did_load = LoadDataToDB(*db_pool_, SEC_fields, pipeline_file.filing_data_, pipeline_file.gaap_data_, pipeline_file.label_data_,
+                pipeline_file.context_data_, schema_prefix_ + "unified_extracts", replace_DB_content_, DB_copy_format_);
+        if (did_load)
+        {
+            RecordLoadedFiling(SEC_fields, pipeline_file.filing_data_.period_end_date, "XBRL");
+        }
+        return did_load;
+    }
+    if (update_shares_outstanding_)
+    {
+        UpdateOutstandingShares(*db_pool_, so_, pipeline_file.document_sections_, SEC_fields, form_list_, schema_prefix_ + "unified_extracts",
+                pipeline_file.file_name_);
+        return true;
+    }
+    bool did_load = LoadDataToDB(*db_pool_, SEC_fields, pipeline_file.HTML_tables_, schema_prefix_ + "unified_extracts", replace_DB_content_, DB_copy_format_);
+    if (did_load)
+    {
+        RecordLoadedFiling(SEC_fields, SEC_fields.at("quarter_ending"), "HTML");
+    }
+    return did_load;
+}		/* -----  end of method ExtractorApp::LoadExtractedContentToDB  ----- */
+
+/*
+ * ===  FUNCTION  ======================================================================
+ *         Name:  ExtractorApp::LoadPipelineFileToDB
+ *  Description:
+ * =====================================================================================
+ */
+void ExtractorApp::LoadPipelineFileToDB (PipelineFile* pipeline_file, FilingLocks* filing_locks)
+{
+    auto& [success_counter, skipped_counter, error_counter] = pipeline_file->result_.counters_;
+    try
+    {
+        std::vector<std::string> keys;
+        FilingLocks::AddKeys(*pipeline_file, keys);
+        FilingLocks::Lock lock{*filing_locks, std::move(keys)};
+        LoadExtractedContentToDB(*pipeline_file) ? ++success_counter : ++skipped_counter;
+    }
+    catch(const pqxx::failure& e)
+    {
+        // need to log name of file which failed
+
+        spdlog::error(catenate("Problem adding file content to DB: ", pipeline_file->file_name_.get(), '\n', e.what()));
+        pipeline_file->result_.error_ = std::current_exception();
+    }
+    catch (...)
+    {
+        pipeline_file->result_.error_ = std::current_exception();
+    }
+}		/* -----  end of method ExtractorApp::LoadPipelineFileToDB  ----- */
+
+/*
+ * ===  FUNCTION  ======================================================================
+ *         Name:  ExtractorApp::LoadXBRLBatchToDB
+ *  Description:  all or nothing. If 2 files clash, we go back to loading them 1 at a
+ *                time so we get the same results as we would without batching.
+ * =====================================================================================
+ */
+void ExtractorApp::LoadXBRLBatchToDB (const std::vector<std::unique_ptr<PipelineFile>>& batch, FilingLocks* filing_locks)
+{
+    std::vector<XBRL_FilingToLoad> filings;
+    filings.reserve(batch.size());
+    std::vector<std::string> keys;
+    for (const auto& the_file : batch)
+    {
+        filings.push_back({&the_file->SEC_data_.GetFields(), &the_file->filing_data_, &the_file->gaap_data_,
+                &the_file->label_data_, &the_file->context_data_});
+        FilingLocks::AddKeys(*the_file, keys);
+    }
+
+    spdlog::info(catenate("Loading contents from: ", batch.size(), " files in 1 batch."));
+
+    try
+    {
+        FilingLocks::Lock lock{*filing_locks, std::move(keys)};
+        auto did_load = LoadDataToDB_Batch(*db_pool_, filings, schema_prefix_ + "unified_extracts", replace_DB_content_, DB_copy_format_);
+        for (std::size_t i = 0; i < batch.size(); ++i)
+        {
+            auto& [success_counter, skipped_counter, error_counter] = batch[i]->result_.counters_;
+            if (did_load[i])
+            {
+                RecordLoadedFiling(*filings[i].SEC_fields_, batch[i]->filing_data_.period_end_date, "XBRL");
+                ++success_counter;
+            }
+            else
+            {
+                ++skipped_counter;
+            }
+        }
+    }
+    catch(const pqxx::unique_violation& e)
+    {
+        spdlog::info(catenate("Batch of: ", batch.size(), " files clashed. Loading them 1 at a time.\n", e.what()));
+        for (const auto& the_file : batch)
+        {
+            LoadPipelineFileToDB(the_file.get(), filing_locks);
+        }
+    }
+    catch(const pqxx::failure& e)
+    {
+        for (const auto& the_file : batch)
+        {
+            spdlog::error(catenate("Problem adding file content to DB: ", the_file->file_name_.get(), '\n', e.what()));
+            the_file->result_.error_ = std::current_exception();
+        }
+    }
+    catch (...)
+    {
+        for (const auto& the_file : batch)
+        {
+            the_file->result_.error_ = std::current_exception();
+        }
+    }
+}		/* -----  end of method ExtractorApp::LoadXBRLBatchToDB  ----- */
+
+/*
+ * ===  FUNCTION  ======================================================================
+ *         Name:  ExtractorApp::RecordLoadedFiling
+ *  Description:  use the same values our loaders just wrote to sec_filing_id.
+ * =====================================================================================
+ */
+void ExtractorApp::RecordLoadedFiling (const EM::SEC_Header_fields& SEC_fields, EM::sv period_ending, EM::sv data_source)
+{
+    const auto& form_type = SEC_fields.at("form_type");
+    EM::sv base_form_type{form_type};
+    if (base_form_type.ends_with("_A"))
+    {
+        base_form_type.remove_suffix(2);
+    }
+    filing_id_index_.Record(SEC_fields.at("cik"), base_form_type, period_ending, data_source,
+            form_type.ends_with("_A") ? EM::sv{SEC_fields.at("date_filed")} : EM::sv{});
+}		/* -----  end of method ExtractorApp::RecordLoadedFiling  ----- */
+
+/*
+ * ===  FUNCTION  ======================================================================
+ *         Name:  ExtractorApp::FindFieldLabels
+ *  Description:  when every field is already in the cache we don't need to touch
+ *                the label document at all.  Otherwise we read it for just the
+ *                fields the cache doesn't know and add whatever we find to it.
+ *                Stand-alone fields never have a label so we look for them each time.
+ * =====================================================================================
+ */
+EM::Extractor_Labels ExtractorApp::FindFieldLabels (const EM::DocumentSectionList& document_sections, const EM::GAAP_DataList& gaap_data)
+{
+    EM::Extractor_Labels cached_labels;
+    std::unordered_set<EM::sv> missing_names;
+
+    if (label_cache_)
+    {
+        cached_labels = label_cache_->Find(gaap_data, missing_names);
+        if (missing_names.empty())
+        {
+            return cached_labels;
+        }
+    }
+
+    auto labels_document = LocateLabelDocument(document_sections);
+    auto labels_xml = ParseXMLContent(labels_document);
+    auto label_data = ExtractFieldLabels(labels_xml, label_cache_ ? &missing_names : nullptr);
+
+    if (label_cache_)
+    {
+        label_cache_->Add(label_data);
+        label_data.merge(cached_labels);
+    }
+    return label_data;
+}		/* -----  end of method ExtractorApp::FindFieldLabels  ----- */
 
 void ExtractorApp::HandleSignal(int signal)
 
@@ -1295,6 +2205,17 @@ void ExtractorApp::HandleSignal(int signal)
 
 void ExtractorApp::Shutdown ()
 {
+    if (label_cache_ && ! label_cache_file_.get().empty())
+    {
+        try
+        {
+            label_cache_->Save(label_cache_file_);
+        }
+        catch (const std::exception& e)
+        {
+            spdlog::error(catenate("Problem saving XBRL label cache: ", e.what()));
+        }
+    }
     spdlog::info(catenate("\n\n*** End run ", LocalDateTimeAsString(std::chrono::system_clock::now()), " ***\n"));
 }       // -----  end of method ExtractorApp::Shutdown  -----
 
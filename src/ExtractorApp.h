@@ -61,10 +61,14 @@ namespace po = boost::program_options;
 #include "date/date.h"
 #include "spdlog/spdlog.h"
 
+#include "DBConnectionPool.h"
+#include "DBCopyWriter.h"
 #include "Extractor.h"
 //#include "ExtractorMutexAndLock.h"
 #include "Extractor_Utils.h"
+#include "FilingIdIndex.h"
 #include "SharesOutstanding.h"
+#include "XBRL_LabelCache.h"
 
 class ExtractorApp
 {
@@ -108,9 +112,14 @@ protected:
 
 	void BuildFilterList();
 	void BuildListOfFilesToProcess();
-    std::optional<FileMode> ApplyFilters(const EM::SEC_Header_fields& SEC_fields, const EM::FileName& file_name,
+    std::optional<FileMode> ApplyFilters(const SEC_HeaderRecord& SEC_record, const EM::FileName& file_name,
             const EM::DocumentSectionList& sections, std::atomic<int>* forms_processed); 
 
+    // all our filters need only the SEC header so we can usually reject a file
+    // without reading all of it.
+
+    bool HeaderPassesFilters(const EM::FileName& file_name);
+
     bool LoadFileFromFolderToDB(const EM::FileName& file_name, const EM::SEC_Header_fields& SEC_fields, const EM::DocumentSectionList& sections,  
             EM::sv sec_header, FileMode file_mode, std::mutex* db_mutex=nullptr);
     bool LoadFileFromFolderToDB_XBRL(const EM::FileName& file_name, const EM::SEC_Header_fields& SEC_fields, const EM::DocumentSectionList& sections, std::mutex* db_mutex=nullptr); 
@@ -130,6 +139,31 @@ protected:
 
     std::tuple<int, int, int> LoadFileAsync(const EM::FileName& file_name, std::atomic<int>* forms_processed, std::mutex* db_mutex);
 
+    // our staged pipeline: read and split -> extract -> load to DB.
+    // each stage has its own threads and they are connected by bounded queues.
+
+    struct PipelineFile;
+    struct FilingLocks;
+
+	std::tuple<int, int, int> LoadFilesFromListToDBPipelined();
+
+    bool ReadAndSplitFile(PipelineFile* pipeline_file, std::atomic<int>* forms_processed);
+    bool ExtractFileContent(PipelineFile* pipeline_file);
+    bool LoadExtractedContentToDB(const PipelineFile& pipeline_file);
+
+    // load stage helpers. results go into each file's result_.
+
+    void LoadPipelineFileToDB(PipelineFile* pipeline_file, FilingLocks* filing_locks);
+    void LoadXBRLBatchToDB(const std::vector<std::unique_ptr<PipelineFile>>& batch, FilingLocks* filing_locks);
+
+    // keep our in-memory copy of the DB keys current.
+
+    void RecordLoadedFiling(const EM::SEC_Header_fields& SEC_fields, EM::sv period_ending, EM::sv data_source);
+
+    // uses the shared label cache, if we have one, before parsing the label document.
+
+    EM::Extractor_Labels FindFieldLabels(const EM::DocumentSectionList& document_sections, const EM::GAAP_DataList& gaap_data);
+
 		// ====================  DATA MEMBERS  =======================================
 
 private:
@@ -182,20 +216,39 @@ private:
     EM::FileName SS_export_directory_;
     EM::FileName HTML_export_source_directory_;
     EM::FileName HTML_export_target_directory_;
+    EM::FileName label_cache_file_;
 
     std::vector<EM::sv> list_of_files_to_process_;
     
     std::shared_ptr<spdlog::logger> logger_;
+
+    std::unique_ptr<DBConnectionPool> db_pool_;
+    FilingIdIndex filing_id_index_;
+    std::unique_ptr<XBRL_LabelCache> label_cache_;      // only when sharing labels
+    std::string DB_connection_string_{"dbname=sec_extracts user=extractor_pg"};
+    std::string DB_copy_format_name_{"text"};
+    std::string regex_backend_{"linear"};
+    CopyFormat DB_copy_format_{CopyFormat::e_Text};
+    int DB_pool_size_{-1};              // -1 means one per thread which uses the DB
     
     int max_forms_to_process_{-1};     // mainly for testing
     int max_at_a_time_{-1};             // how many concurrent downloads allowed
 
+    int read_threads_{1};               // pipeline stage threads
+    int extract_threads_{-1};           // -1 means don't use the pipeline
+    int load_threads_{1};
+    int queue_depth_{8};                // max files waiting between stages
+    int DB_batch_files_{1};             // XBRL files per load transaction. 1 means no batching
+    int DB_batch_rows_{100'000};        // flush a batch once it has this many data rows
+
 	bool replace_DB_content_{false};
 	bool help_requested_{false};
     bool filename_has_form_{false};
     bool export_XLS_files_{false};
     bool export_HTML_forms_{false};
     bool update_shares_outstanding_{false};
+    bool share_XBRL_labels_{false};
+    bool log_regex_stats_{false};
 
     static bool had_signal_;
 
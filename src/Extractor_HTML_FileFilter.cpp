@@ -37,14 +37,18 @@
 // =====================================================================================
 
 #include <algorithm>
+#include <array>
 #include <cctype>
 #include <charconv>
 #include <iostream>
 #include <system_error>
 
+#include "DBConnectionPool.h"
+#include "DBCopyWriter.h"
 #include "Extractor_HTML_FileFilter.h"
 #include "HTML_FromFile.h"
 #include "SEC_Header.h"
+#include "StatementClassifier.h"
 #include "TablesFromFile.h"
 
 #include <boost/regex.hpp>
@@ -244,21 +248,9 @@ AnchorsFromHTML::iterator FindDestinationAnchor (const AnchorData& financial_anc
     EM::sv looking_for = financial_anchor.href_;
     looking_for.remove_prefix(1);               // need to skip '#'
 
-    auto do_compare([&looking_for](const auto& anchor)
-    {
-        // need case insensitive compare
-        // found this on StackOverflow (but modified for my use)
-        // (https://stackoverflow.com/questions/11635/case-insensitive-string-comparison-in-c)
+    // need case insensitive compare. The anchors index themselves that way.
 
-        if (looking_for.size() != anchor.name_.size())
-        {
-            return false;
-        }
-
-        return ranges::equal( looking_for, anchor.name_,
-                [](unsigned char a, unsigned char b) { return tolower(a) == tolower(b); });
-    });
-    auto found_it = ranges::find_if(anchors, do_compare);
+    auto found_it = anchors.FindAnchorNamed(looking_for);
     if (found_it == anchors.end())
     {
         throw HTMLException("Can't find destination anchor for: " + financial_anchor.href_);
@@ -337,27 +329,7 @@ std::pair<std::string, int> TranslateMultiplier(EM::sv multiplier)
  */
 bool BalanceSheetFilter(EM::sv table)
 {
-    // here are some things we expect to find in the balance sheet section
-    // and not the other sections.
-
-//    static const boost::regex assets{R"***((?:current|total)[^\t]+?asset[^\t]*\t)***",
-//        boost::regex_constants::normal | boost::regex_constants::icase};
-//    static const boost::regex liabilities{R"***((?:current|total)[^\t]+?liabilities[^\t]*\t)***",
-//        boost::regex_constants::normal | boost::regex_constants::icase};
-    static const boost::regex assets{R"***(total[^\t]+?asset[^\t]*\t)***",
-        boost::regex_constants::normal | boost::regex_constants::icase};
-    static const boost::regex liabilities{R"***(total[^\t]+?liabilities[^\t]*\t)***",
-        boost::regex_constants::normal | boost::regex_constants::icase};
-    static const boost::regex equity
-        {R"***((?:(?:members|holders)[^\t]+?(?:equity|defici))|(?:common[^\t]+?share)|(?:common[^\t]+?stock)[^\t]*\t)***",
-        boost::regex_constants::normal | boost::regex_constants::icase};
-    static const boost::regex prepaid{R"***(prepaid[^\t]+?expense[^\t]*\t)***",
-        boost::regex_constants::normal | boost::regex_constants::icase};
-
-    std::vector<const boost::regex*> regexs{&assets, &liabilities, &equity, &prepaid};
-
-    return ApplyStatementFilter(regexs, table, 3);
-    
+    return ClassifyStatementTable(table, OnlyStatement(StatementKind::e_BalanceSheet)).any();
 }		/* -----  end of function BalanceSheetFilter  ----- */
 
 /* 
@@ -368,25 +340,7 @@ bool BalanceSheetFilter(EM::sv table)
  */
 bool StatementOfOperationsFilter(EM::sv table)
 {
-    // here are some things we expect to find in the statement of operations section
-    // and not the other sections.
-
-    static const boost::regex income{R"***((?:total|other|net|operat)[^\t]*?(?:income|revenue|sales|loss)[^\t]*\t)***",
-        boost::regex_constants::normal | boost::regex_constants::icase};
-//    const boost::regex expenses{R"***(other income|(?:(?:operating|total).*?(?:expense|costs)))***",
-//        boost::regex_constants::normal | boost::regex_constants::icase};
-    static const boost::regex expenses
-        {R"***((?:operat|total|general|administ)[^\t]*?(?:expense|costs|loss|admin|general)[^\t]*\t)***",
-            boost::regex_constants::normal | boost::regex_constants::icase};
-    static const boost::regex net_income{R"***(net[^\t]*?(?:gain|loss|income|earning)[^\t]*\t)***",
-        boost::regex_constants::normal | boost::regex_constants::icase};
-    static const boost::regex shares_outstanding
-        {R"***((?:member[^\t]+?interest)|(?:share[^\t]*outstanding)|(?:per[^\t]+?share)|(?:number[^\t]*?share)[^\t]*\t)***",
-        boost::regex_constants::normal | boost::regex_constants::icase};
-    
-    std::vector<const boost::regex*> regexs{&income, &expenses, &net_income, &shares_outstanding};
-
-    return ApplyStatementFilter(regexs, table, regexs.size());
+    return ClassifyStatementTable(table, OnlyStatement(StatementKind::e_StatementOfOperations)).any();
 }		/* -----  end of function StatementOfOperationsFilter  ----- */
 
 /* 
@@ -397,21 +351,7 @@ bool StatementOfOperationsFilter(EM::sv table)
  */
 bool CashFlowsFilter(EM::sv table)
 {
-    // here are some things we expect to find in the statement of cash flows section
-    // and not the other sections.
-
-    static const boost::regex operating
-        {R"***(operating activities|(?:cash (?:flow[s]?|used|provided)[^\t]*?(?:from|in|by)[^\t]+?operating)[^\t]*\t)***",
-        boost::regex_constants::normal | boost::regex_constants::icase};
-    static const boost::regex investing{R"***(cash (?:flow[s]?|used|provided)[^\t]*?(?:from|in|by)[^\t]+?investing[^\t]*\t)***",
-        boost::regex_constants::normal | boost::regex_constants::icase};
-    static const boost::regex financing
-        {R"***(financing activities|(?:cash (?:flow[s]?|used|provided)[^\t]*?(?:from|in|by)[^\t]+?financing)[^\t]*\t)***",
-        boost::regex_constants::normal | boost::regex_constants::icase};
-    
-    std::vector<const boost::regex*> regexs{&operating, &financing};
-
-    return ApplyStatementFilter(regexs, table, regexs.size());
+    return ClassifyStatementTable(table, OnlyStatement(StatementKind::e_CashFlows)).any();
 }		/* -----  end of function CashFlowsFilter  ----- */
 
 /* 
@@ -447,44 +387,6 @@ bool StockholdersEquityFilter(EM::sv table)
     return false;
 }		/* -----  end of function StockholdersEquityFilter  ----- */
 
-/* 
- * ===  FUNCTION  ======================================================================
- *         Name:  ApplyStatementFilter
- *  Description:  
- * =====================================================================================
- */
-bool ApplyStatementFilter (const std::vector<const boost::regex*>& regexs, EM::sv table, int matches_needed)
-{
-    auto matcher([table](const boost::regex* regex)
-        {
-            return boost::regex_search(table.begin(), table.end(), *regex, boost::regex_constants::match_not_dot_newline);
-        });
-    int how_many_matches = ranges::count_if(regexs, matcher);
-
-    if (how_many_matches < matches_needed)
-    {
-        return false;
-    }
-
-    // one more test...let's try to eliminate matches on arbitrary blocks of text which happen
-    // to contain our match criteria.
-
-    auto lines = split_string<EM::sv>(table, '\n');
-    auto regex = *regexs[1];
-
-    for (auto line : lines)
-    {
-        if (boost::regex_search(line.cbegin(), line.cend(), regex))
-        {
-            if (line.size() < 150)
-            {
-                return true;
-            }
-        }
-    }
-    return false;
-}		/* -----  end of function ApplyStatementFilter  ----- */
-
 /* 
  * ===  FUNCTION  ======================================================================
  *         Name:  FindFinancialStatements
@@ -582,23 +484,50 @@ FinancialStatements ExtractFinancialStatements (EM::HTMLContent financial_conten
 
     FinancialStatements the_tables;
 
-    auto balance_sheet = ranges::find_if(tables, [](const auto& x) { return BalanceSheetFilter(x.current_table_parsed_); });
-    if (balance_sheet != tables.end())
+    // we look at each table once, trying it against every statement we haven't found yet.
+    // the first table which matches a statement is the one we use.
+
+    std::array<TableData, STATEMENT_KINDS> statement_tables;
+    StatementKinds wanted;
+    wanted.set();
+
+    for (const auto& table : tables)
+    {
+        auto matches = ClassifyStatementTable(table.current_table_parsed_, wanted);
+        for (std::size_t kind = 0; kind < STATEMENT_KINDS; ++kind)
+        {
+            if (matches[kind])
+            {
+                statement_tables[kind] = table;
+            }
+        }
+        wanted &= ~matches;
+        if (wanted.none())
+        {
+            break;
+        }
+    }
+
+    auto found_statement([&wanted, &statement_tables] (StatementKind kind) -> const TableData*
+        {
+            auto kind_nbr = static_cast<std::size_t>(kind);
+            return wanted[kind_nbr] ? nullptr : &statement_tables[kind_nbr];
+        });
+
+    if (const auto* balance_sheet = found_statement(StatementKind::e_BalanceSheet); balance_sheet != nullptr)
     {
         the_tables.balance_sheet_.parsed_data_ = balance_sheet->current_table_parsed_;
-        the_tables.balance_sheet_.raw_data_ = balance_sheet.TableContent();
+        the_tables.balance_sheet_.raw_data_ = balance_sheet->current_table_html_;
 
-        auto statement_of_ops = ranges::find_if(tables, [](const auto& x) { return StatementOfOperationsFilter(x.current_table_parsed_); });
-        if (statement_of_ops != tables.end())
+        if (const auto* statement_of_ops = found_statement(StatementKind::e_StatementOfOperations); statement_of_ops != nullptr)
         {
             the_tables.statement_of_operations_.parsed_data_ = statement_of_ops->current_table_parsed_;
-            the_tables.statement_of_operations_.raw_data_ = statement_of_ops.TableContent();
+            the_tables.statement_of_operations_.raw_data_ = statement_of_ops->current_table_html_;
 
-            auto cash_flows = ranges::find_if(tables, [](const auto& x) { return CashFlowsFilter(x.current_table_parsed_); });
-            if (cash_flows != tables.end())
+            if (const auto* cash_flows = found_statement(StatementKind::e_CashFlows); cash_flows != nullptr)
             {
                 the_tables.cash_flows_.parsed_data_ = cash_flows->current_table_parsed_;
-                the_tables.cash_flows_.raw_data_ = cash_flows.TableContent();
+                the_tables.cash_flows_.raw_data_ = cash_flows->current_table_html_;
 
                 auto data_starts_at = std::min({ the_tables.balance_sheet_.raw_data_.get().data(),
                         the_tables.statement_of_operations_.raw_data_.get().data(),
@@ -855,15 +784,15 @@ void FinancialStatements::FindSharesOutstanding(const SharesOutstanding& so, EM:
  *  Description:  
  * =====================================================================================
  */
-MultDataList CreateMultiplierListWhenNoAnchors (const std::vector<EM::DocumentSection>& document_sections, EM::FileName document_name)
+MultDataList CreateMultiplierListWhenNoAnchors (const EM::DocumentSectionList& document_sections, EM::FileName document_name)
 {
     static const boost::regex table{R"***(<table)***",
         boost::regex_constants::normal | boost::regex_constants::icase};
 
     MultDataList results;
-    for (auto document : document_sections)
+    for (const auto& document : document_sections)
     {
-        auto html = FindHTML(document, document_name);
+        auto html = FindHTML(document);
         if (! html.get().empty())
         {
             if (boost::regex_search(html.get().begin(), html.get().end(), table))
@@ -986,14 +915,22 @@ bool StockholdersEquity::ValidateContent ()
     return false;
 }		/* -----  end of method StockholdersEquity::ValidateContent  ----- */
 
+namespace
+{
+    // same layout for all of our financial statement tables.
+
+    const std::vector<DBCopyWriter::Column> STATEMENT_DATA_COLUMNS{{"filing_ID", DBCopyWriter::ColumnType::e_BigInt},
+            {"label", DBCopyWriter::ColumnType::e_Text}, {"value", DBCopyWriter::ColumnType::e_Numeric}};
+}
+
 /* 
  * ===  FUNCTION  ======================================================================
  *         Name:  LoadDataToDB
  *  Description:  
  * =====================================================================================
  */
-bool LoadDataToDB(const EM::SEC_Header_fields& SEC_fields, const FinancialStatements& financial_statements,
-        const std::string& schema_name, bool replace_DB_content)
+bool LoadDataToDB(DBConnectionPool& db_pool, const EM::SEC_Header_fields& SEC_fields, const FinancialStatements& financial_statements,
+        const std::string& schema_name, bool replace_DB_content, CopyFormat copy_format)
 {
     auto form_type = SEC_fields.at("form_type");
     EM::sv base_form_type{form_type};
@@ -1010,8 +947,8 @@ bool LoadDataToDB(const EM::SEC_Header_fields& SEC_fields, const FinancialStatem
     // we may have multiple files that map to the samie cik/form/period_end_date that get through the
     // check for existing data but clash on the insert.  In fact, we want insert failures.
 
-    pqxx::connection c{"dbname=sec_extracts user=extractor_pg"};
-    pqxx::work trxn{c};
+    auto c = db_pool.GetConnection();
+    pqxx::work trxn{*c};
 
     // when checking for existing data, we don't filter on source
     // since that may have changed (especially if we are processing an
@@ -1112,50 +1049,47 @@ bool LoadDataToDB(const EM::SEC_Header_fields& SEC_fields, const FinancialStatem
     // now, the goal of all this...save all the financial values for the given time period.
 
     int counter = 0;
-    pqxx::stream_to inserter1{trxn, schema_name + ".sec_bal_sheet_data",
-        std::vector<std::string>{"filing_ID", "label", "value"}};
+    DBCopyWriter inserter1{c, trxn, schema_name + ".sec_bal_sheet_data", STATEMENT_DATA_COLUMNS, copy_format};
 
     for (const auto&[label, value] : financial_statements.balance_sheet_.values_)
     {
         ++counter;
-        inserter1.write_values(
+        inserter1.WriteValues(
             filing_ID,
             label,
             value
             );
     }
 
-    inserter1.complete();
+    inserter1.Complete();
 
-    pqxx::stream_to inserter2{trxn, schema_name + ".sec_stmt_of_ops_data",
-        std::vector<std::string>{"filing_ID", "label", "value"}};
+    DBCopyWriter inserter2{c, trxn, schema_name + ".sec_stmt_of_ops_data", STATEMENT_DATA_COLUMNS, copy_format};
 
     for (const auto&[label, value] : financial_statements.statement_of_operations_.values_)
     {
         ++counter;
-        inserter2.write_values(
+        inserter2.WriteValues(
             filing_ID,
             label,
             value
             );
     }
 
-    inserter2.complete();
+    inserter2.Complete();
 
-    pqxx::stream_to inserter3{trxn, schema_name + ".sec_cash_flows_data",
-        std::vector<std::string>{"filing_ID", "label", "value"}};
+    DBCopyWriter inserter3{c, trxn, schema_name + ".sec_cash_flows_data", STATEMENT_DATA_COLUMNS, copy_format};
 
     for (const auto&[label, value] : financial_statements.cash_flows_.values_)
     {
         ++counter;
-        inserter3.write_values(
+        inserter3.WriteValues(
             filing_ID,
             label,
             value
             );
     }
 
-    inserter3.complete();
+    inserter3.Complete();
 
     trxn.commit();
 
@@ -1167,7 +1101,7 @@ bool LoadDataToDB(const EM::SEC_Header_fields& SEC_fields, const FinancialStatem
 //  Description: updates the values of shares outstanding in the DB if not same as in file. 
 // =====================================================================================
 
-int UpdateOutstandingShares (const SharesOutstanding& so, const EM::DocumentSectionList& document_sections, const EM::SEC_Header_fields& fields,
+int UpdateOutstandingShares (DBConnectionPool& db_pool, const SharesOutstanding& so, const EM::DocumentSectionList& document_sections, const EM::SEC_Header_fields& fields,
         const std::vector<std::string>& forms, const std::string& schema_name, EM::FileName file_name)
 {
     int entries_updated{0};
@@ -1180,8 +1114,8 @@ int UpdateOutstandingShares (const SharesOutstanding& so, const EM::DocumentSect
     {
         int64_t file_shares = so(financial_content->html_);
 
-        pqxx::connection cnxn{"dbname=sec_extracts user=extractor_pg"};
-        pqxx::work trxn{cnxn};
+        auto cnxn = db_pool.GetConnection();
+        pqxx::work trxn{*cnxn};
 
         auto check_for_existing_content_cmd = fmt::format("SELECT count(*) FROM {3}.sec_filing_id WHERE"
             " cik = '{0}' AND form_type = '{1}' AND period_ending = '{2}' AND data_source = 'HTML'",
@@ -223,8 +223,6 @@ bool CashFlowsFilter(EM::sv table);
 
 bool StockholdersEquityFilter(EM::sv table);
 
-bool ApplyStatementFilter(const std::vector<const boost::regex*>& regexs, EM::sv table, int matches_needed);
-
 // uses a 2-phase approach to look for financial statements.
 
 FinancialStatements FindAndExtractFinancialStatements(const SharesOutstanding& so, EM::DocumentSectionList const * document_sections, const std::vector<std::string>& forms, EM::FileName document_name);
@@ -280,14 +278,14 @@ StatementType FindStatementContent(EM::HTMLContent financial_content, const Anch
     return stmt_type;
 }
 
-MultDataList CreateMultiplierListWhenNoAnchors (const std::vector<EM::DocumentSection>& document_sections, EM::FileName document_name);
+MultDataList CreateMultiplierListWhenNoAnchors (const EM::DocumentSectionList& document_sections, EM::FileName document_name);
 
 std::string ApplyMultiplierAndCleanUpValue(const EM::Extracted_Value& value, const std::string& multiplier);
 
-bool LoadDataToDB(const EM::SEC_Header_fields& SEC_fields, const FinancialStatements& financial_statements,
-        const std::string& schema_name, bool replace_DB_content);
+bool LoadDataToDB(DBConnectionPool& db_pool, const EM::SEC_Header_fields& SEC_fields, const FinancialStatements& financial_statements,
+        const std::string& schema_name, bool replace_DB_content, CopyFormat copy_format);
 
-int UpdateOutstandingShares(const SharesOutstanding& so, const EM::DocumentSectionList& document_sections, const EM::SEC_Header_fields& fields,
+int UpdateOutstandingShares(DBConnectionPool& db_pool, const SharesOutstanding& so, const EM::DocumentSectionList& document_sections, const EM::SEC_Header_fields& fields,
         const std::vector<std::string>& forms, const std::string& schema_name, EM::FileName file_name);
 
 #endif
@@ -35,19 +35,28 @@
 #include "Extractor_Utils.h"
 
 #include <algorithm>
+#include <cctype>
+#include <cstdint>
 #include <cstdlib>
+#include <cstring>
 #include <filesystem>
 #include <fstream>
 #include <iostream>
 #include <sstream>
+#include <unordered_map>
 
 #include <boost/algorithm/string.hpp>
 #include <boost/regex.hpp>
 
+#include <range/v3/algorithm/any_of.hpp>
 #include <range/v3/algorithm/find.hpp>
 
 #include <pqxx/pqxx>
 
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+
 #include "fmt/core.h"
 #include "spdlog/spdlog.h"
 
@@ -57,6 +66,8 @@ namespace fs = std::filesystem;
 using namespace std::string_literals;
 
 #include "Extractor.h"
+#include "FilingIdIndex.h"
+#include "SEC_Header.h"
 
 date::year_month_day StringToDateYMD(const std::string& input_format, const std::string& the_date)
 {
@@ -171,158 +182,324 @@ std::string LoadDataFileForUse (const EM::FileName& file_name)
     return file_content;
 }		/* -----  end of function LoadDataFileForUse  ----- */
 
-/* 
- * ===  FUNCTION  ======================================================================
- *         Name:  LocateDocumentSections
- *  Description:  
- * =====================================================================================
- */
-EM::DocumentSectionList LocateDocumentSections(EM::FileContent file_content)
+// the document splitter.
+// a filing is a sequence of <DOCUMENT> sections, each with a few header lines
+// (<TYPE>, <SEQUENCE>, <FILENAME>, <DESCRIPTION>) followed by a <TEXT> body.
+// we make one pass over the file and record everything we need about each section.
+// the bodies can be very large so we scan them with AVX2 when we can.
+
+namespace
 {
-    const std::string doc_begin{"<DOCUMENT>"};
-    const std::string doc_end{"</DOCUMENT>"};
-    const auto doc_begin_len = doc_begin.size();
-    const auto doc_end_len = doc_end.size();
+    constexpr EM::sv DOC_BEGIN_TAG{"<DOCUMENT>"};
+    constexpr EM::sv DOC_END_TAG{"</DOCUMENT>"};
+    constexpr EM::sv TEXT_BEGIN_TAG{"<TEXT>"};
+    constexpr EM::sv TEXT_END_TAG{"</TEXT>"};
+    constexpr EM::sv TYPE_TAG{"<TYPE>"};
+    constexpr EM::sv FILENAME_TAG{"<FILENAME>"};
+    constexpr EM::sv XBRL_TAG{"<XBRL>"};
+
+    inline bool HasTagAt(const char* here, const char* last, EM::sv tag)
+    {
+        return static_cast<std::size_t>(last - here) >= tag.size() && std::memcmp(here, tag.data(), tag.size()) == 0;
+    }
 
-    EM::DocumentSectionList result;
-    
-    auto found_begin = file_content.get().begin();
-    auto content_end = file_content.get().end();
+    // we are looking for 3 tags in the body of a document: '</DOCUMENT>', '</TEXT>' and '<XBRL>'.
+    // a position is a candidate if it looks like '</D', '</T' or '<XB'.
 
-    auto doc_searcher = std::boyer_moore_searcher(doc_end.begin(), doc_end.end());
+    inline bool IsBodyCandidate(const char* here, const char* last)
+    {
+        if (last - here < 3 || here[0] != '<')
+        {
+            return false;
+        }
+        return (here[1] == '/' && (here[2] == 'D' || here[2] == 'T')) || (here[1] == 'X' && here[2] == 'B');
+    }
 
-    while(found_begin != content_end)
+    struct BodyScanResult
     {
-        // look for our begin tag
+        const char* doc_end_ = nullptr;         // start of '</DOCUMENT>'
+        const char* last_text_end_ = nullptr;   // start of the last '</TEXT>' before doc_end_
+        const char* first_XBRL_ = nullptr;      // start of the first '<XBRL>'
+    };
 
-        found_begin = std::search(found_begin,
-            content_end,
-            doc_begin.begin(),
-            doc_begin.end());
+    // returns true if we found the end of the document.
 
-        if (found_begin == content_end)
+    inline bool CheckBodyCandidate(const char* here, const char* last, BodyScanResult& result)
+    {
+        if (here[1] == '/')
         {
-            break;
+            if (HasTagAt(here, last, DOC_END_TAG))
+            {
+                result.doc_end_ = here;
+                return true;
+            }
+            if (HasTagAt(here, last, TEXT_END_TAG))
+            {
+                result.last_text_end_ = here;
+            }
+        }
+        else if (result.first_XBRL_ == nullptr && HasTagAt(here, last, XBRL_TAG))
+        {
+            result.first_XBRL_ = here;
         }
+        return false;
+    }
 
-        // now, look for our end tag.
-        // since this can be rather far away, try boyer-moore
+    BodyScanResult ScanDocumentBody(const char* first, const char* last)
+    {
+        BodyScanResult result;
+        const char* here = first;
 
-        auto found_end = std::search(found_begin + doc_begin_len,
-            content_end,
-            doc_searcher);
+#ifdef __AVX2__
+        const __m256i lt = _mm256_set1_epi8('<');
+        const __m256i slash = _mm256_set1_epi8('/');
+        const __m256i X = _mm256_set1_epi8('X');
+        const __m256i D = _mm256_set1_epi8('D');
+        const __m256i T = _mm256_set1_epi8('T');
+        const __m256i B = _mm256_set1_epi8('B');
 
-        if (found_end == content_end)
+        // we load 3 overlapping blocks so we need 34 bytes available.
+
+        while (last - here >= 34)
         {
-            throw ExtractorException("Can't find end of 'DOCUMENT'");
+            const __m256i c0 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(here));
+            const __m256i c1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(here + 1));
+            const __m256i c2 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(here + 2));
+
+            const __m256i close_tag = _mm256_and_si256(_mm256_cmpeq_epi8(c1, slash),
+                _mm256_or_si256(_mm256_cmpeq_epi8(c2, D), _mm256_cmpeq_epi8(c2, T)));
+            const __m256i xbrl_tag = _mm256_and_si256(_mm256_cmpeq_epi8(c1, X), _mm256_cmpeq_epi8(c2, B));
+            const __m256i candidates = _mm256_and_si256(_mm256_cmpeq_epi8(c0, lt), _mm256_or_si256(close_tag, xbrl_tag));
+
+            auto mask = static_cast<uint32_t>(_mm256_movemask_epi8(candidates));
+            while (mask != 0)
+            {
+                const char* candidate = here + __builtin_ctz(mask);
+                if (CheckBodyCandidate(candidate, last, result))
+                {
+                    return result;
+                }
+                mask &= mask - 1;
+            }
+            here += 32;
         }
+#endif
+        // whatever is left (or everything if we don't have AVX2)
 
-        // but we need to check for nested tags which should not happen.
+        while (here < last)
+        {
+            here = static_cast<const char*>(std::memchr(here, '<', last - here));
+            if (here == nullptr)
+            {
+                break;
+            }
+            if (IsBodyCandidate(here, last) && CheckBodyCandidate(here, last, result))
+            {
+                return result;
+            }
+            ++here;
+        }
+        return result;
+    }
+
+    const char* FindDocumentBegin(const char* first, const char* last)
+    {
+        const char* here = first;
+
+#ifdef __AVX2__
+        const __m256i lt = _mm256_set1_epi8('<');
+        const __m256i D = _mm256_set1_epi8('D');
+        const __m256i O = _mm256_set1_epi8('O');
+
+        while (last - here >= 34)
+        {
+            const __m256i c0 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(here));
+            const __m256i c1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(here + 1));
+            const __m256i c2 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(here + 2));
 
-//        if (*(found_end - 1) != '/' or *(found_end - 2) != '<')
-//        {
-//            throw ExtractorException("Looks like embedded 'DOCUMENT' sections.");
-//        }
+            const __m256i candidates = _mm256_and_si256(_mm256_cmpeq_epi8(c0, lt),
+                _mm256_and_si256(_mm256_cmpeq_epi8(c1, D), _mm256_cmpeq_epi8(c2, O)));
 
-        result.emplace_back(EM::DocumentSection{EM::sv(found_begin, found_end + doc_end_len - found_begin)});
-        found_begin = found_end + doc_end_len;
+            auto mask = static_cast<uint32_t>(_mm256_movemask_epi8(candidates));
+            while (mask != 0)
+            {
+                const char* candidate = here + __builtin_ctz(mask);
+                if (HasTagAt(candidate, last, DOC_BEGIN_TAG))
+                {
+                    return candidate;
+                }
+                mask &= mask - 1;
+            }
+            here += 32;
+        }
+#endif
+        while (here < last)
+        {
+            here = static_cast<const char*>(std::memchr(here, '<', last - here));
+            if (here == nullptr)
+            {
+                break;
+            }
+            if (HasTagAt(here, last, DOC_BEGIN_TAG))
+            {
+                return here;
+            }
+            ++here;
+        }
+        return last;
     }
-    return result;
-}		/* -----  end of function LocateDocumentSections  ----- */
 
-/* 
- * ===  FUNCTION  ======================================================================
- *         Name:  FindFileName
- *  Description:  
- * =====================================================================================
- */
-EM::FileName FindFileName(const EM::DocumentSection& document, const EM::FileName& document_name)
-{
-    const boost::regex regex_fname{R"***(^<FILENAME>(.*?)$)***"};
-    boost::cmatch matches;
+    // the value of a header line, without any trailing white space.
 
-    if (bool found_it = boost::regex_search(document.get().cbegin(), document.get().cend(), matches, regex_fname); found_it)
+    inline EM::sv HeaderLineValue(EM::sv line, EM::sv tag)
     {
-        EM::FileName file_name{std::string(matches[1].first, matches[1].length())};
-        return file_name;
+        line.remove_prefix(tag.size());
+        while (! line.empty() && std::isspace(static_cast<unsigned char>(line.back())))
+        {
+            line.remove_suffix(1);
+        }
+        return line;
     }
-    throw ExtractorException(catenate("Can't find file name in document: ", document_name.get()));
-}		/* -----  end of function FindFileName  ----- */
 
-/* 
- * ===  FUNCTION  ======================================================================
- *         Name:  FindFileType
- *  Description:  
- * =====================================================================================
- */
-EM::FileType FindFileType(const EM::DocumentSection& document)
-{
-    const boost::regex regex_ftype{R"***(^<TYPE>(.*?)$)***"};
-    boost::cmatch matches;
+    // same rules as std::filesystem::path::extension(). we just don't want to create a path.
 
-    if (bool found_it = boost::regex_search(document.get().cbegin(), document.get().cend(), matches, regex_ftype); found_it)
+    inline EM::sv FileNameExtension(EM::sv file_name)
     {
-        EM::FileType file_type{EM::sv(matches[1].first, matches[1].length())};
-        return file_type;
+        if (auto last_slash = file_name.rfind('/'); last_slash != EM::sv::npos)
+        {
+            file_name.remove_prefix(last_slash + 1);
+        }
+        if (file_name == "." || file_name == "..")
+        {
+            return {};
+        }
+        auto dot = file_name.rfind('.');
+        if (dot == EM::sv::npos || dot == 0)
+        {
+            return {};
+        }
+        return file_name.substr(dot);
     }
-    throw ExtractorException("Can't find file type in document.\n");
-}		/* -----  end of function FindFileType  ----- */
+}
 
-/*
+/* 
  * ===  FUNCTION  ======================================================================
- *         Name:  FindHTML
- *  Description:
+ *         Name:  LocateDocumentSections
+ *  Description:  split the file into its documents and collect what we need
+ *                to know about each of them.
  * =====================================================================================
  */
-
-EM::HTMLContent FindHTML (const EM::DocumentSection& document, const EM::FileName& document_name)
+EM::DocumentSectionList LocateDocumentSections(EM::FileContent file_content)
 {
-    auto file_name = FindFileName(document, document_name);
-    if (file_name.get().extension() == ".htm")
+    EM::DocumentSectionList result;
+
+    const char* here = file_content.get().data();
+    const char* content_end = here + file_content.get().size();
+
+    while (here < content_end)
     {
-        // now, we just need to drop the extraneous XML surrounding the data we need.
+        // look for our begin tag
+
+        const char* doc_begin = FindDocumentBegin(here, content_end);
+        if (doc_begin == content_end)
+        {
+            break;
+        }
+
+        EM::DocumentSectionData section;
+
+        // the document header is a few short lines. the value we want is the rest of the line.
+        // it ends with the <TEXT> line.
+
+        const char* line_begin = doc_begin + DOC_BEGIN_TAG.size();
+        const char* text_begin = nullptr;
+        while (line_begin < content_end)
+        {
+            const auto* line_end = static_cast<const char*>(std::memchr(line_begin, '\n', content_end - line_begin));
+            if (line_end == nullptr)
+            {
+                line_end = content_end;
+            }
+            EM::sv line(line_begin, line_end - line_begin);
 
-        auto result{document.get()};
-        auto text_begin_loc = result.find(R"***(<TEXT>)***");
+            if (line.starts_with(TYPE_TAG))
+            {
+                if (section.file_type_.get().empty())
+                {
+                    section.file_type_ = EM::FileType{HeaderLineValue(line, TYPE_TAG)};
+                }
+            }
+            else if (line.starts_with(FILENAME_TAG))
+            {
+                if (section.file_name_.empty())
+                {
+                    section.file_name_ = HeaderLineValue(line, FILENAME_TAG);
+                    section.extension_ = FileNameExtension(section.file_name_);
+                }
+            }
+            else if (line.starts_with(TEXT_BEGIN_TAG))
+            {
+                // the body starts with the end of this line.
 
-        // skip 1 more line.
+                text_begin = line_end;
+                break;
+            }
+            else if (line.find(DOC_END_TAG) != EM::sv::npos)
+            {
+                // no <TEXT> in this document.
 
-        text_begin_loc = result.find('\n', text_begin_loc + 1);
+                break;
+            }
+            line_begin = std::min(line_end + 1, content_end);
+        }
 
-        result.remove_prefix(text_begin_loc);
+        // now, look for our end tag.
+        // since this can be rather far away, we let the vectorized scanner find it
+        // and pick up the rest of what we need along the way.
 
-        auto text_end_loc = result.rfind(R"***(</TEXT>)***");
-        if (text_end_loc != EM::sv::npos)
+        const char* body_begin = text_begin != nullptr ? text_begin : line_begin;
+        auto body = ScanDocumentBody(body_begin, content_end);
+
+        if (body.doc_end_ == nullptr)
         {
-            result.remove_suffix(result.length() - text_end_loc);
+            throw ExtractorException("Can't find end of 'DOCUMENT'");
         }
-        else
+
+        if (text_begin != nullptr && body.last_text_end_ != nullptr)
         {
-            throw HTMLException("Can't find end of HTML in document.\n");
+            section.text_ = EM::sv(text_begin, body.last_text_end_ - text_begin);
+            section.has_XBRL_ = body.first_XBRL_ != nullptr && body.first_XBRL_ < body.last_text_end_;
         }
 
+        const char* doc_end = body.doc_end_ + DOC_END_TAG.size();
+        section.document_ = EM::DocumentSection{EM::sv(doc_begin, doc_end - doc_begin)};
+        result.push_back(section);
+
+        here = doc_end;
+    }
+    return result;
+}		/* -----  end of function LocateDocumentSections  ----- */
+
+/*
+ * ===  FUNCTION  ======================================================================
+ *         Name:  FindHTML
+ *  Description:
+ * =====================================================================================
+ */
+
+EM::HTMLContent FindHTML (const EM::DocumentSectionData& document)
+{
+    if (document.extension_ == ".htm")
+    {
         // sometimes the document is actually XBRL with embedded HTML
         // we don't want that.
 
-        if (result.find(R"***(<XBRL>)***") != EM::sv::npos)
+        if (document.has_XBRL_)
         {
-//            // let's see if it contains HTML
-//
-//            const boost::regex regex_meta{R"***(<meta.*?</meta>)***"};
-//            boost::cmatch matches;
-//
-//            if (boost::regex_search(result.begin(), result.end(), matches, regex_meta))
-//            {
-//                EM::sv meta(result.data() + matches.position(), matches.length());
-//                if (meta.find("text/html"))
-//                {
-//                    return result;
-//                }
-//            }
             spdlog::info("Looks like it's really XBRL.\n");
             return EM::HTMLContent{};
         }
-        return EM::HTMLContent{result};
+        return EM::HTMLContent{document.text_};
     }
     return EM::HTMLContent{};
 }		/* -----  end of function FindHTML  ----- */
@@ -338,37 +515,21 @@ bool FormIsInFileName (const std::vector<std::string>& form_types, const EM::Fil
     return std::any_of(std::begin(form_types), std::end(form_types), check_for_form_in_name);
 }		/* -----  end of function FormIsInFileName  ----- */
 
-bool FileHasXBRL::operator()(const EM::SEC_Header_fields& SEC_fields, const EM::DocumentSectionList& document_sections) const 
+bool FileHasXBRL::operator()(const SEC_HeaderRecord& SEC_record, const EM::DocumentSectionList& document_sections) const 
 {
     // need to do a little more detailed check.
 
-    EM::FileName document_name(SEC_fields.at("file_name"));
-    for (const auto& document : document_sections)
-    {
-        auto file_name = FindFileName(document, document_name);
-        auto file_type = FindFileType(document);
-        if (file_type.get().ends_with(".INS") && file_name.get().extension() == ".xml")
+    return ranges::any_of(document_sections, [](const auto& document)
         {
-            return true;
-        }
-    }
-    return false;
+            return document.file_type_.get().ends_with(".INS") && document.extension_ == ".xml";
+        });
 }		/* -----  end of method FileHasXBRL::operator()  ----- */
 
-bool FileHasXLS::operator()(const EM::SEC_Header_fields& SEC_fields, const EM::DocumentSectionList& document_sections) const 
+bool FileHasXLS::operator()(const SEC_HeaderRecord& SEC_record, const EM::DocumentSectionList& document_sections) const 
 {
     // need to do a little more detailed check.
 
-    EM::FileName document_name(SEC_fields.at("file_name"));
-    for (const auto& document : document_sections)
-    {
-        auto file_name = FindFileName(document, document_name);
-        if (file_name.get().extension() == ".xlsx")
-        {
-            return true;
-        }
-    }
-    return false;
+    return ranges::any_of(document_sections, [](const auto& document) { return document.extension_ == ".xlsx"; });
 }		/* -----  end of method FileHasXBRL::operator()  ----- */
 
 /* 
@@ -377,20 +538,16 @@ bool FileHasXLS::operator()(const EM::SEC_Header_fields& SEC_fields, const EM::D
  *  Description:  
  * =====================================================================================
  */
-bool FileHasHTML::operator() (const EM::SEC_Header_fields& header_fields, const EM::DocumentSectionList& document_sections) const
+bool FileHasHTML::operator() (const SEC_HeaderRecord& SEC_record, const EM::DocumentSectionList& document_sections) const
 {
     // need to do a little more detailed check.
 
-    EM::FileName document_name(header_fields.at("file_name"));
     for (const auto& document : document_sections)
     {
-        auto file_name = FindFileName(document, document_name);
-        auto file_type = FindFileType(document);
-
-        if (file_name.get().extension() == ".htm"
-                && ranges::find(form_list_, file_type.get()) != ranges::end(form_list_))
+        if (document.extension_ == ".htm"
+                && ranges::find(form_list_, document.file_type_.get()) != ranges::end(form_list_))
         {
-            auto content = FindHTML(document, file_name);
+            auto content = FindHTML(document);
             if (! content.get().empty())
             {
                 return true;
@@ -400,73 +557,46 @@ bool FileHasHTML::operator() (const EM::SEC_Header_fields& header_fields, const
     return false;
 }		/* -----  end of function FileHasHTML::operator()  ----- */
 
-bool FileHasFormType::operator()(const EM::SEC_Header_fields& SEC_fields, const EM::DocumentSectionList& document_sections) const 
+bool FileHasFormType::operator()(const SEC_HeaderRecord& SEC_record, const EM::DocumentSectionList& document_sections) const 
 {
-    return (ranges::find(form_list_, SEC_fields.at("form_type")) != ranges::end(form_list_));
+    return (ranges::find(form_list_, SEC_record.form_type_text_) != ranges::end(form_list_));
 }		/* -----  end of method FileHasFormType::operator()  ----- */
 
-bool FileHasCIK::operator()(const EM::SEC_Header_fields& SEC_fields, const EM::DocumentSectionList& document_sections) const 
+bool FileHasCIK::operator()(const SEC_HeaderRecord& SEC_record, const EM::DocumentSectionList& document_sections) const 
 {
     // if our list has only 2 elements, the consider this a range.  otherwise, just a list.
 
     if (CIK_list_.size() == 2)
     {
-        return (CIK_list_[0] <= SEC_fields.at("cik") && SEC_fields.at("cik") <= CIK_list_[1]);
+        return (CIK_list_[0] <= SEC_record.cik_text_ && SEC_record.cik_text_ <= CIK_list_[1]);
     }
     
-    return (ranges::find(CIK_list_, SEC_fields.at("cik")) != ranges::end(CIK_list_));
+    return (ranges::find(CIK_list_, SEC_record.cik_text_) != ranges::end(CIK_list_));
 }		/* -----  end of method FileHasCIK::operator()  ----- */
 
-bool FileHasSIC::operator()(const EM::SEC_Header_fields& SEC_fields, const EM::DocumentSectionList& document_sections) const 
+bool FileHasSIC::operator()(const SEC_HeaderRecord& SEC_record, const EM::DocumentSectionList& document_sections) const 
 {
-    return (ranges::find(SIC_list_, SEC_fields.at("sic")) != ranges::end(SIC_list_));
+    return (ranges::find(SIC_list_, SEC_record.sic_) != ranges::end(SIC_list_));
 }		/* -----  end of method FileHasSIC::operator()  ----- */
 
-bool NeedToUpdateDBContent::operator() (const EM::SEC_Header_fields& SEC_fields, const EM::DocumentSectionList& document_sections) const 
+bool NeedToUpdateDBContent::operator() (const SEC_HeaderRecord& SEC_record, const EM::DocumentSectionList& document_sections) const 
 {
     // we need to work with just the base form name
 
-    auto form_type = SEC_fields.at("form_type");
-    EM::sv base_form_type{form_type};
-    if (base_form_type.ends_with("_A"))
-    {
-        base_form_type.remove_suffix(2);
-    }
+    const auto base_form_type = SEC_record.BaseFormType();
+    const bool is_amended = SEC_record.IsAmended();
 
-    pqxx::connection c{"dbname=sec_extracts user=extractor_pg"};
-    pqxx::work trxn{c};
+    // we answer from our copy of the DB keys instead of asking the DB.
 
-    std::string check_for_existing_content_cmd;
-    if (mode_ == "BOTH")
-    {
-        check_for_existing_content_cmd = fmt::format("SELECT count(*) AS how_many FROM {3}unified_extracts.sec_filing_id WHERE"
-            " cik = {0} AND form_type = {1} AND period_ending = {2}",
-                trxn.quote(SEC_fields.at("cik")),
-                trxn.quote(base_form_type),
-                trxn.quote(SEC_fields.at("quarter_ending")),
-                schema_prefix_)
-                ;
-    }
-    else
-    {
-        check_for_existing_content_cmd = fmt::format("SELECT count(*) AS how_many FROM {3}unified_extracts.sec_filing_id WHERE"
-            " cik = {0} AND form_type = {1} AND period_ending = {2} AND data_source = {4}",
-                trxn.quote(SEC_fields.at("cik")),
-                trxn.quote(base_form_type),
-                trxn.quote(SEC_fields.at("quarter_ending")),
-                schema_prefix_,
-                trxn.quote(mode_))
-                ;
-    }
+    auto existing_content = filing_index_->Find(SEC_record.cik_text_, base_form_type, SEC_record.quarter_ending_,
+            mode_ == "BOTH" ? EM::sv{} : EM::sv{mode_});
+    bool have_data = existing_content.has_value();
 
-	auto have_data = trxn.query_value<int>(check_for_existing_content_cmd);
-    trxn.commit();
-
-    if (have_data != 0 && ! replace_DB_content_ && ! form_type.ends_with("_A"))
+    if (have_data && ! replace_DB_content_ && ! is_amended)
     {
         // simple case here
 
-        spdlog::info(catenate("Skipping: Form data exists and Replace not specifed for file: ",SEC_fields.at("file_name")));
+        spdlog::info(catenate("Skipping: Form data exists and Replace not specifed for file: ", SEC_record.file_name_));
         return false;
     }
 
@@ -475,20 +605,12 @@ bool NeedToUpdateDBContent::operator() (const EM::SEC_Header_fields& SEC_fields,
     // we do that by checking for an amended_date_filed value in the DB
     // then, is our current amended_date_filed newer.
 
-    if (have_data != 0 && ! replace_DB_content_ && form_type.ends_with("_A"))
+    if (have_data && ! replace_DB_content_ && is_amended)
     {
-        check_for_existing_content_cmd = fmt::format("SELECT amended_date_filed FROM {3}unified_extracts.sec_filing_id WHERE"
-            " cik = {0} AND form_type = {1} AND period_ending = {2}",
-                trxn.quote(SEC_fields.at("cik")),
-                trxn.quote(base_form_type),
-                trxn.quote(SEC_fields.at("quarter_ending")),
-                schema_prefix_)
-                ;
-
-        pqxx::work trxn{c};
-	    auto amended_date = trxn.query_value<std::string>(check_for_existing_content_cmd);
-        trxn.commit();
-        if (amended_date.empty())
+        // this check doesn't care where the data came from.
+
+        auto any_content = filing_index_->Find(SEC_record.cik_text_, base_form_type, SEC_record.quarter_ending_);
+        if (! any_content || ! any_content->amended_date_filed_)
         {
             // no previously stored ameended data so 
             // we need to use this.
@@ -497,9 +619,8 @@ bool NeedToUpdateDBContent::operator() (const EM::SEC_Header_fields& SEC_fields,
 
         // lastly, let's see if this data is more recent.
 
-        auto stored_amended_date = StringToDateYMD("%F", amended_date);
-        auto date_filed = StringToDateYMD("%F", SEC_fields.at("date_filed"));
-        if (date_filed <= stored_amended_date)
+        auto stored_amended_date = any_content->amended_date_filed_.value();
+        if (SEC_record.date_filed_ <= stored_amended_date)
         {
             return false;
         }
@@ -508,10 +629,9 @@ bool NeedToUpdateDBContent::operator() (const EM::SEC_Header_fields& SEC_fields,
     return true;
 }		/* -----  end of method NeedToUpdateDBContent::operator()  ----- */
 
-bool FileIsWithinDateRange::operator()(const EM::SEC_Header_fields& SEC_fields, const EM::DocumentSectionList& document_sections) const 
+bool FileIsWithinDateRange::operator()(const SEC_HeaderRecord& SEC_record, const EM::DocumentSectionList& document_sections) const 
 {
-	auto report_date = StringToDateYMD("%F", SEC_fields.at("quarter_ending"));
-    return (begin_date_ <= report_date && report_date <= end_date_);
+    return (begin_date_ <= SEC_record.quarter_ending_ && SEC_record.quarter_ending_ <= end_date_);
 }		/* -----  end of method FileIsWithinDateRange::operator()  ----- */
 
 
@@ -566,6 +686,195 @@ std::string CleanLabel (const std::string& label)
     return cleaned_label;
 }		// -----  end of function CleanLabel  -----
 
+namespace
+{
+    // the HTML 4 names, which cover what we see in filings, plus the HTML 5 names for
+    // ascii characters.  The legacy ones may be written without the ';'.
+
+    struct NamedEntity
+    {
+        EM::sv name_;
+        char32_t code_point_;
+        bool legacy_ = false;
+    };
+
+    const NamedEntity named_entities[]
+    {
+        {"Tab", 0x0009}, {"NewLine", 0x000A}, {"excl", 0x0021}, {"QUOT", 0x0022, true}, {"quot", 0x0022, true},
+        {"num", 0x0023}, {"dollar", 0x0024}, {"percnt", 0x0025}, {"AMP", 0x0026, true}, {"amp", 0x0026, true},
+        {"apos", 0x0027}, {"lpar", 0x0028}, {"rpar", 0x0029}, {"ast", 0x002A}, {"midast", 0x002A},
+        {"plus", 0x002B}, {"comma", 0x002C}, {"period", 0x002E}, {"sol", 0x002F}, {"colon", 0x003A},
+        {"semi", 0x003B}, {"LT", 0x003C, true}, {"lt", 0x003C, true}, {"equals", 0x003D}, {"GT", 0x003E, true},
+        {"gt", 0x003E, true}, {"quest", 0x003F}, {"commat", 0x0040}, {"lbrack", 0x005B}, {"lsqb", 0x005B},
+        {"bsol", 0x005C}, {"rbrack", 0x005D}, {"rsqb", 0x005D}, {"Hat", 0x005E}, {"UnderBar", 0x005F},
+        {"lowbar", 0x005F}, {"DiacriticalGrave", 0x0060}, {"grave", 0x0060}, {"lbrace", 0x007B},
+        {"lcub", 0x007B}, {"VerticalLine", 0x007C}, {"verbar", 0x007C}, {"vert", 0x007C}, {"rbrace", 0x007D},
+        {"rcub", 0x007D}, {"nbsp", 0x00A0, true}, {"iexcl", 0x00A1, true}, {"cent", 0x00A2, true},
+        {"pound", 0x00A3, true}, {"curren", 0x00A4, true}, {"yen", 0x00A5, true}, {"brvbar", 0x00A6, true},
+        {"sect", 0x00A7, true}, {"uml", 0x00A8, true}, {"COPY", 0x00A9, true}, {"copy", 0x00A9, true},
+        {"ordf", 0x00AA, true}, {"laquo", 0x00AB, true}, {"not", 0x00AC, true}, {"shy", 0x00AD, true},
+        {"REG", 0x00AE, true}, {"reg", 0x00AE, true}, {"macr", 0x00AF, true}, {"deg", 0x00B0, true},
+        {"plusmn", 0x00B1, true}, {"sup2", 0x00B2, true}, {"sup3", 0x00B3, true}, {"acute", 0x00B4, true},
+        {"micro", 0x00B5, true}, {"para", 0x00B6, true}, {"middot", 0x00B7, true}, {"cedil", 0x00B8, true},
+        {"sup1", 0x00B9, true}, {"ordm", 0x00BA, true}, {"raquo", 0x00BB, true}, {"frac14", 0x00BC, true},
+        {"frac12", 0x00BD, true}, {"frac34", 0x00BE, true}, {"iquest", 0x00BF, true}, {"Agrave", 0x00C0, true},
+        {"Aacute", 0x00C1, true}, {"Acirc", 0x00C2, true}, {"Atilde", 0x00C3, true}, {"Auml", 0x00C4, true},
+        {"Aring", 0x00C5, true}, {"AElig", 0x00C6, true}, {"Ccedil", 0x00C7, true}, {"Egrave", 0x00C8, true},
+        {"Eacute", 0x00C9, true}, {"Ecirc", 0x00CA, true}, {"Euml", 0x00CB, true}, {"Igrave", 0x00CC, true},
+        {"Iacute", 0x00CD, true}, {"Icirc", 0x00CE, true}, {"Iuml", 0x00CF, true}, {"ETH", 0x00D0, true},
+        {"Ntilde", 0x00D1, true}, {"Ograve", 0x00D2, true}, {"Oacute", 0x00D3, true}, {"Ocirc", 0x00D4, true},
+        {"Otilde", 0x00D5, true}, {"Ouml", 0x00D6, true}, {"times", 0x00D7, true}, {"Oslash", 0x00D8, true},
+        {"Ugrave", 0x00D9, true}, {"Uacute", 0x00DA, true}, {"Ucirc", 0x00DB, true}, {"Uuml", 0x00DC, true},
+        {"Yacute", 0x00DD, true}, {"THORN", 0x00DE, true}, {"szlig", 0x00DF, true}, {"agrave", 0x00E0, true},
+        {"aacute", 0x00E1, true}, {"acirc", 0x00E2, true}, {"atilde", 0x00E3, true}, {"auml", 0x00E4, true},
+        {"aring", 0x00E5, true}, {"aelig", 0x00E6, true}, {"ccedil", 0x00E7, true}, {"egrave", 0x00E8, true},
+        {"eacute", 0x00E9, true}, {"ecirc", 0x00EA, true}, {"euml", 0x00EB, true}, {"igrave", 0x00EC, true},
+        {"iacute", 0x00ED, true}, {"icirc", 0x00EE, true}, {"iuml", 0x00EF, true}, {"eth", 0x00F0, true},
+        {"ntilde", 0x00F1, true}, {"ograve", 0x00F2, true}, {"oacute", 0x00F3, true}, {"ocirc", 0x00F4, true},
+        {"otilde", 0x00F5, true}, {"ouml", 0x00F6, true}, {"divide", 0x00F7, true}, {"oslash", 0x00F8, true},
+        {"ugrave", 0x00F9, true}, {"uacute", 0x00FA, true}, {"ucirc", 0x00FB, true}, {"uuml", 0x00FC, true},
+        {"yacute", 0x00FD, true}, {"thorn", 0x00FE, true}, {"yuml", 0x00FF, true}, {"OElig", 0x0152},
+        {"oelig", 0x0153}, {"Scaron", 0x0160}, {"scaron", 0x0161}, {"Yuml", 0x0178}, {"fnof", 0x0192},
+        {"circ", 0x02C6}, {"tilde", 0x02DC}, {"Alpha", 0x0391}, {"Beta", 0x0392}, {"Gamma", 0x0393},
+        {"Delta", 0x0394}, {"Epsilon", 0x0395}, {"Zeta", 0x0396}, {"Eta", 0x0397}, {"Theta", 0x0398},
+        {"Iota", 0x0399}, {"Kappa", 0x039A}, {"Lambda", 0x039B}, {"Mu", 0x039C}, {"Nu", 0x039D}, {"Xi", 0x039E},
+        {"Omicron", 0x039F}, {"Pi", 0x03A0}, {"Rho", 0x03A1}, {"Sigma", 0x03A3}, {"Tau", 0x03A4},
+        {"Upsilon", 0x03A5}, {"Phi", 0x03A6}, {"Chi", 0x03A7}, {"Psi", 0x03A8}, {"Omega", 0x03A9},
+        {"alpha", 0x03B1}, {"beta", 0x03B2}, {"gamma", 0x03B3}, {"delta", 0x03B4}, {"epsilon", 0x03B5},
+        {"zeta", 0x03B6}, {"eta", 0x03B7}, {"theta", 0x03B8}, {"iota", 0x03B9}, {"kappa", 0x03BA},
+        {"lambda", 0x03BB}, {"mu", 0x03BC}, {"nu", 0x03BD}, {"xi", 0x03BE}, {"omicron", 0x03BF}, {"pi", 0x03C0},
+        {"rho", 0x03C1}, {"sigmaf", 0x03C2}, {"sigma", 0x03C3}, {"tau", 0x03C4}, {"upsilon", 0x03C5},
+        {"phi", 0x03C6}, {"chi", 0x03C7}, {"psi", 0x03C8}, {"omega", 0x03C9}, {"thetasym", 0x03D1},
+        {"upsih", 0x03D2}, {"piv", 0x03D6}, {"ensp", 0x2002}, {"emsp", 0x2003}, {"thinsp", 0x2009},
+        {"zwnj", 0x200C}, {"zwj", 0x200D}, {"lrm", 0x200E}, {"rlm", 0x200F}, {"ndash", 0x2013},
+        {"mdash", 0x2014}, {"lsquo", 0x2018}, {"rsquo", 0x2019}, {"sbquo", 0x201A}, {"ldquo", 0x201C},
+        {"rdquo", 0x201D}, {"bdquo", 0x201E}, {"dagger", 0x2020}, {"Dagger", 0x2021}, {"bull", 0x2022},
+        {"hellip", 0x2026}, {"permil", 0x2030}, {"prime", 0x2032}, {"Prime", 0x2033}, {"lsaquo", 0x2039},
+        {"rsaquo", 0x203A}, {"oline", 0x203E}, {"frasl", 0x2044}, {"euro", 0x20AC}, {"image", 0x2111},
+        {"weierp", 0x2118}, {"real", 0x211C}, {"trade", 0x2122}, {"alefsym", 0x2135}, {"larr", 0x2190},
+        {"uarr", 0x2191}, {"rarr", 0x2192}, {"darr", 0x2193}, {"harr", 0x2194}, {"crarr", 0x21B5},
+        {"lArr", 0x21D0}, {"uArr", 0x21D1}, {"rArr", 0x21D2}, {"dArr", 0x21D3}, {"hArr", 0x21D4},
+        {"forall", 0x2200}, {"part", 0x2202}, {"exist", 0x2203}, {"empty", 0x2205}, {"nabla", 0x2207},
+        {"isin", 0x2208}, {"notin", 0x2209}, {"ni", 0x220B}, {"prod", 0x220F}, {"sum", 0x2211},
+        {"minus", 0x2212}, {"lowast", 0x2217}, {"radic", 0x221A}, {"prop", 0x221D}, {"infin", 0x221E},
+        {"ang", 0x2220}, {"and", 0x2227}, {"or", 0x2228}, {"cap", 0x2229}, {"cup", 0x222A}, {"int", 0x222B},
+        {"there4", 0x2234}, {"sim", 0x223C}, {"cong", 0x2245}, {"asymp", 0x2248}, {"ne", 0x2260},
+        {"equiv", 0x2261}, {"le", 0x2264}, {"ge", 0x2265}, {"sub", 0x2282}, {"sup", 0x2283}, {"nsub", 0x2284},
+        {"sube", 0x2286}, {"supe", 0x2287}, {"oplus", 0x2295}, {"otimes", 0x2297}, {"perp", 0x22A5},
+        {"sdot", 0x22C5}, {"lceil", 0x2308}, {"rceil", 0x2309}, {"lfloor", 0x230A}, {"rfloor", 0x230B},
+        {"loz", 0x25CA}, {"spades", 0x2660}, {"clubs", 0x2663}, {"hearts", 0x2665}, {"diams", 0x2666},
+        {"lang", 0x27E8}, {"rang", 0x27E9}
+    };
+
+    // the longest legacy name is 6 characters.
+
+    constexpr std::size_t max_legacy_name_size = 6;
+
+    const NamedEntity* FindNamedEntity(EM::sv name)
+    {
+        static const std::unordered_map<EM::sv, const NamedEntity*> entities_by_name = []
+            {
+                std::unordered_map<EM::sv, const NamedEntity*> result;
+                for (const auto& entity : named_entities)
+                {
+                    result.emplace(entity.name_, &entity);
+                }
+                return result;
+            }();
+
+        auto found = entities_by_name.find(name);
+        return found == entities_by_name.end() ? nullptr : found->second;
+    }
+
+    const char32_t windows_1252[32]
+    {
+        0x20AC, 0x0081, 0x201A, 0x0192, 0x201E, 0x2026, 0x2020, 0x2021, 0x02C6, 0x2030, 0x0160, 0x2039, 0x0152, 0x008D, 0x017D, 0x008F,
+        0x0090, 0x2018, 0x2019, 0x201C, 0x201D, 0x2022, 0x2013, 0x2014, 0x02DC, 0x2122, 0x0161, 0x203A, 0x0153, 0x009D, 0x017E, 0x0178
+    };
+
+    constexpr char32_t replacement_character = 0xFFFD;
+}
+
+char32_t DecodeHTMLEntity (EM::sv text, std::size_t& pos, bool in_attribute)
+{
+    const auto start = pos + 1;
+
+    if (start < text.size() && text[start] == '#')
+    {
+        const bool hex = start + 1 < text.size() && (text[start + 1] == 'x' || text[start + 1] == 'X');
+        const auto digits_begin = start + (hex ? 2 : 1);
+        auto digits_end = digits_begin;
+        char32_t code_point{0};
+        for (; digits_end < text.size(); ++digits_end)
+        {
+            auto c = static_cast<unsigned char>(text[digits_end]);
+            if (! (hex ? std::isxdigit(c) : std::isdigit(c)))
+            {
+                break;
+            }
+            char32_t digit = std::isdigit(c) ? c - '0' : std::tolower(c) - 'a' + 10;
+            code_point = std::min<char32_t>(code_point * (hex ? 16 : 10) + digit, 0x110000);
+        }
+        if (digits_end == digits_begin)
+        {
+            ++pos;
+            return '&';
+        }
+        pos = digits_end < text.size() && text[digits_end] == ';' ? digits_end + 1 : digits_end;
+
+        if (code_point == 0 || code_point > 0x10FFFF || (code_point >= 0xD800 && code_point <= 0xDFFF))
+        {
+            return replacement_character;
+        }
+        if (code_point >= 0x80 && code_point <= 0x9F)
+        {
+            return windows_1252[code_point - 0x80];
+        }
+        return code_point;
+    }
+
+    auto name_end = start;
+    while (name_end < text.size() && std::isalnum(static_cast<unsigned char>(text[name_end])) && name_end - start < 32)
+    {
+        ++name_end;
+    }
+    EM::sv name = text.substr(start, name_end - start);
+    if (name.empty())
+    {
+        ++pos;
+        return '&';
+    }
+    if (name_end < text.size() && text[name_end] == ';')
+    {
+        if (const auto* entity = FindNamedEntity(name); entity != nullptr)
+        {
+            pos = name_end + 1;
+            return entity->code_point_;
+        }
+    }
+
+    // the longest legacy name the text starts with.
+
+    for (auto size = std::min(name.size(), max_legacy_name_size); size > 1; --size)
+    {
+        const auto* entity = FindNamedEntity(name.substr(0, size));
+        if (entity == nullptr || ! entity->legacy_)
+        {
+            continue;
+        }
+        const auto entity_end = start + size;
+        if (in_attribute && entity_end < text.size() && (std::isalnum(static_cast<unsigned char>(text[entity_end])) || text[entity_end] == '='))
+        {
+            break;
+        }
+        pos = entity_end;
+        return entity->code_point_;
+    }
+
+    ++pos;
+    return '&';
+}		/* -----  end of function DecodeHTMLEntity  ----- */
+
 
 namespace boost
 {
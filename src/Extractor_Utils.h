@@ -36,6 +36,8 @@
 #ifndef  _EXTRACTOR_UTILS_INC_
 #define  _EXTRACTOR_UTILS_INC_
 
+#include <algorithm>
+#include <cctype>
 #include <chrono>
 #include <ctime>
 #include <exception>
@@ -60,6 +62,11 @@
 
 #include "Extractor.h"
 
+class DBConnectionPool;
+class FilingIdIndex;
+struct SEC_HeaderRecord;
+enum class CopyFormat;
+
 namespace fs = std::filesystem;
 
 using namespace std::string_literals;
@@ -270,6 +277,19 @@ inline std::vector<T> split_string(EM::sv string_data, char delim)
     return results;
 }
 
+// for scanning text a character at a time.
+
+inline constexpr auto npos = EM::sv::npos;
+
+// 'lower_case_word' is at 'pos', ignoring case.
+
+inline bool WordAt(EM::sv text, std::size_t pos, EM::sv lower_case_word)
+{
+    return pos <= text.size() && text.size() - pos >= lower_case_word.size()
+        && std::equal(lower_case_word.begin(), lower_case_word.end(), text.begin() + pos,
+            [] (char lhs, unsigned char rhs) { return lhs == std::tolower(rhs); });
+}
+
 // utility function
 
 template<typename ...Ts>
@@ -287,37 +307,41 @@ auto AllNotEmpty(const Ts& ...ts)
 // a little helper to run our filters.
 
 template<typename... Ts>
-auto ApplyFilters(const EM::SEC_Header_fields& SEC_fields, const EM::DocumentSectionList& sections, Ts ...ts)
+auto ApplyFilters(const SEC_HeaderRecord& SEC_record, const EM::DocumentSectionList& sections, Ts ...ts)
 {
     // unary left fold
 
-	return (... && (ts(SEC_fields, sections)));
+	return (... && (ts(SEC_record, sections)));
 }
 
 bool FormIsInFileName(const std::vector<std::string>& form_types, const EM::FileName& file_name);
 
 EM::DocumentSectionList LocateDocumentSections(EM::FileContent file_content);
 
-EM::FileName FindFileName(const EM::DocumentSection& document, const EM::FileName& document_name);
+EM::HTMLContent FindHTML(const EM::DocumentSectionData& document);
 
-EM::FileType FindFileType(const EM::DocumentSection& document);
+std::string CleanLabel (const std::string& label);
 
-EM::HTMLContent FindHTML(const EM::DocumentSection& document, const EM::FileName& document_name);
+// decodes the HTML character reference whose '&' is at 'pos' and moves 'pos' past it.
+// If there's no reference there, we return the '&' and move past just it.  As an HTML
+// parser does, we read 0x80 - 0x9f as windows-1252 and give U+FFFD for 0, surrogates
+// and anything out of range.  Names we don't know are left as text.
+// In an attribute value, '&copy=' and the like aren't references.
 
-std::string CleanLabel (const std::string& label);
+char32_t DecodeHTMLEntity(EM::sv text, std::size_t& pos, bool in_attribute = false);
 
 // let's use some function objects for our filters.
 
 struct FileHasXBRL
 {
-    bool operator()(const EM::SEC_Header_fields&, const EM::DocumentSectionList& document_sections) const ;
+    bool operator()(const SEC_HeaderRecord&, const EM::DocumentSectionList& document_sections) const ;
 
     const std::string filter_name_{"FileHasXBRL"};
 };
 
 struct FileHasXLS
 {
-    bool operator()(const EM::SEC_Header_fields&, const EM::DocumentSectionList& document_sections) const ;
+    bool operator()(const SEC_HeaderRecord&, const EM::DocumentSectionList& document_sections) const ;
 
     const std::string filter_name_{"FileHasXLS"};
 };
@@ -327,7 +351,7 @@ struct FileHasHTML
     explicit FileHasHTML(const std::vector<std::string>& form_list)
         : form_list_{form_list} {}
 
-    bool operator()(const EM::SEC_Header_fields&, const EM::DocumentSectionList& document_sections) const ;
+    bool operator()(const SEC_HeaderRecord&, const EM::DocumentSectionList& document_sections) const ;
 
     const std::string filter_name_{"FileHasHTML"};
 
@@ -339,7 +363,7 @@ struct FileHasFormType
     explicit FileHasFormType(const std::vector<std::string>& form_list)
         : form_list_{form_list} {}
 
-    bool operator()(const EM::SEC_Header_fields& SEC_fields, const EM::DocumentSectionList& document_sections) const ;
+    bool operator()(const SEC_HeaderRecord& SEC_record, const EM::DocumentSectionList& document_sections) const ;
 
     const std::string filter_name_{"FileHasFormType"};
 
@@ -351,7 +375,7 @@ struct FileHasCIK
     explicit FileHasCIK(const std::vector<std::string>& CIK_list)
         : CIK_list_{CIK_list} {}
 
-    bool operator()(const EM::SEC_Header_fields& SEC_fields, const EM::DocumentSectionList& document_sections) const ;
+    bool operator()(const SEC_HeaderRecord& SEC_record, const EM::DocumentSectionList& document_sections) const ;
 
     const std::string filter_name_{"FileHasCIK"};
 
@@ -363,7 +387,7 @@ struct FileHasSIC
     explicit FileHasSIC(const std::vector<std::string>& SIC_list)
         : SIC_list_{SIC_list} {}
 
-    bool operator()(const EM::SEC_Header_fields& SEC_fields, const EM::DocumentSectionList& document_sections) const ;
+    bool operator()(const SEC_HeaderRecord& SEC_record, const EM::DocumentSectionList& document_sections) const ;
 
     const std::string filter_name_{"FileHasSIC"};
 
@@ -372,14 +396,14 @@ struct FileHasSIC
 
 struct NeedToUpdateDBContent
 {
-    NeedToUpdateDBContent(const std::string& schema_prefix, const std::string& mode, bool replace_DB_content)
-        : schema_prefix_{schema_prefix}, mode_{mode}, replace_DB_content_{replace_DB_content}{}
+    NeedToUpdateDBContent(const FilingIdIndex* filing_index, const std::string& mode, bool replace_DB_content)
+        : filing_index_{filing_index}, mode_{mode}, replace_DB_content_{replace_DB_content}{}
 
-    bool operator()(const EM::SEC_Header_fields& SEC_fields, const EM::DocumentSectionList& document_sections) const ;
+    bool operator()(const SEC_HeaderRecord& SEC_record, const EM::DocumentSectionList& document_sections) const ;
 
     const std::string filter_name_{"NeedToUpdateDBContent"};
 
-    const std::string schema_prefix_;
+    const FilingIdIndex* filing_index_;
     const std::string mode_;
     bool replace_DB_content_;
 };
@@ -389,7 +413,7 @@ struct FileIsWithinDateRange
     FileIsWithinDateRange(const date::year_month_day& begin_date, const date::year_month_day& end_date)
         : begin_date_{begin_date}, end_date_{end_date}   {}
 
-    bool operator()(const EM::SEC_Header_fields& SEC_fields, const EM::DocumentSectionList& document_sections) const ;
+    bool operator()(const SEC_HeaderRecord& SEC_record, const EM::DocumentSectionList& document_sections) const ;
 
     const std::string filter_name_{"FileIsWithinDateRange"};
 
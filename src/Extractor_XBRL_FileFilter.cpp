@@ -36,12 +36,18 @@
 //  Description:  class which SEC files to extract data from.
 // =====================================================================================
 
+#include "DBConnectionPool.h"
+#include "DBCopyWriter.h"
 #include "Extractor_Utils.h"
 #include "Extractor_XBRL_FileFilter.h"
+#include "RegexRegistry.h"
 
 #include <algorithm>
+#include <array>
 #include <experimental/array>
 #include <iostream>
+#include <optional>
+#include <unordered_map>
 
 #include <range/v3/action/remove_if.hpp>
 #include <range/v3/action/transform.hpp>
@@ -64,7 +70,7 @@
 #include <boost/regex.hpp>
 
 #include "fmt/core.h"
-#include "pstreams/pstream.h"
+#include "fmt/format.h"
 #include "spdlog/spdlog.h"
 
 #include <pqxx/pqxx>
@@ -89,7 +95,6 @@ decltype(auto) MONTH_NAMES = std::experimental::make_array("", "January", "Febru
 
 const std::string::size_type START_WITH{1000000};
 
-const boost::regex regex_value{R"***(^([()"'A-Za-z ,.-]+)[^\t]*\t(?:\[[^\t]+?\]\t)?\$? *([(-]? *?[.,0-9]+[)]?)[^\t]*\t)***"};
 const boost::regex regex_per_share{R"***(per.*?share)***", boost::regex_constants::normal | boost::regex_constants::icase};
 const boost::regex regex_dollar_mults{R"***([(][^)]*?in (thousands|millions|billions|dollars).*?[)])***",
     boost::regex_constants::normal | boost::regex_constants::icase};
@@ -99,13 +104,9 @@ const boost::regex regex_dollar_mults{R"***([(][^)]*?in (thousands|millions|bill
 
 const std::string& FindOrDefault(const EM::Extractor_Labels& labels, const std::string& key, const std::string& default_result)
 {
-    if (labels.contains(key))
+    if (auto found = labels.find(key); found != labels.end() && ! found->second.empty())
     {
-        decltype(auto) val = labels.at(key);
-        if (! val.empty())
-        {
-            return labels.at(key);
-        }
+        return found->second;
     }
     return default_result;
 }
@@ -114,7 +115,7 @@ const std::string& FindOrDefault(const EM::Extractor_Labels& labels, const std::
 //         Name:  FindAndExtractXLSContent
 //  Description:  find needed XLS content 
 // =====================================================================================
-XLS_FinancialStatements FindAndExtractXLSContent(EM::DocumentSectionList const & document_sections, const EM::FileName& document_name)
+XLS_FinancialStatements FindAndExtractXLSContent(EM::DocumentSectionList const & document_sections)
 {
     static const boost::regex regex_finance_statements_bal {R"***(balance\s+sheet|financial position)***"};
     static const boost::regex regex_finance_statements_ops {R"***((?:(?:statement|statements)\s+?of.*?(?:oper|loss|income|earning|expense))|(?:income|loss|earning statement))***"};
@@ -122,33 +123,44 @@ XLS_FinancialStatements FindAndExtractXLSContent(EM::DocumentSectionList const &
 
     XLS_FinancialStatements financial_statements;
 
-    auto xls_content = LocateXLSDocument(document_sections, document_name);
+    auto xls_content = LocateXLSDocument(document_sections);
     auto xls_data = ExtractXLSData(xls_content);
 
     XLS_File xls_file{std::move(xls_data)};
 
     financial_statements.outstanding_shares_ = ExtractXLSSharesOutstanding(*xls_file.begin());
 
+    // one pass over the sheets. Each sheet is checked against every statement
+    // we haven't found yet and the first match for each wins, same as searching
+    // for each one separately.  We quit reading sheets once we have them all.
 
-    auto bal_sheets = ranges::find_if(xls_file, [] (const auto& x) { const auto& name = x.GetSheetNameFromInside(); return boost::regex_search(name, regex_finance_statements_bal); } );
-    if (bal_sheets != ranges::end(xls_file))
+    struct StatementRule
     {
-        financial_statements.balance_sheet_.found_sheet_ = true;
-        financial_statements.balance_sheet_.values_ = CollectXLSValues(*bal_sheets);
-    }
-
-    auto stmt_of_ops = ranges::find_if(xls_file, [] (const auto& x) { const auto& name = x.GetSheetNameFromInside(); return boost::regex_search(name, regex_finance_statements_ops); } );
-    if (stmt_of_ops != ranges::end(xls_file))
+        const boost::regex& pattern_;
+        bool& found_sheet_;
+        EM::XLS_Values& values_;
+    };
+
+    std::array<StatementRule, 3> rules{{
+        {regex_finance_statements_bal, financial_statements.balance_sheet_.found_sheet_, financial_statements.balance_sheet_.values_},
+        {regex_finance_statements_ops, financial_statements.statement_of_operations_.found_sheet_,
+            financial_statements.statement_of_operations_.values_},
+        {regex_finance_statements_cash, financial_statements.cash_flows_.found_sheet_, financial_statements.cash_flows_.values_}
+    }};
+
+    auto statements_to_find = rules.size();
+    for (auto sheet = ranges::begin(xls_file); sheet != ranges::end(xls_file) && statements_to_find > 0; ++sheet)
     {
-        financial_statements.statement_of_operations_.found_sheet_ = true;
-        financial_statements.statement_of_operations_.values_ = CollectXLSValues(*stmt_of_ops);
-    }
-
-    auto cash_flows = ranges::find_if(xls_file, [] (const auto& x) { const auto& name = x.GetSheetNameFromInside(); return boost::regex_search(name, regex_finance_statements_cash); } );
-    if (cash_flows != ranges::end(xls_file))
-    {
-        financial_statements.cash_flows_.found_sheet_ = true;
-        financial_statements.cash_flows_.values_ = CollectXLSValues(*cash_flows);
+        const auto& name = sheet->GetSheetNameFromInside();
+        for (auto& rule : rules)
+        {
+            if (! rule.found_sheet_ && boost::regex_search(name, rule.pattern_))
+            {
+                rule.found_sheet_ = true;
+                rule.values_ = CollectXLSValues(*sheet);
+                --statements_to_find;
+            }
+        }
     }
 
     return financial_statements;
@@ -175,9 +187,7 @@ EM::XLS_Values ExtractXLSFilingData(const XLS_Sheet& sheet)
 // =====================================================================================
 int64_t ExtractXLSSharesOutstanding (const XLS_Sheet& xls_sheet)
 {
-    const std::string nbr_of_shares = R"***(\t(\b[1-9](?:[0-9.]{2,})\b)\t)***";
-    const boost::regex::flag_type my_flags = {boost::regex_constants::normal | boost::regex_constants::icase};
-    const boost::regex regex_share_extractor{nbr_of_shares, my_flags};
+    const auto& regex_share_extractor = RegexRegistry::Get(RegexId::e_XLSSharesOutstanding);
 
     std::string shares = "-1";
 
@@ -203,7 +213,7 @@ int64_t ExtractXLSSharesOutstanding (const XLS_Sheet& xls_sheet)
         }
         boost::smatch the_shares;
 
-        if (bool found_it = boost::regex_search(row, the_shares, regex_share_extractor); found_it)
+        if (bool found_it = regex_share_extractor.Search(row.cbegin(), row.cend(), the_shares); found_it)
         {
            shares = the_shares.str(1); 
         }
@@ -253,41 +263,117 @@ int64_t ExtractXLSSharesOutstanding (const XLS_Sheet& xls_sheet)
     return shares_outstanding;
 }		// -----  end of function ExtractXLSSharesOutstanding  -----
 
+// ===  FUNCTION  ======================================================================
+//         Name:  FindXLSLabelAndValue
+//  Description:  a row we want starts with a label cell followed by a value cell,
+//                possibly with a footnote cell like '[1]' in between.  The value
+//                can have a leading '$' and be negative as '-123' or '(123)'.
+//
+//                These are the rules we used to apply with a regex to the tab
+//                delimited row but we can just look at the cells.
+// =====================================================================================
+std::optional<EM::XLS_Entry> FindXLSLabelAndValue (const XLS_Row& row)
+{
+    const EM::sv label_chars{R"***(()"'ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz ,.-)***"};
+    const EM::sv value_chars{".,0123456789"};
+
+    EM::sv label = row[0];
+    label = label.substr(0, label.find_first_not_of(label_chars));
+    if (label.empty())
+    {
+        return std::nullopt;
+    }
+
+    std::size_t value_column = 1;
+    if (EM::sv note = row[value_column]; note.size() > 2 && note.front() == '[' && note.back() == ']')
+    {
+        ++value_column;
+    }
+    if (value_column >= row.size())
+    {
+        return std::nullopt;
+    }
+
+    EM::sv value = row[value_column];
+    std::size_t pos = 0;
+    if (pos < value.size() && value[pos] == '$')
+    {
+        ++pos;
+    }
+    while (pos < value.size() && value[pos] == ' ')
+    {
+        ++pos;
+    }
+    const auto value_begin = pos;
+    if (pos < value.size() && (value[pos] == '(' || value[pos] == '-'))
+    {
+        ++pos;
+        while (pos < value.size() && value[pos] == ' ')
+        {
+            ++pos;
+        }
+    }
+    const auto digits_begin = pos;
+    while (pos < value.size() && value_chars.find(value[pos]) != EM::sv::npos)
+    {
+        ++pos;
+    }
+    if (pos == digits_begin)
+    {
+        return std::nullopt;
+    }
+    if (pos < value.size() && value[pos] == ')')
+    {
+        ++pos;
+    }
+    value = value.substr(value_begin, pos - value_begin);
+
+    // we need to check that the value actually contains at least 1 digit.
+
+    if (value.find_first_of("0123456789") == EM::sv::npos)
+    {
+        return std::nullopt;
+    }
+    return EM::XLS_Entry{EM::XLS_Label{std::string{label}}, EM::XLS_Value{std::string{value}}};
+}		// -----  end of function FindXLSLabelAndValue  -----
+
 EM::XLS_Values CollectXLSValues (const XLS_Sheet& sheet)
 {
     // for now, we're doing just a quick and dirty...
     // look for a label followed by a number in the same line
-    //
-    // NOTE the use of 'cache1' below.  This is ** REQUIRED ** to get correct behavior.  without it,
-    // some items are dropped, some are duplicated.
 
     // our multiplier is in the first or second row of the sheet.
 
     auto row_itor = sheet.begin();
+    int rows_checked = 1;
     int multiplier_skips = 1;
     auto multiplier = ExtractMultiplier(*row_itor);
     if (multiplier.first.empty())
     {
         multiplier = ExtractMultiplier(*(++row_itor));
+        ++rows_checked;
         if (! multiplier.first.empty())
         {
             multiplier_skips = 2;
         }
     }
 
-    boost::smatch match_values;
+    // move to the first row after the sheet name and multiplier.
 
-    const std::string digits{"0123456789"};
+    if (rows_checked == multiplier_skips)
+    {
+        ++row_itor;
+    }
 
-    // if we find a label/value pair, we need to check that the value actually contains at least 1 digit.
+    EM::XLS_Values values;
 
-    EM::XLS_Values values = sheet 
-        | ranges::views::drop(multiplier_skips)                // first row contains sheet name and multiplier
-        | ranges::views::filter([&match_values, &digits](const auto& a_row)
-                { return boost::regex_search(a_row.cbegin(), a_row.cend(), match_values, regex_value) && ranges::any_of(match_values[2].str(), [&digits] (char c) { return digits.find(c) != std::string::npos; }); })
-        | ranges::views::transform([&match_values](const auto& x) { return std::pair(match_values[1].str(), match_values[2].str()); } )
-        | ranges::views::cache1
-        | ranges::to<EM::XLS_Values>();
+    for (; row_itor != sheet.end(); ++row_itor)
+    {
+        if (auto label_and_value = FindXLSLabelAndValue(row_itor.GetRow()); label_and_value)
+        {
+            values.push_back(std::move(label_and_value.value()));
+        }
+    }
 
     // now, for all values except 'per share', apply the multiplier.
 
@@ -381,13 +467,11 @@ std::pair<std::string, int64_t> ExtractMultiplier (std::string row)
     return {"", 1};
 }		// -----  end of function ExtractMultiplier  -----
 
-EM::XBRLContent LocateInstanceDocument(const EM::DocumentSectionList& document_sections, const EM::FileName& document_name)
+EM::XBRLContent LocateInstanceDocument(const EM::DocumentSectionList& document_sections)
 {
     for (const auto& document : document_sections)
     {
-        auto file_name = FindFileName(document, document_name);
-        auto file_type = FindFileType(document);
-        if (file_type.get().ends_with(".INS") && file_name.get().extension() == ".xml")
+        if (document.file_type_.get().ends_with(".INS") && document.extension_ == ".xml")
         {
             return TrimExcessXML(document);
         }
@@ -395,13 +479,11 @@ EM::XBRLContent LocateInstanceDocument(const EM::DocumentSectionList& document_s
     return EM::XBRLContent{};
 }
 
-EM::XBRLContent LocateLabelDocument(const EM::DocumentSectionList& document_sections, const EM::FileName& document_name)
+EM::XBRLContent LocateLabelDocument(const EM::DocumentSectionList& document_sections)
 {
     for (const auto& document : document_sections)
     {
-        auto file_name = FindFileName(document, document_name);
-        auto file_type = FindFileType(document);
-        if (file_type.get().ends_with(".LAB") && file_name.get().extension() == ".xml")
+        if (document.file_type_.get().ends_with(".LAB") && document.extension_ == ".xml")
         {
             return TrimExcessXML(document);
         }
@@ -413,35 +495,19 @@ EM::XBRLContent LocateLabelDocument(const EM::DocumentSectionList& document_sect
 //         Name:  LocateXLSDocument
 //  Description:  find FinancialReport document if it exists
 // =====================================================================================
-EM::XLSContent LocateXLSDocument (const EM::DocumentSectionList& document_sections, const EM::FileName& document_name)
+EM::XLSContent LocateXLSDocument (const EM::DocumentSectionList& document_sections)
 {
     for (const auto& document : document_sections)
     {
-        auto file_name = FindFileName(document, document_name);
-        if (file_name.get().extension() == ".xlsx")
+        if (document.extension_ == ".xlsx")
         {
-            auto doc = document.get();
-
-            // now, we just need to drop the extraneous XML surrounding the data we need.
-            // which is a little different from what we do for the other document types.
-
-            auto x = doc.find(R"***(<TEXT>)***");
-            // skip 1 more lines.
-
-            x = doc.find('\n', x + 1);
-
-            doc.remove_prefix(x);
+            // the document splitter has already dropped the extraneous XML surrounding the data we need.
 
-            auto ss_end_loc = doc.rfind(R"***(</TEXT>)***");
-            if (ss_end_loc != EM::sv::npos)
-            {
-                doc.remove_suffix(doc.length() - ss_end_loc);
-            }
-            else
+            if (document.text_.empty())
             {
                 throw std::runtime_error("Can't find end of spread sheet in document.\n");
             }
-            return EM::XLSContent{doc};
+            return EM::XLSContent{document.text_};
         }
     }
     return {};
@@ -471,99 +537,107 @@ EM::FilingData ExtractFilingData(const pugi::xml_document& instance_xml)
 // =====================================================================================
 std::vector<char> ExtractXLSData (EM::XLSContent xls_content)
 {
-	// we write our XLS file to the std::in of the decoder
-    // and read the decoder's std::out into a charater vector.
-    // No temp files involved.
+    // we decode in place instead of piping everything through
+    // a 'uudecode' subprocess.
 
-	redi::pstream out_in("uudecode -o /dev/stdout ", redi::pstreams::pstdin|redi::pstreams::pstdout|redi::pstreams::pstderr);
-    BOOST_ASSERT_MSG(out_in.is_open(), "Failed to open subprocess.");
+    // each character carries 6 bits. Lenient like uudecode: '`' is the same
+    // as a space and anything else just gets masked.
 
-    // we use a buffer and the readsome function so that we will get any
-    // embedded return characters (which would be stripped off if we did
-    // readline.
+    static constexpr auto uu_values = [] ()
+        {
+            std::array<uint8_t, 256> values{};
+            for (int c = 0; c < 256; ++c)
+            {
+                values[c] = (c - ' ') & 0x3F;
+            }
+            return values;
+        }();
 
-    std::array<char, 4096> buf{'\0'};
-    std::streamsize bytes_read;
+    EM::sv encoded = xls_content.get();
 
-	std::vector<char> result;
-    std::string error_msg;
+    auto next_line([&encoded] ()
+        {
+            auto line_end = encoded.find('\n');
+            EM::sv line = encoded.substr(0, line_end);
+            encoded.remove_prefix(line_end == EM::sv::npos ? encoded.size() : line_end + 1);
+            if (! line.empty() && line.back() == '\r')
+            {
+                line.remove_suffix(1);
+            }
+            return line;
+        });
 
-    // it seems it's possible to have uuencoded data with 'short' lines
-    // so, we need to be sure each line is 61 bytes long.
+    bool found_begin{false};
+    while (! encoded.empty())
+    {
+        if (next_line().starts_with("begin "))
+        {
+            found_begin = true;
+            break;
+        }
+    }
+    BOOST_ASSERT_MSG(found_begin, "Problem decoding file: no 'begin' line.");
 
-    auto lines = split_string<EM::sv>(xls_content.get(), '\n');
-    for (auto line : lines)
+    // every 4 characters we are given become 3 bytes. A line can claim more
+    // bytes than it holds so allow for growth anyway.
+
+    std::vector<char> result(encoded.size() / 4 * 3);
+    std::size_t bytes_decoded{0};
+    bool found_end{false};
+
+    while (! encoded.empty())
     {
-        out_in.write(line.data(), line.size());
+        auto line = next_line();
         if (line == "end")
         {
-            out_in.put('\n');
+            found_end = true;
             break;
         }
-        for (int i = line.size(); i < 61; ++i)
+        if (line.empty())
         {
-            out_in.put(' ');
+            continue;
         }
-        out_in.put('\n');
-
-        // for short files, we can write all the lines
-        // and then go read the conversion output.
-        // BUT for longer files, we may need to read
-        // output along the way to avoid deadlocks...
-        // write won't complete until conversion output
-        // is read.
-
-        do 
+        const std::size_t line_bytes = uu_values[static_cast<uint8_t>(line[0])];
+        if (line_bytes == 0)
         {
-            bytes_read = out_in.out().readsome(buf.data(), buf.max_size());
-            result.insert(result.end(), buf.data(), buf.data() + bytes_read);
-        } while (bytes_read != 0);
+            continue;
+        }
+        line.remove_prefix(1);
 
-        do
+        if (bytes_decoded + line_bytes + 2 > result.size())
         {
-            bytes_read = out_in.err().readsome(buf.data(), buf.max_size());
-            error_msg.append(buf.data(), bytes_read);
-        } while (bytes_read != 0);
-    }
-    //	write eod marker
+            result.resize(std::max(result.size() * 2, bytes_decoded + line_bytes + 2));
+        }
 
-    out_in << redi::peof;
+        // it seems it's possible to have uuencoded data with 'short' lines
+        // (trailing spaces dropped) so anything missing counts as a space.
 
-    bool finished[2] = {false, false};
+        const std::size_t groups = (line_bytes + 2) / 3;
+        auto* output = reinterpret_cast<uint8_t*>(result.data() + bytes_decoded);
 
-    while (! finished[0] || ! finished[1])
-    {
-        if (!finished[1])
-        {
-            while ((bytes_read = out_in.out().readsome(buf.data(), buf.max_size())) > 0)
-            {
-                result.insert(result.end(), buf.data(), buf.data() + bytes_read);
-            }
-            if (out_in.eof())
+        auto decode_group([output] (std::size_t group, uint8_t c0, uint8_t c1, uint8_t c2, uint8_t c3)
             {
-                finished[1] = true;
-                if (!finished[0])
-                    out_in.clear();
-            }
+                output[group * 3] = (c0 << 2) | (c1 >> 4);
+                output[group * 3 + 1] = (c1 << 4) | (c2 >> 2);
+                output[group * 3 + 2] = (c2 << 6) | c3;
+            });
+
+        const std::size_t full_groups = std::min(groups, line.size() / 4);
+        const auto* input = reinterpret_cast<const uint8_t*>(line.data());
+        for (std::size_t group = 0; group < full_groups; ++group, input += 4)
+        {
+            decode_group(group, uu_values[input[0]], uu_values[input[1]], uu_values[input[2]], uu_values[input[3]]);
         }
-        if (!finished[0])
+        for (std::size_t group = full_groups; group < groups; ++group)
         {
-            while ((bytes_read = out_in.err().readsome(buf.data(), buf.max_size())) > 0)
-            {
-                error_msg.append(buf.data(), bytes_read);
-            }
-            if (out_in.eof())
-            {
-                finished[0] = true;
-                if (!finished[1])
-                    out_in.clear();
-            }
+            auto value_at([&line] (std::size_t i) { return i < line.size() ? uu_values[static_cast<uint8_t>(line[i])] : uint8_t{0}; });
+            decode_group(group, value_at(group * 4), value_at(group * 4 + 1), value_at(group * 4 + 2), value_at(group * 4 + 3));
         }
+        bytes_decoded += line_bytes;
     }
+    BOOST_ASSERT_MSG(found_end, "Problem decoding file: no 'end' line.");
 
-    auto return_code = out_in.close();
-
-    BOOST_ASSERT_MSG(return_code == 0, catenate("Problem decoding file: ", error_msg).c_str());
+    result.resize(bytes_decoded);
     return result;
 }		// -----  end of function ExtractXLSData  -----
 
@@ -582,9 +656,10 @@ std::string ConvertPeriodEndDateToContextName(EM::sv period_end_date)
     return result;
 }
 
-std::vector<EM::GAAP_Data> ExtractGAAPFields(const pugi::xml_document& instance_xml)
+EM::GAAP_DataList ExtractGAAPFields(const pugi::xml_document& instance_xml, std::pmr::memory_resource* resource)
 {
-    std::vector<EM::GAAP_Data> result;
+    EM::GAAP_DataList result{resource};
+    std::string label{US_GAAP_PFX};
 
     auto top_level_node = instance_xml.first_child();           //  should be <xbrl> node.
 
@@ -609,13 +684,15 @@ std::vector<EM::GAAP_Data> ExtractGAAPFields(const pugi::xml_document& instance_
 
         // collect our data: name, context, units, decimals, value.
 
-        EM::GAAP_Data fields{US_GAAP_PFX + (second_level_node.name() + GAAP_LEN),
-            second_level_node.attribute("contextRef").value(), second_level_node.attribute("unitRef").value(),
-            second_level_node.attribute("decimals").value(), second_level_node.child_value()};
+        EM::sv units{second_level_node.attribute("unitRef").value()};
+        EM::sv value{second_level_node.child_value()};
 
-        if (! (fields.value.empty() || fields.units.empty()))
+        if (! (value.empty() || units.empty()))
         {
-            result.push_back(std::move(fields));
+            label.resize(GAAP_PFX_LEN);
+            label += second_level_node.name() + GAAP_LEN;
+            result.Add(label, second_level_node.attribute("contextRef").value(), units,
+                    second_level_node.attribute("decimals").value(), value);
         }
     }
 
@@ -643,7 +720,7 @@ std::vector<EM::GAAP_Data> ExtractGAAPFields(const pugi::xml_document& instance_
 //  - retrieve the element value.
 //
 
-EM::Extractor_Labels ExtractFieldLabels (const pugi::xml_document& labels_xml)
+EM::Extractor_Labels ExtractFieldLabels (const pugi::xml_document& labels_xml, const std::unordered_set<EM::sv>* wanted_names)
 {
     auto top_level_node = labels_xml.first_child();
 
@@ -673,10 +750,10 @@ EM::Extractor_Labels ExtractFieldLabels (const pugi::xml_document& labels_xml)
         labels = FindLabelElements(top_level_node, label_link_name, label_node_name.substr(namespace_prefix.size()));
     }
 
-    auto locs = FindLocElements(top_level_node, label_link_name, loc_node_name);
+    auto locs = FindLocElements(top_level_node, label_link_name, loc_node_name, wanted_names);
     if (locs.empty())
     {
-        locs = FindLocElements(top_level_node, label_link_name, loc_node_name.substr(namespace_prefix.size()));
+        locs = FindLocElements(top_level_node, label_link_name, loc_node_name.substr(namespace_prefix.size()), wanted_names);
     }
 
     auto arcs = FindLabelArcElements(top_level_node, label_link_name, arc_node_name);
@@ -690,10 +767,12 @@ EM::Extractor_Labels ExtractFieldLabels (const pugi::xml_document& labels_xml)
     return result;
 }		// -----  end of function ExtractFieldLabels2  -----
 
-std::vector<std::pair<EM::sv, EM::sv>> FindLabelElements (const pugi::xml_node& top_level_node,
+std::unordered_map<EM::sv, EM::sv> FindLabelElements (const pugi::xml_node& top_level_node,
         const std::string& label_link_name, const std::string& label_node_name)
 {
-    std::vector<std::pair<EM::sv, EM::sv>> labels;
+    // when a link name has more than 1 label, we use the first one.
+
+    std::unordered_map<EM::sv, EM::sv> labels;
 
     for (auto links : top_level_node.children(label_link_name.c_str()))
     {
@@ -704,17 +783,17 @@ std::vector<std::pair<EM::sv, EM::sv>> FindLabelElements (const pugi::xml_node&
             if (role.ends_with("abel"))
             {
                 EM::sv link_name{label_node.attribute("xlink:label").value()};
-                labels.emplace_back(link_name, label_node.child_value());
+                labels.try_emplace(link_name, label_node.child_value());
             }
         }
     }
     return labels;
 }		/* -----  end of function FindLabelElements  ----- */
 
-std::map<EM::sv, EM::sv> FindLocElements (const pugi::xml_node& top_level_node,
-        const std::string& label_link_name, const std::string& loc_node_name)
+std::unordered_map<EM::sv, EM::sv> FindLocElements (const pugi::xml_node& top_level_node,
+        const std::string& label_link_name, const std::string& loc_node_name, const std::unordered_set<EM::sv>* wanted_names)
 {
-    std::map<EM::sv, EM::sv> locs;
+    std::unordered_map<EM::sv, EM::sv> locs;
 
     for (auto links : top_level_node.children(label_link_name.c_str()))
     {
@@ -732,6 +811,10 @@ std::map<EM::sv, EM::sv> FindLocElements (const pugi::xml_node& top_level_node,
                 throw XBRLException("Can't find href label start.");
             }
             href.remove_prefix(pos + 1);
+            if (wanted_names != nullptr && ! wanted_names->contains(href))
+            {
+                continue;
+            }
             EM::sv link_name{loc_node.attribute("xlink:label").value()};
             locs[href] = link_name;
         }
@@ -739,10 +822,10 @@ std::map<EM::sv, EM::sv> FindLocElements (const pugi::xml_node& top_level_node,
     return locs;
 }		/* -----  end of function FindLocElements  ----- */
 
-std::map<EM::sv, EM::sv> FindLabelArcElements (const pugi::xml_node& top_level_node,
+std::unordered_map<EM::sv, EM::sv> FindLabelArcElements (const pugi::xml_node& top_level_node,
         const std::string& label_link_name, const std::string& arc_node_name)
 {
-    std::map<EM::sv, EM::sv> arcs;
+    std::unordered_map<EM::sv, EM::sv> arcs;
 
     for (auto links : top_level_node.children(label_link_name.c_str()))
     {
@@ -761,10 +844,13 @@ std::map<EM::sv, EM::sv> FindLabelArcElements (const pugi::xml_node& top_level_n
     return arcs;
 }		/* -----  end of function FindLabelArcElements  ----- */
 
-EM::Extractor_Labels AssembleLookupTable(const std::vector<std::pair<EM::sv, EM::sv>>& labels,
-        const std::map<EM::sv, EM::sv>& locs, const std::map<EM::sv, EM::sv>& arcs)
+EM::Extractor_Labels AssembleLookupTable(const std::unordered_map<EM::sv, EM::sv>& labels,
+        const std::unordered_map<EM::sv, EM::sv>& locs, const std::unordered_map<EM::sv, EM::sv>& arcs)
 {
+    // every step is a hash lookup so this is linear in the number of locs.
+
     EM::Extractor_Labels result;
+    result.reserve(locs.size());
 
     for (auto [href, label] : locs)
     {
@@ -774,8 +860,7 @@ EM::Extractor_Labels AssembleLookupTable(const std::vector<std::pair<EM::sv, EM:
             // stand-alone link
             continue;
         }
-        auto value = std::find_if(labels.begin(), labels.end(), [&link_to](const auto& e)
-                { return e.first == link_to->second; } );
+        auto value = labels.find(link_to->second);
         if (value == labels.end())
         {
             spdlog::debug(catenate("missing label: ", label).c_str());
@@ -858,9 +943,16 @@ EM::ContextPeriod ExtractContextDefinitions(const pugi::xml_document& instance_x
     return result;
 }
 
-EM::XBRLContent TrimExcessXML(EM::DocumentSection document)
+EM::XBRLContent TrimExcessXML(const EM::DocumentSectionData& document)
 {
-    auto doc_val = document.get();
+    if (! document.has_XBRL_)
+    {
+        throw XBRLException("Can't find XBLR in document.\n");
+    }
+
+    // the <XBRL> tag is right at the start of the text so this is a short search.
+
+    auto doc_val = document.text_;
     auto xbrl_loc = doc_val.find(R"***(<XBRL>)***");
     doc_val.remove_prefix(xbrl_loc + XBLR_TAG_LEN);
 
@@ -887,22 +979,176 @@ pugi::xml_document ParseXMLContent(EM::XBRLContent document)
 }
 
 
+// these are shared by our single filing and batch loaders.
+
+namespace
+{
+    // what goes into sec_filing_id besides the SEC header and XBRL filing data.
+
+    struct XBRL_FilingIdData
+    {
+        std::string original_date_filed_;
+        std::string original_file_name_;
+        std::string amended_date_filed_;
+        std::string amended_file_name_;
+        bool replace_existing_ = false;
+    };
+
+    // decide what to do based on what, if anything, is already in the DB.
+    // returns nothing if we should not load this filing.
+
+    std::optional<XBRL_FilingIdData> DecideXBRLFilingIdData(const EM::SEC_Header_fields& SEC_fields, const std::optional<pqxx::row>& saved_original_data,
+            bool replace_DB_content)
+    {
+        const auto& form_type = SEC_fields.at("form_type");
+
+        XBRL_FilingIdData result;
+
+        if (saved_original_data)
+        {
+            const auto& saved_data = *saved_original_data;
+            if (! saved_data["date_filed"].is_null())
+            {
+                result.original_date_filed_ = saved_data["date_filed"].view();
+            }
+            if (! saved_data["file_name"].is_null())
+            {
+                result.original_file_name_ = saved_data["file_name"].view();
+            }
+            if (! saved_data["amended_date_filed"].is_null())
+            {
+                result.amended_date_filed_ = saved_data["amended_date_filed"].view();
+            }
+            if (! saved_data["amended_file_name"].is_null())
+            {
+                result.amended_file_name_ = saved_data["amended_file_name"].view();
+            }
+        }
+        else if (! form_type.ends_with("_A"))
+        {
+            result.original_date_filed_ = SEC_fields.at("date_filed");
+            result.original_file_name_ = SEC_fields.at("file_name");
+        }
+
+        auto date_filed = StringToDateYMD("%F", SEC_fields.at("date_filed"));
+        date::year_month_day date_filed_amended = 1900_y/1/1_d;        // need to start somewhere
+
+        if ( ! result.amended_date_filed_.empty())
+        {
+            date_filed_amended = StringToDateYMD("%F", result.amended_date_filed_);
+        }
+
+        if (! replace_DB_content && form_type.ends_with("_A") && date_filed <= date_filed_amended)
+        {
+            return std::nullopt;
+        }
+
+        if (replace_DB_content || form_type.ends_with("_A") && date_filed > date_filed_amended)
+        {
+            if (form_type.ends_with("_A"))
+            {
+                result.amended_date_filed_ = SEC_fields.at("date_filed");
+                result.amended_file_name_ =  SEC_fields.at("file_name");
+            }
+            result.replace_existing_ = true;
+        }
+        return result;
+    }
+
+    // the column values for sec_filing_id, except filing_ID.
+
+    std::string XBRLFilingIdValues(const pqxx::transaction_base& trxn, const EM::SEC_Header_fields& SEC_fields, const EM::FilingData& filing_fields,
+            EM::sv base_form_type, const XBRL_FilingIdData& filing_id_data)
+    {
+        return fmt::format("{0}, {1}, {2}, {3}, {4}, {5}, {6}, {7}, {8}, {9}, '{10}', {11}, {12}",
+            trxn.quote(SEC_fields.at("cik")),
+            trxn.quote(SEC_fields.at("company_name")),
+            filing_id_data.original_file_name_.empty() ? "NULL" : trxn.quote(filing_id_data.original_file_name_),
+            filing_fields.trading_symbol.empty() ? "NULL" : trxn.quote(filing_fields.trading_symbol),
+            trxn.quote(SEC_fields.at("sic")),
+            trxn.quote(base_form_type),
+            filing_id_data.original_date_filed_.empty() ? "NULL" : trxn.quote(filing_id_data.original_date_filed_),
+            trxn.quote(filing_fields.period_end_date),
+            trxn.quote(filing_fields.period_context_ID),
+            filing_fields.shares_outstanding,
+            "XBRL",
+            filing_id_data.amended_file_name_.empty() ? "NULL" : trxn.quote(filing_id_data.amended_file_name_),
+            filing_id_data.amended_date_filed_.empty() ? "NULL" : trxn.quote(filing_id_data.amended_date_filed_)
+            );
+    }
+
+    using Column = DBCopyWriter::Column;
+    using ColumnType = DBCopyWriter::ColumnType;
+
+    const std::vector<Column> XBRL_DATA_COLUMNS{{"filing_ID", ColumnType::e_BigInt}, {"xbrl_label", ColumnType::e_Text},
+            {"label", ColumnType::e_Text}, {"value", ColumnType::e_Numeric}, {"context_ID", ColumnType::e_Text},
+            {"period_begin", ColumnType::e_Date}, {"period_end", ColumnType::e_Date}, {"units", ColumnType::e_Text},
+            {"decimals", ColumnType::e_Text}};
+
+    // same layout for all of our financial statement tables.
+
+    const std::vector<Column> STATEMENT_DATA_COLUMNS{{"filing_ID", ColumnType::e_BigInt}, {"label", ColumnType::e_Text},
+            {"value", ColumnType::e_Numeric}};
+
+    // each distinct label and context is looked up the first time a fact uses it.
+
+    void WriteXBRLData(DBCopyWriter& inserter, const std::string& filing_ID, const EM::GAAP_DataList& gaap_fields,
+            const EM::Extractor_Labels& label_fields, const EM::ContextPeriod& context_fields)
+    {
+        static const std::string missing_value{"Missing Value"};
+
+        std::vector<const std::string*> user_labels(gaap_fields.DistinctStrings(), nullptr);
+        std::vector<const EM::Extractor_TimePeriod*> periods(gaap_fields.DistinctStrings(), nullptr);
+        std::string key;
+
+        for (const auto&[label, context_ID, units, decimals, value]: gaap_fields)
+        {
+            if (user_labels[label] == nullptr)
+            {
+                key = gaap_fields.Text(label);
+                user_labels[label] = &FindOrDefault(label_fields, key, missing_value);
+            }
+            if (periods[context_ID] == nullptr)
+            {
+                key = gaap_fields.Text(context_ID);
+                periods[context_ID] = &context_fields.at(key);
+            }
+            inserter.WriteValues(
+                filing_ID,
+                gaap_fields.Text(label),
+                *user_labels[label],
+                value,
+                gaap_fields.Text(context_ID),
+                periods[context_ID]->begin,
+                periods[context_ID]->end,
+                gaap_fields.Text(units),
+                gaap_fields.Text(decimals))
+                ;
+        }
+    }
+
+    EM::sv BaseFormType(const std::string& form_type)
+    {
+        EM::sv base_form_type{form_type};
+        if (base_form_type.ends_with("_A"))
+        {
+            base_form_type.remove_suffix(2);
+        }
+        return base_form_type;
+    }
+}
+
 /* 
  * ===  FUNCTION  ======================================================================
  *         Name:  LoadDataToDB
  *  Description:  
  * =====================================================================================
  */
-bool LoadDataToDB(const EM::SEC_Header_fields& SEC_fields, const EM::FilingData& filing_fields,
-    const std::vector<EM::GAAP_Data>& gaap_fields, const EM::Extractor_Labels& label_fields,
-    const EM::ContextPeriod& context_fields, const std::string& schema_name, bool replace_DB_content)
+bool LoadDataToDB(DBConnectionPool& db_pool, const EM::SEC_Header_fields& SEC_fields, const EM::FilingData& filing_fields,
+    const EM::GAAP_DataList& gaap_fields, const EM::Extractor_Labels& label_fields,
+    const EM::ContextPeriod& context_fields, const std::string& schema_name, bool replace_DB_content, CopyFormat copy_format)
 {
-    auto form_type = SEC_fields.at("form_type");
-    EM::sv base_form_type{form_type};
-    if (base_form_type.ends_with("_A"))
-    {
-        base_form_type.remove_suffix(2);
-    }
+    auto base_form_type = BaseFormType(SEC_fields.at("form_type"));
 
     // start stuffing the database.
     // we only get here if we are going to add/replace data.
@@ -912,8 +1158,8 @@ bool LoadDataToDB(const EM::SEC_Header_fields& SEC_fields, const EM::FilingData&
     // we may have multiple files that map to the samie cik/form/period_end_date that get through the
     // check for existing data but clash on the insert.  In fact, we want insert failures.
 
-    pqxx::connection c{"dbname=sec_extracts user=extractor_pg"};
-    pqxx::work trxn{c};
+    auto c = db_pool.GetConnection();
+    pqxx::work trxn{*c};
 
     // when checking for existing data, we don't filter on source
     // since that may have changed (especially if we are processing an
@@ -928,57 +1174,15 @@ bool LoadDataToDB(const EM::SEC_Header_fields& SEC_fields, const EM::FilingData&
             ;
     auto saved_original_data = trxn.exec(save_original_data_cmd);
 
-    std::string original_date_filed;
-    std::string original_file_name;
-    std::string amended_date_filed;
-    std::string amended_file_name;
-
-    if (! saved_original_data.empty())
-    {
-        if (! saved_original_data[0]["date_filed"].is_null())
-        {
-            original_date_filed = saved_original_data[0]["date_filed"].view();
-        }
-        if (! saved_original_data[0]["file_name"].is_null())
-        {
-            original_file_name = saved_original_data[0]["file_name"].view();
-        }
-        if (! saved_original_data[0]["amended_date_filed"].is_null())
-        {
-            amended_date_filed = saved_original_data[0]["amended_date_filed"].view();
-        }
-        if (! saved_original_data[0]["amended_file_name"].is_null())
-        {
-            amended_file_name = saved_original_data[0]["amended_file_name"].view();
-        }
-    }
-    else if (! form_type.ends_with("_A"))
-    {
-        original_date_filed = SEC_fields.at("date_filed");
-        original_file_name = SEC_fields.at("file_name");
-    }
-
-    auto date_filed = StringToDateYMD("%F", SEC_fields.at("date_filed"));
-    date::year_month_day date_filed_amended = 1900_y/1/1_d;        // need to start somewhere
-
-    if ( ! amended_date_filed.empty())
-    {
-        date_filed_amended = StringToDateYMD("%F", amended_date_filed);
-    }
-
-    if (! replace_DB_content && form_type.ends_with("_A") && date_filed <= date_filed_amended)
+    auto filing_id_data = DecideXBRLFilingIdData(SEC_fields,
+            saved_original_data.empty() ? std::nullopt : std::optional<pqxx::row>{saved_original_data[0]}, replace_DB_content);
+    if (! filing_id_data)
     {
         return false;
     }
 
-    if (replace_DB_content || form_type.ends_with("_A") && date_filed > date_filed_amended)
+    if (filing_id_data->replace_existing_)
     {
-        if (form_type.ends_with("_A"))
-        {
-            amended_date_filed = SEC_fields.at("date_filed");
-            amended_file_name =  SEC_fields.at("file_name");
-        }
-
         auto filing_ID_cmd = fmt::format("DELETE FROM {3}.sec_filing_id WHERE"
             " cik = {0} AND form_type = {1} AND period_ending = {2}",
                 trxn.quote(SEC_fields.at("cik")),
@@ -989,55 +1193,173 @@ bool LoadDataToDB(const EM::SEC_Header_fields& SEC_fields, const EM::FilingData&
         trxn.exec(filing_ID_cmd);
     }
 
-	auto filing_ID_cmd = fmt::format("INSERT INTO {11}.sec_filing_id"
+	auto filing_ID_cmd = fmt::format("INSERT INTO {0}.sec_filing_id"
         " (cik, company_name, file_name, symbol, sic, form_type, date_filed, period_ending, period_context_ID,"
         " shares_outstanding, data_source, amended_file_name, amended_date_filed)"
-		" VALUES ({0}, {1}, {2}, {3}, {4}, {5}, {6}, {7}, {8}, {9}, '{10}', {12}, {13}) RETURNING filing_ID",
-		trxn.quote(SEC_fields.at("cik")),
-		trxn.quote(SEC_fields.at("company_name")),
-		original_file_name.empty() ? "NULL" : trxn.quote(original_file_name),
-        filing_fields.trading_symbol.empty() ? "NULL" : trxn.quote(filing_fields.trading_symbol),
-		trxn.quote(SEC_fields.at("sic")),
-        trxn.quote(base_form_type),
-		original_date_filed.empty() ? "NULL" : trxn.quote(original_date_filed),
-		trxn.quote(filing_fields.period_end_date),
-		trxn.quote(filing_fields.period_context_ID),
-		filing_fields.shares_outstanding,
-        "XBRL",
+		" VALUES ({1}) RETURNING filing_ID",
         schema_name,
-        amended_file_name.empty() ? "NULL" : trxn.quote(amended_file_name),
-        amended_date_filed.empty() ? "NULL" : trxn.quote(amended_date_filed)
-        )
+        XBRLFilingIdValues(trxn, SEC_fields, filing_fields, base_form_type, filing_id_data.value()))
 		;
     auto filing_ID = trxn.query_value<std::string>(filing_ID_cmd);
 
     // now, the goal of all this...save all the financial values for the given time period.
 
-    int counter = 0;
-    pqxx::stream_to inserter1{trxn, schema_name + ".sec_xbrl_data",
-        std::vector<std::string>{"filing_ID", "xbrl_label", "label", "value", "context_ID", "period_begin",
-            "period_end", "units", "decimals"}};
+    DBCopyWriter inserter1{c, trxn, schema_name + ".sec_xbrl_data", XBRL_DATA_COLUMNS, copy_format};
+    WriteXBRLData(inserter1, filing_ID, gaap_fields, label_fields, context_fields);
+
+    inserter1.Complete();
+    trxn.commit();
+    return true;
+}		/* -----  end of function LoadDataToDB  ----- */
+
+/* 
+ * ===  FUNCTION  ======================================================================
+ *         Name:  LoadDataToDB_Batch
+ *  Description:  load several XBRL filings in a single transaction.
+ *
+ *                One query finds any existing data for all of the filings. We
+ *                allocate all the filing_IDs we need from the table's sequence
+ *                up front so we can add all the sec_filing_id rows with a single
+ *                INSERT and all the sec_xbrl_data rows with a single COPY.
+ *
+ *                If 2 filings in the batch (or a filing and what is already in the
+ *                DB) clash, we get a unique_violation and nothing is loaded.  The
+ *                caller can then load the filings one at a time.
+ * =====================================================================================
+ */
+std::vector<bool> LoadDataToDB_Batch(DBConnectionPool& db_pool, const std::vector<XBRL_FilingToLoad>& filings,
+        const std::string& schema_name, bool replace_DB_content, CopyFormat copy_format)
+{
+    std::vector<bool> did_load(filings.size(), false);
+    if (filings.empty())
+    {
+        return did_load;
+    }
+
+    auto c = db_pool.GetConnection();
+    pqxx::work trxn{*c};
+
+    // as above, when checking for existing data, we don't filter on source.
+    // we tag each filing with its position in the batch so we can match up the results.
 
-    for (const auto&[label, context_ID, units, decimals, value]: gaap_fields)
+    std::vector<std::string> filing_keys;
+    filing_keys.reserve(filings.size());
+    for (std::size_t i = 0; i < filings.size(); ++i)
     {
-        ++counter;
-        inserter1.write_values(
-            filing_ID,
-            label,
-            FindOrDefault(label_fields, label, "Missing Value"),
-            value,
-            context_ID,
-            context_fields.at(context_ID).begin,
-            context_fields.at(context_ID).end,
-            units,
-            decimals)
+        const auto& SEC_fields = *filings[i].SEC_fields_;
+        filing_keys.push_back(fmt::format("({0}, {1}, {2}, {3}::DATE)",
+                i,
+                trxn.quote(SEC_fields.at("cik")),
+                trxn.quote(BaseFormType(SEC_fields.at("form_type"))),
+                trxn.quote(filings[i].filing_fields_->period_end_date)));
+    }
+
+    auto save_original_data_cmd = fmt::format("SELECT batch.position, s.date_filed, s.file_name, s.amended_date_filed, s.amended_file_name"
+        " FROM (VALUES {0}) AS batch (position, cik, form_type, period_ending)"
+        " JOIN {1}.sec_filing_id s ON s.cik = batch.cik AND s.form_type = batch.form_type AND s.period_ending = batch.period_ending",
+            fmt::join(filing_keys, ", "),
+            schema_name)
             ;
+    auto saved_original_data = trxn.exec(save_original_data_cmd);
+
+    std::vector<std::optional<pqxx::row>> saved_rows(filings.size());
+    for (const auto& row : saved_original_data)
+    {
+        saved_rows[row["position"].as<std::size_t>()] = row;
     }
 
-    inserter1.complete();
+    std::vector<std::optional<XBRL_FilingIdData>> filing_id_data;
+    filing_id_data.reserve(filings.size());
+    std::vector<std::string> replace_keys;
+    int filings_to_load{0};
+
+    for (std::size_t i = 0; i < filings.size(); ++i)
+    {
+        const auto& SEC_fields = *filings[i].SEC_fields_;
+        filing_id_data.push_back(DecideXBRLFilingIdData(SEC_fields, saved_rows[i], replace_DB_content));
+        if (! filing_id_data.back())
+        {
+            continue;
+        }
+        ++filings_to_load;
+        if (filing_id_data.back()->replace_existing_)
+        {
+            replace_keys.push_back(fmt::format("({0}, {1}, {2}::DATE)",
+                    trxn.quote(SEC_fields.at("cik")),
+                    trxn.quote(BaseFormType(SEC_fields.at("form_type"))),
+                    trxn.quote(SEC_fields.at("quarter_ending"))));
+        }
+    }
+
+    if (filings_to_load == 0)
+    {
+        trxn.commit();
+        return did_load;
+    }
+
+    if (! replace_keys.empty())
+    {
+        auto filing_ID_cmd = fmt::format("DELETE FROM {0}.sec_filing_id WHERE (cik, form_type, period_ending) IN ({1})",
+                schema_name,
+                fmt::join(replace_keys, ", "))
+                ;
+        trxn.exec(filing_ID_cmd);
+    }
+
+    auto filing_IDs_cmd = fmt::format("SELECT nextval(pg_get_serial_sequence('{0}.sec_filing_id', 'filing_id'))"
+        " FROM generate_series(1, {1})",
+            schema_name,
+            filings_to_load)
+            ;
+    auto new_filing_IDs = trxn.exec(filing_IDs_cmd);
+
+    std::vector<std::string> filing_IDs(filings.size());
+    std::vector<std::string> filing_id_values;
+    filing_id_values.reserve(filings_to_load);
+    auto next_filing_ID = new_filing_IDs.begin();
+
+    for (std::size_t i = 0; i < filings.size(); ++i)
+    {
+        if (! filing_id_data[i])
+        {
+            continue;
+        }
+        filing_IDs[i] = (*next_filing_ID)[0].as<std::string>();
+        ++next_filing_ID;
+
+        const auto& SEC_fields = *filings[i].SEC_fields_;
+        filing_id_values.push_back(fmt::format("({0}, {1})",
+                filing_IDs[i],
+                XBRLFilingIdValues(trxn, SEC_fields, *filings[i].filing_fields_, BaseFormType(SEC_fields.at("form_type")),
+                    filing_id_data[i].value())));
+    }
+
+    // our filing_ID column is an identity column so we have to insist on using our values.
+
+	auto filing_ID_cmd = fmt::format("INSERT INTO {0}.sec_filing_id"
+        " (filing_ID, cik, company_name, file_name, symbol, sic, form_type, date_filed, period_ending, period_context_ID,"
+        " shares_outstanding, data_source, amended_file_name, amended_date_filed)"
+		" OVERRIDING SYSTEM VALUE VALUES {1}",
+        schema_name,
+        fmt::join(filing_id_values, ", "))
+		;
+    trxn.exec(filing_ID_cmd);
+
+    DBCopyWriter inserter1{c, trxn, schema_name + ".sec_xbrl_data", XBRL_DATA_COLUMNS, copy_format};
+    for (std::size_t i = 0; i < filings.size(); ++i)
+    {
+        if (! filing_id_data[i])
+        {
+            continue;
+        }
+        WriteXBRLData(inserter1, filing_IDs[i], *filings[i].gaap_fields_, *filings[i].label_fields_, *filings[i].context_fields_);
+        did_load[i] = true;
+    }
+
+    inserter1.Complete();
     trxn.commit();
-    return true;
-}		/* -----  end of function LoadDataToDB  ----- */
+    return did_load;
+}		/* -----  end of function LoadDataToDB_Batch  ----- */
 
 /* 
  * ===  FUNCTION  ======================================================================
@@ -1045,7 +1367,8 @@ bool LoadDataToDB(const EM::SEC_Header_fields& SEC_fields, const EM::FilingData&
  *  Description:  
  * =====================================================================================
  */
-bool LoadDataToDB_XLS(const EM::SEC_Header_fields& SEC_fields, const XLS_FinancialStatements& financial_statements, const std::string& schema_name, bool replace_DB_content)
+bool LoadDataToDB_XLS(DBConnectionPool& db_pool, const EM::SEC_Header_fields& SEC_fields, const XLS_FinancialStatements& financial_statements, const std::string& schema_name, bool replace_DB_content,
+        CopyFormat copy_format)
 {
     auto form_type = SEC_fields.at("form_type");
     EM::sv base_form_type{form_type};
@@ -1062,8 +1385,8 @@ bool LoadDataToDB_XLS(const EM::SEC_Header_fields& SEC_fields, const XLS_Financi
     // we may have multiple files that map to the samie cik/form/period_end_date that get through the
     // check for existing data but clash on the insert.  In fact, we want insert failures.
 
-    pqxx::connection c{"dbname=sec_extracts user=extractor_pg"};
-    pqxx::work trxn{c};
+    auto c = db_pool.GetConnection();
+    pqxx::work trxn{*c};
 
     // when checking for existing data, we don't filter on source
     // since that may have changed (especially if we are processing an
@@ -1166,50 +1489,47 @@ bool LoadDataToDB_XLS(const EM::SEC_Header_fields& SEC_fields, const XLS_Financi
     // now, the goal of all this...save all the financial values for the given time period.
 
     int counter = 0;
-    pqxx::stream_to inserter1{trxn, schema_name + ".sec_bal_sheet_data",
-        std::vector<std::string>{"filing_ID", "label", "value"}};
+    DBCopyWriter inserter1{c, trxn, schema_name + ".sec_bal_sheet_data", STATEMENT_DATA_COLUMNS, copy_format};
 
     for (const auto&[label, value] : financial_statements.balance_sheet_.values_)
     {
         ++counter;
-        inserter1.write_values(
+        inserter1.WriteValues(
             filing_ID,
             label.get(),
             value.get()
             );
     }
 
-    inserter1.complete();
+    inserter1.Complete();
 
-    pqxx::stream_to inserter2{trxn, schema_name + ".sec_stmt_of_ops_data",
-        std::vector<std::string>{"filing_ID", "label", "value"}};
+    DBCopyWriter inserter2{c, trxn, schema_name + ".sec_stmt_of_ops_data", STATEMENT_DATA_COLUMNS, copy_format};
 
     for (const auto&[label, value] : financial_statements.statement_of_operations_.values_)
     {
         ++counter;
-        inserter2.write_values(
+        inserter2.WriteValues(
             filing_ID,
             label.get(),
             value.get()
             );
     }
 
-    inserter2.complete();
+    inserter2.Complete();
 
-    pqxx::stream_to inserter3{trxn, schema_name + ".sec_cash_flows_data",
-        std::vector<std::string>{"filing_ID", "label", "value"}};
+    DBCopyWriter inserter3{c, trxn, schema_name + ".sec_cash_flows_data", STATEMENT_DATA_COLUMNS, copy_format};
 
     for (const auto&[label, value] : financial_statements.cash_flows_.values_)
     {
         ++counter;
-        inserter3.write_values(
+        inserter3.WriteValues(
             filing_ID,
             label.get(),
             value.get()
             );
     }
 
-    inserter3.complete();
+    inserter3.Complete();
 
     trxn.commit();
 
@@ -37,7 +37,10 @@
 
 #include <exception>
 #include <map>
+#include <memory_resource>
 #include <tuple>
+#include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 #include <range/v3/view/concat.hpp>
@@ -55,7 +58,7 @@
 struct XLS_BalanceSheet
 {
     EM::XLS_Values values_;
-    bool found_sheet_;
+    bool found_sheet_ = false;
 
     [[nodiscard]] inline bool empty() const { return ! found_sheet_; }
 
@@ -65,7 +68,7 @@ struct XLS_BalanceSheet
 struct XLS_StatementOfOperations
 {
     EM::XLS_Values values_;
-    bool found_sheet_;
+    bool found_sheet_ = false;
 
     [[nodiscard]] inline bool empty() const { return ! found_sheet_; }
 
@@ -75,7 +78,7 @@ struct XLS_StatementOfOperations
 struct XLS_CashFlows
 {
     EM::XLS_Values values_;
-    bool found_sheet_;
+    bool found_sheet_ = false;
 
     [[nodiscard]] inline bool empty() const { return ! found_sheet_; }
 
@@ -85,7 +88,7 @@ struct XLS_CashFlows
 struct XLS_StockholdersEquity
 {
     EM::XLS_Values values_;
-    bool found_sheet_;
+    bool found_sheet_ = false;
 
     [[nodiscard]] inline bool empty() const { return ! found_sheet_; }
 
@@ -117,17 +120,19 @@ struct XLS_FinancialStatements
             cash_flows_.values_); }
 };
 
-XLS_FinancialStatements FindAndExtractXLSContent(EM::DocumentSectionList const & document_sections, const EM::FileName& document_name);
+XLS_FinancialStatements FindAndExtractXLSContent(EM::DocumentSectionList const & document_sections);
 
 EM::XLS_Values ExtractXLSFilingData(const XLS_Sheet& sheet);
 
 EM::XLS_Values CollectXLSValues (const XLS_Sheet& sheet);
 
-EM::XBRLContent LocateInstanceDocument(const EM::DocumentSectionList& document_sections, const EM::FileName& document_name);
+std::optional<EM::XLS_Entry> FindXLSLabelAndValue (const XLS_Row& row);
 
-EM::XBRLContent LocateLabelDocument(const EM::DocumentSectionList& document_sections, const EM::FileName& document_name);
+EM::XBRLContent LocateInstanceDocument(const EM::DocumentSectionList& document_sections);
 
-EM::XLSContent LocateXLSDocument(const EM::DocumentSectionList& document_sections, const EM::FileName& document_name);
+EM::XBRLContent LocateLabelDocument(const EM::DocumentSectionList& document_sections);
+
+EM::XLSContent LocateXLSDocument(const EM::DocumentSectionList& document_sections);
 
 EM::FilingData ExtractFilingData(const pugi::xml_document& instance_xml);
 
@@ -139,34 +144,55 @@ std::pair<std::string, int64_t> ExtractMultiplier(std::string row);
 
 int64_t ExtractXLSSharesOutstanding(const XLS_Sheet& xls_sheet);
 
-std::vector<EM::GAAP_Data> ExtractGAAPFields(const pugi::xml_document& instance_xml);
+EM::GAAP_DataList ExtractGAAPFields(const pugi::xml_document& instance_xml,
+        std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+
+// when 'wanted_names' is given, we find labels for just those names.
 
-EM::Extractor_Labels ExtractFieldLabels(const pugi::xml_document& labels_xml);
+EM::Extractor_Labels ExtractFieldLabels(const pugi::xml_document& labels_xml, const std::unordered_set<EM::sv>* wanted_names = nullptr);
 
-std::vector<std::pair<EM::sv, EM::sv>> FindLabelElements (const pugi::xml_node& top_level_node,
+std::unordered_map<EM::sv, EM::sv> FindLabelElements (const pugi::xml_node& top_level_node,
         const std::string& label_link_name, const std::string& label_node_name);
 
-std::map<EM::sv, EM::sv> FindLocElements (const pugi::xml_node& top_level_node,
-        const std::string& label_link_name, const std::string& loc_node_name);
+std::unordered_map<EM::sv, EM::sv> FindLocElements (const pugi::xml_node& top_level_node,
+        const std::string& label_link_name, const std::string& loc_node_name, const std::unordered_set<EM::sv>* wanted_names = nullptr);
 
-std::map<EM::sv, EM::sv> FindLabelArcElements (const pugi::xml_node& top_level_node,
+std::unordered_map<EM::sv, EM::sv> FindLabelArcElements (const pugi::xml_node& top_level_node,
         const std::string& label_link_name, const std::string& arc_node_name);
 
-EM::Extractor_Labels AssembleLookupTable(const std::vector<std::pair<EM::sv, EM::sv>>& labels,
-        const std::map<EM::sv, EM::sv>& locs, const std::map<EM::sv, EM::sv>& arcs);
+EM::Extractor_Labels AssembleLookupTable(const std::unordered_map<EM::sv, EM::sv>& labels,
+        const std::unordered_map<EM::sv, EM::sv>& locs, const std::unordered_map<EM::sv, EM::sv>& arcs);
 
 EM::ContextPeriod ExtractContextDefinitions(const pugi::xml_document& instance_xml);
 
 pugi::xml_document ParseXMLContent(EM::XBRLContent document);
 
-EM::XBRLContent TrimExcessXML(EM::DocumentSection document);
+EM::XBRLContent TrimExcessXML(const EM::DocumentSectionData& document);
 
 std::string ConvertPeriodEndDateToContextName(EM::sv period_end_date);
 
-bool LoadDataToDB(const EM::SEC_Header_fields& SEC_fields, const EM::FilingData& filing_fields,
-    const std::vector<EM::GAAP_Data>& gaap_fields, const EM::Extractor_Labels& label_fields,
-    const EM::ContextPeriod& context_fields, const std::string& schema_name, bool replace_DB_content);
+bool LoadDataToDB(DBConnectionPool& db_pool, const EM::SEC_Header_fields& SEC_fields, const EM::FilingData& filing_fields,
+    const EM::GAAP_DataList& gaap_fields, const EM::Extractor_Labels& label_fields,
+    const EM::ContextPeriod& context_fields, const std::string& schema_name, bool replace_DB_content, CopyFormat copy_format);
+
+// everything we need to load 1 filing as part of a batch.
+
+struct XBRL_FilingToLoad
+{
+    const EM::SEC_Header_fields* SEC_fields_;
+    const EM::FilingData* filing_fields_;
+    const EM::GAAP_DataList* gaap_fields_;
+    const EM::Extractor_Labels* label_fields_;
+    const EM::ContextPeriod* context_fields_;
+};
+
+// returns whether each filing was loaded. Throws pqxx::unique_violation if any
+// filings clash, in which case nothing is loaded.
+
+std::vector<bool> LoadDataToDB_Batch(DBConnectionPool& db_pool, const std::vector<XBRL_FilingToLoad>& filings,
+        const std::string& schema_name, bool replace_DB_content, CopyFormat copy_format);
 
-bool LoadDataToDB_XLS(const EM::SEC_Header_fields& SEC_fields, const XLS_FinancialStatements& financial_statements, const std::string& schema_name, bool replace_DB_content);
+bool LoadDataToDB_XLS(DBConnectionPool& db_pool, const EM::SEC_Header_fields& SEC_fields, const XLS_FinancialStatements& financial_statements, const std::string& schema_name, bool replace_DB_content,
+        CopyFormat copy_format);
 
 #endif   /* ----- #ifndef _EXTRACTOR_XBRL_FILEFILTER_INC_  ----- */
@@ -129,12 +129,12 @@ void XLS_data::UseExtractor(EM::FileName file_name, EM::FileContent file_content
 
     for (auto& doc : documents)
     {
-        auto document = doc.get();
+        auto document = doc.document_.get();
         if (auto ss_loc = document.find(R"***(.xlsx)***"); ss_loc != EM::sv::npos)
         {
             std::cout << "spread sheet\n";
 
-            auto output_file_name{FindFileName(doc, file_name)};
+            EM::FileName output_file_name{doc.file_name_};
             auto output_path_name = hierarchy_converter_(file_name, output_file_name.get().string());
             spdlog::info(output_path_name.string());
 
@@ -469,7 +469,7 @@ void Count_XLS::UseExtractor(EM::FileName file_name, EM::FileContent file_conten
 
     for (auto& doc : documents)
     {
-        auto document = doc.get();
+        auto document = doc.document_.get();
         if (auto ss_loc = document.find(R"***(.xlsx)***"); ss_loc != EM::sv::npos)
         {
             ++XLS_counter;
@@ -0,0 +1,35 @@
+// =====================================================================================
+//
+//       Filename:  FilingArena.cpp
+//
+//    Description:  Implementation of FilingArena
+//
+//        Version:  1.0
+//        Created:  10/17/2026 10:24:51 PM
+//       Revision:  none
+//       Compiler:  g++
+//
+//         Author:  David P. Riedel (), driedel@cox.net
+//        License:  GNU General Public License -v3
+//
+// =====================================================================================
+
+#include "FilingArena.h"
+
+FilingArena::FilingArena (std::size_t initial_size)
+    : arena_{initial_size, &upstream_}
+{
+}  // -----  end of method FilingArena::FilingArena  (constructor)  -----
+
+void* FilingArena::CountingResource::do_allocate (std::size_t bytes, std::size_t alignment)
+{
+    void* result = std::pmr::new_delete_resource()->allocate(bytes, alignment);
+    bytes_reserved_ += bytes;
+    return result;
+}		// -----  end of method FilingArena::CountingResource::do_allocate  -----
+
+void FilingArena::CountingResource::do_deallocate (void* p, std::size_t bytes, std::size_t alignment)
+{
+    std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+    bytes_reserved_ -= bytes;
+}		// -----  end of method FilingArena::CountingResource::do_deallocate  -----
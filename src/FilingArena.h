@@ -0,0 +1,98 @@
+// =====================================================================================
+//
+//       Filename:  FilingArena.h
+//
+//    Description:  Memory for everything we keep about 1 filing while we process it
+//
+//        Version:  1.0
+//        Created:  10/17/2026 10:24:51 PM
+//       Revision:  none
+//       Compiler:  g++
+//
+//         Author:  David P. Riedel (), driedel@cox.net
+//        License:  GNU General Public License -v3
+//
+// =====================================================================================
+
+
+// =====================================================================================
+//        Class:  FilingArena
+//  Description:  A monotonic arena.  Allocating is a pointer bump, freeing does nothing
+//                and everything goes back in 1 step when the filing is done with.
+//                Threads working on different filings never touch the same heap.
+//
+//                We count what the arena takes from the system so we can see how
+//                much a filing needs.
+//
+//                Only 1 thread at a time may allocate from an arena.  Anything using
+//                it must be destroyed first.
+// =====================================================================================
+
+
+#ifndef  FilingArena_INC
+#define  FilingArena_INC
+
+#include <cstddef>
+#include <memory_resource>
+
+class FilingArena
+{
+public:
+
+    // ====================  LIFECYCLE     =======================================
+
+    explicit FilingArena (std::size_t initial_size = default_initial_size_);      // constructor
+    FilingArena(const FilingArena& rhs) = delete;
+    FilingArena(FilingArena&& rhs) = delete;
+
+    ~FilingArena () = default;
+
+    // ====================  ACCESSORS     =======================================
+
+    [[nodiscard]] std::size_t BytesReserved() const { return upstream_.bytes_reserved_; }
+
+    // ====================  MUTATORS      =======================================
+
+    [[nodiscard]] std::pmr::memory_resource* resource() { return &arena_; }
+
+    // ====================  OPERATORS     =======================================
+
+    FilingArena& operator = (const FilingArena& rhs) = delete;
+    FilingArena& operator = (FilingArena&& rhs) = delete;
+
+protected:
+    // ====================  METHODS       =======================================
+
+    // ====================  DATA MEMBERS  =======================================
+
+private:
+
+    // passes everything on to the global heap, keeping count as it goes.
+
+    class CountingResource : public std::pmr::memory_resource
+    {
+    public:
+
+        std::size_t bytes_reserved_ = 0;
+
+    private:
+
+        void* do_allocate(std::size_t bytes, std::size_t alignment) override;
+        void do_deallocate(void* p, std::size_t bytes, std::size_t alignment) override;
+        [[nodiscard]] bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+    };
+
+    // ====================  METHODS       =======================================
+
+    // ====================  DATA MEMBERS  =======================================
+
+    // about what a typical 10-Q's facts need.
+
+    static constexpr std::size_t default_initial_size_ = 256 * 1024;
+
+    CountingResource upstream_;
+    std::pmr::monotonic_buffer_resource arena_;
+
+}; // -----  end of class FilingArena  -----
+
+#endif   // ----- #ifndef FilingArena_INC  -----
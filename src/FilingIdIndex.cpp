@@ -0,0 +1,340 @@
+// =====================================================================================
+//
+//       Filename:  FilingIdIndex.cpp
+//
+//    Description:  Implementation of FilingIdIndex
+//
+//        Version:  1.0
+//        Created:  10/17/2026 03:51:19 PM
+//       Revision:  none
+//       Compiler:  g++
+//
+//         Author:  David P. Riedel (), driedel@cox.net
+//        License:  GNU General Public License -v3
+//
+// =====================================================================================
+
+#include <algorithm>
+#include <charconv>
+#include <limits>
+#include <mutex>
+
+#include <pqxx/pqxx>
+
+#include "fmt/core.h"
+#include "spdlog/spdlog.h"
+
+#include "DBConnectionPool.h"
+#include "Extractor_Utils.h"
+#include "FilingIdIndex.h"
+
+namespace
+{
+    constexpr int32_t no_amended_date = std::numeric_limits<int32_t>::min();
+
+    // CIKs are at most 10 digits so they fit in 34 bits. That leaves
+    // 20 bits for the period ending date which covers us until about 4840.
+
+    constexpr int date_bits = 20;
+
+    template<typename T>
+    bool ParseNumber(EM::sv digits, T& result)
+    {
+        auto [ptr, ec] = std::from_chars(digits.data(), digits.data() + digits.size(), result);
+        return ec == std::errc() && ptr == digits.data() + digits.size();
+    }
+
+    // our dates are always yyyy-mm-dd.
+
+    std::optional<int32_t> DaysSinceEpoch(EM::sv a_date)
+    {
+        int year{0};
+        unsigned month{0};
+        unsigned day{0};
+        if (a_date.size() != 10 || a_date[4] != '-' || a_date[7] != '-'
+                || ! ParseNumber(a_date.substr(0, 4), year) || ! ParseNumber(a_date.substr(5, 2), month)
+                || ! ParseNumber(a_date.substr(8, 2), day))
+        {
+            return std::nullopt;
+        }
+        date::year_month_day ymd{date::year{year}, date::month{month}, date::day{day}};
+        if (! ymd.ok())
+        {
+            return std::nullopt;
+        }
+        return date::sys_days{ymd}.time_since_epoch().count();
+    }
+
+    std::optional<uint64_t> PackKey(EM::sv cik, std::optional<int32_t> period_ending_days)
+    {
+        uint64_t cik_value{0};
+        if (cik.empty() || cik.size() > 10 || ! ParseNumber(cik, cik_value))
+        {
+            return std::nullopt;
+        }
+        if (! period_ending_days || period_ending_days.value() < 0 || period_ending_days.value() >= (1 << date_bits))
+        {
+            return std::nullopt;
+        }
+        return (cik_value << date_bits) | static_cast<uint64_t>(period_ending_days.value());
+    }
+
+    std::optional<uint64_t> PackKey(EM::sv cik, EM::sv period_ending)
+    {
+        return PackKey(cik, DaysSinceEpoch(period_ending));
+    }
+
+    const char* DataSourceName(uint8_t data_source)
+    {
+        static const char* names[] = {"", "XBRL", "XLS", "HTML"};
+        return names[data_source];
+    }
+
+    uint8_t DataSourceCode(EM::sv data_source)
+    {
+        if (data_source == "XBRL")
+        {
+            return 1;
+        }
+        if (data_source == "XLS")
+        {
+            return 2;
+        }
+        if (data_source == "HTML")
+        {
+            return 3;
+        }
+        return 0;
+    }
+}
+
+/*
+ * ===  FUNCTION  ======================================================================
+ *         Name:  FilingIdIndex::Find
+ *  Description:
+ * =====================================================================================
+ */
+std::optional<FilingIdIndex::FilingInfo> FilingIdIndex::Find (EM::sv cik, EM::sv base_form_type, EM::sv period_ending, EM::sv data_source) const
+{
+    auto key = PackKey(cik, period_ending);
+    if (! key)
+    {
+        return std::nullopt;
+    }
+    return FindKey(key.value(), base_form_type, data_source);
+}		// -----  end of method FilingIdIndex::Find  -----
+
+std::optional<FilingIdIndex::FilingInfo> FilingIdIndex::Find (EM::sv cik, EM::sv base_form_type, date::year_month_day period_ending,
+        EM::sv data_source) const
+{
+    if (! period_ending.ok())
+    {
+        return std::nullopt;
+    }
+    auto key = PackKey(cik, date::sys_days{period_ending}.time_since_epoch().count());
+    if (! key)
+    {
+        return std::nullopt;
+    }
+    return FindKey(key.value(), base_form_type, data_source);
+}		// -----  end of method FilingIdIndex::Find  -----
+
+std::optional<FilingIdIndex::FilingInfo> FilingIdIndex::FindKey (uint64_t key, EM::sv base_form_type, EM::sv data_source) const
+{
+    std::shared_lock<std::shared_mutex> lk{m_};
+
+    auto form_type = FindFormType(base_form_type);
+    if (! form_type)
+    {
+        return std::nullopt;
+    }
+    const auto wanted_source = static_cast<DataSource>(DataSourceCode(data_source));
+
+    auto matches([&key, &form_type, &data_source, wanted_source] (const FilingEntry& entry)
+        {
+            return entry.key_ == key && entry.form_type_ == form_type.value()
+                && (data_source.empty() || entry.data_source_ == wanted_source);
+        });
+
+    auto [first, last] = std::equal_range(entries_.begin(), entries_.end(), FilingEntry{key, 0, 0, DataSource::e_Unknown},
+            [] (const FilingEntry& lhs, const FilingEntry& rhs) { return lhs.key_ < rhs.key_; });
+
+    if (auto found = std::find_if(first, last, matches); found != last)
+    {
+        return MakeFilingInfo(*found);
+    }
+    if (auto found = std::find_if(recent_entries_.begin(), recent_entries_.end(), matches); found != recent_entries_.end())
+    {
+        return MakeFilingInfo(*found);
+    }
+    return std::nullopt;
+}		// -----  end of method FilingIdIndex::FindKey  -----
+
+std::size_t FilingIdIndex::size () const
+{
+    std::shared_lock<std::shared_mutex> lk{m_};
+    return entries_.size() + recent_entries_.size();
+}		// -----  end of method FilingIdIndex::size  -----
+
+/*
+ * ===  FUNCTION  ======================================================================
+ *         Name:  FilingIdIndex::Load
+ *  Description:  one scan of the table instead of a query per file.
+ * =====================================================================================
+ */
+void FilingIdIndex::Load (DBConnectionPool& db_pool, const std::string& schema_name)
+{
+    std::vector<FilingEntry> entries;
+    std::vector<std::string> form_types;
+    int bad_rows{0};
+    {
+        auto c = db_pool.GetConnection();
+        pqxx::nontransaction trxn{*c};
+
+        auto rows = trxn.exec(fmt::format("SELECT cik, form_type, period_ending, data_source, amended_date_filed FROM {0}.sec_filing_id",
+                    schema_name));
+        entries.reserve(rows.size());
+
+        for (const auto& row : rows)
+        {
+            auto key = PackKey(row["cik"].view(), row["period_ending"].view());
+            if (! key)
+            {
+                ++bad_rows;
+                continue;
+            }
+
+            EM::sv form_type = row["form_type"].view();
+            auto which_form = std::find(form_types.begin(), form_types.end(), form_type);
+            if (which_form == form_types.end())
+            {
+                which_form = form_types.insert(form_types.end(), std::string{form_type});
+            }
+
+            int32_t amended_date_filed{no_amended_date};
+            if (! row["amended_date_filed"].is_null())
+            {
+                amended_date_filed = DaysSinceEpoch(row["amended_date_filed"].view()).value_or(no_amended_date);
+            }
+
+            entries.push_back({key.value(), amended_date_filed, static_cast<uint16_t>(which_form - form_types.begin()),
+                    static_cast<DataSource>(DataSourceCode(row["data_source"].view()))});
+        }
+    }
+    std::sort(entries.begin(), entries.end(), [] (const FilingEntry& lhs, const FilingEntry& rhs) { return lhs.key_ < rhs.key_; });
+    const auto entry_count = entries.size();
+
+    {
+        std::unique_lock<std::shared_mutex> lk{m_};
+        entries_ = std::move(entries);
+        form_types_ = std::move(form_types);
+        recent_entries_.clear();
+    }
+
+    spdlog::info(catenate("Loaded: ", entry_count, " existing filing keys from: ", schema_name, ".sec_filing_id."));
+    if (bad_rows > 0)
+    {
+        spdlog::info(catenate("Ignored: ", bad_rows, " filing keys with unusable CIK or period ending."));
+    }
+}		// -----  end of method FilingIdIndex::Load  -----
+
+/*
+ * ===  FUNCTION  ======================================================================
+ *         Name:  FilingIdIndex::Record
+ *  Description:  our loaders replace any existing row for the same CIK, form type and
+ *                period so we do the same.
+ * =====================================================================================
+ */
+void FilingIdIndex::Record (EM::sv cik, EM::sv base_form_type, EM::sv period_ending, EM::sv data_source, EM::sv amended_date_filed)
+{
+    auto key = PackKey(cik, period_ending);
+    if (! key)
+    {
+        return;
+    }
+    const int32_t new_amended_date = amended_date_filed.empty() ? no_amended_date
+        : DaysSinceEpoch(amended_date_filed).value_or(no_amended_date);
+    const auto new_source = static_cast<DataSource>(DataSourceCode(data_source));
+
+    std::unique_lock<std::shared_mutex> lk{m_};
+
+    const auto form_type = AddFormType(base_form_type);
+
+    auto update_entry([&] (FilingEntry& entry)
+        {
+            entry.data_source_ = new_source;
+            if (new_amended_date != no_amended_date)
+            {
+                entry.amended_date_filed_ = new_amended_date;
+            }
+        });
+
+    auto matches([&key, form_type] (const FilingEntry& entry) { return entry.key_ == key.value() && entry.form_type_ == form_type; });
+
+    auto [first, last] = std::equal_range(entries_.begin(), entries_.end(), FilingEntry{key.value(), 0, 0, DataSource::e_Unknown},
+            [] (const FilingEntry& lhs, const FilingEntry& rhs) { return lhs.key_ < rhs.key_; });
+
+    if (auto found = std::find_if(first, last, matches); found != last)
+    {
+        update_entry(*found);
+        return;
+    }
+    if (auto found = std::find_if(recent_entries_.begin(), recent_entries_.end(), matches); found != recent_entries_.end())
+    {
+        update_entry(*found);
+        return;
+    }
+
+    recent_entries_.push_back({key.value(), new_amended_date, form_type, new_source});
+    if (recent_entries_.size() >= max_recent_entries_)
+    {
+        MergeRecentEntries();
+    }
+}		// -----  end of method FilingIdIndex::Record  -----
+
+std::optional<uint16_t> FilingIdIndex::FindFormType (EM::sv base_form_type) const
+{
+    auto which_form = std::find(form_types_.begin(), form_types_.end(), base_form_type);
+    if (which_form == form_types_.end())
+    {
+        return std::nullopt;
+    }
+    return static_cast<uint16_t>(which_form - form_types_.begin());
+}		// -----  end of method FilingIdIndex::FindFormType  -----
+
+uint16_t FilingIdIndex::AddFormType (EM::sv base_form_type)
+{
+    if (auto form_type = FindFormType(base_form_type); form_type)
+    {
+        return form_type.value();
+    }
+    form_types_.emplace_back(base_form_type);
+    return static_cast<uint16_t>(form_types_.size() - 1);
+}		// -----  end of method FilingIdIndex::AddFormType  -----
+
+FilingIdIndex::FilingInfo FilingIdIndex::MakeFilingInfo (const FilingEntry& entry) const
+{
+    FilingInfo result{DataSourceName(static_cast<uint8_t>(entry.data_source_)), std::nullopt};
+    if (entry.amended_date_filed_ != no_amended_date)
+    {
+        result.amended_date_filed_ = date::year_month_day{date::sys_days{date::days{entry.amended_date_filed_}}};
+    }
+    return result;
+}		// -----  end of method FilingIdIndex::MakeFilingInfo  -----
+
+/*
+ * ===  FUNCTION  ======================================================================
+ *         Name:  FilingIdIndex::MergeRecentEntries
+ *  Description:  caller holds the lock.
+ * =====================================================================================
+ */
+void FilingIdIndex::MergeRecentEntries ()
+{
+    auto by_key([] (const FilingEntry& lhs, const FilingEntry& rhs) { return lhs.key_ < rhs.key_; });
+
+    std::sort(recent_entries_.begin(), recent_entries_.end(), by_key);
+    const auto old_size = entries_.size();
+    entries_.insert(entries_.end(), recent_entries_.begin(), recent_entries_.end());
+    std::inplace_merge(entries_.begin(), entries_.begin() + old_size, entries_.end(), by_key);
+    recent_entries_.clear();
+}		// -----  end of method FilingIdIndex::MergeRecentEntries  -----
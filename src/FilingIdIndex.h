@@ -0,0 +1,136 @@
+// =====================================================================================
+//
+//       Filename:  FilingIdIndex.h
+//
+//    Description:  In memory copy of the keys in our sec_filing_id table so we
+//                  can decide whether a file needs loading without asking the DB.
+//
+//        Version:  1.0
+//        Created:  10/17/2026 03:27:44 PM
+//       Revision:  none
+//       Compiler:  g++
+//
+//         Author:  David P. Riedel (), driedel@cox.net
+//        License:  GNU General Public License -v3
+//
+// =====================================================================================
+
+// =====================================================================================
+//        Class:  FilingIdIndex
+//  Description:  We read (cik, form_type, period_ending, data_source, amended_date_filed)
+//                for every row once at startup.  Each row becomes a 16 byte entry
+//                whose sort key packs the CIK and period ending date into a single
+//                integer.  Entries live in a sorted vector so a lookup is a binary
+//                search.  Form types are interned since there are only a handful.
+//
+//                Rows we add while running go into a small unsorted list which is
+//                merged into the sorted vector once it grows.  This keeps each
+//                addition cheap even when the index holds millions of entries.
+//
+//                Lookups can run concurrently with each other.  Additions lock out
+//                everyone else.
+// =====================================================================================
+
+
+#ifndef  FilingIdIndex_INC
+#define  FilingIdIndex_INC
+
+#include <cstdint>
+#include <optional>
+#include <shared_mutex>
+#include <string>
+#include <vector>
+
+#include "date/date.h"
+
+#include "Extractor.h"
+
+class DBConnectionPool;
+
+class FilingIdIndex
+{
+public:
+
+    struct FilingInfo
+    {
+        std::string data_source_;
+        std::optional<date::year_month_day> amended_date_filed_;
+    };
+
+    // ====================  LIFECYCLE     =======================================
+
+    FilingIdIndex () = default;                             // constructor
+    FilingIdIndex(const FilingIdIndex& rhs) = delete;
+    FilingIdIndex(FilingIdIndex&& rhs) = delete;
+
+    ~FilingIdIndex () = default;
+
+    // ====================  ACCESSORS     =======================================
+
+    // an empty data source matches any data source.
+
+    [[nodiscard]] std::optional<FilingInfo> Find(EM::sv cik, EM::sv base_form_type, EM::sv period_ending, EM::sv data_source = {}) const;
+    [[nodiscard]] std::optional<FilingInfo> Find(EM::sv cik, EM::sv base_form_type, date::year_month_day period_ending,
+            EM::sv data_source = {}) const;
+
+    [[nodiscard]] std::size_t size() const;
+
+    // ====================  MUTATORS      =======================================
+
+    // replaces any existing content.
+
+    void Load(DBConnectionPool& db_pool, const std::string& schema_name);
+
+    // call this after committing a new sec_filing_id row.
+    // if there is no amended date, we keep any we already have, just as our loaders do.
+
+    void Record(EM::sv cik, EM::sv base_form_type, EM::sv period_ending, EM::sv data_source, EM::sv amended_date_filed = {});
+
+    // ====================  OPERATORS     =======================================
+
+    FilingIdIndex& operator = (const FilingIdIndex& rhs) = delete;
+    FilingIdIndex& operator = (FilingIdIndex&& rhs) = delete;
+
+protected:
+    // ====================  METHODS       =======================================
+
+    // ====================  DATA MEMBERS  =======================================
+
+private:
+
+    enum class DataSource : uint8_t { e_Unknown, e_XBRL, e_XLS, e_HTML };
+
+    struct FilingEntry
+    {
+        uint64_t key_;                      // CIK and period ending
+        int32_t amended_date_filed_;        // days since epoch
+        uint16_t form_type_;                // index into form_types_
+        DataSource data_source_;
+    };
+
+    // ====================  METHODS       =======================================
+
+    [[nodiscard]] std::optional<FilingInfo> FindKey(uint64_t key, EM::sv base_form_type, EM::sv data_source) const;
+
+    [[nodiscard]] std::optional<uint16_t> FindFormType(EM::sv base_form_type) const;
+    uint16_t AddFormType(EM::sv base_form_type);
+
+    [[nodiscard]] FilingInfo MakeFilingInfo(const FilingEntry& entry) const;
+
+    void MergeRecentEntries();
+
+    // ====================  DATA MEMBERS  =======================================
+
+    // when the recent list gets this big, we merge it.
+
+    static constexpr std::size_t max_recent_entries_ = 1024;
+
+    mutable std::shared_mutex m_;
+
+    std::vector<FilingEntry> entries_;
+    std::vector<FilingEntry> recent_entries_;
+    std::vector<std::string> form_types_;
+
+}; // -----  end of class FilingIdIndex  -----
+
+#endif   // ----- #ifndef FilingIdIndex_INC  -----
@@ -85,12 +85,13 @@ HTML_FromFile::html_itor::html_itor (EM::DocumentSectionList const* document_sec
 {
     for (++current_doc_; current_doc_ < document_sections_->size(); ++current_doc_)
     {
-        html_info_.html_ = FindHTML((*document_sections_)[current_doc_], document_name_);
+        const auto& section = (*document_sections_)[current_doc_];
+        html_info_.html_ = FindHTML(section);
         if (! html_info_.html_.get().empty())
         {
-            html_info_.document_ = (*document_sections_)[current_doc_];
-            html_info_.file_name_ = FindFileName((*document_sections_)[current_doc_], document_name_);
-            html_info_.file_type_ = FindFileType((*document_sections_)[current_doc_]);
+            html_info_.document_ = section.document_;
+            html_info_.file_name_ = EM::FileName{section.file_name_};
+            html_info_.file_type_ = section.file_type_;
             return;
         }
     }
@@ -101,12 +102,13 @@ HTML_FromFile::html_itor& HTML_FromFile::html_itor::operator++ ()
 {
     for (++current_doc_; current_doc_ < document_sections_->size(); ++current_doc_)
     {
-        html_info_.html_ = FindHTML((*document_sections_)[current_doc_], document_name_);
+        const auto& section = (*document_sections_)[current_doc_];
+        html_info_.html_ = FindHTML(section);
         if (! html_info_.html_.get().empty())
         {
-            html_info_.document_ = (*document_sections_)[current_doc_];
-            html_info_.file_name_ = FindFileName((*document_sections_)[current_doc_], document_name_);
-            html_info_.file_type_ = FindFileType((*document_sections_)[current_doc_]);
+            html_info_.document_ = section.document_;
+            html_info_.file_name_ = EM::FileName{section.file_name_};
+            html_info_.file_type_ = section.file_type_;
             return *this;
         }
     }
@@ -0,0 +1,122 @@
+// =====================================================================================
+//
+//       Filename:  InternTable.cpp
+//
+//    Description:  Implementation of InternTable
+//
+//        Version:  1.0
+//        Created:  10/17/2026 09:52:08 PM
+//       Revision:  none
+//       Compiler:  g++
+//
+//         Author:  David P. Riedel (), driedel@cox.net
+//        License:  GNU General Public License -v3
+//
+// =====================================================================================
+
+#include <cstring>
+#include <utility>
+
+#include "InternTable.h"
+
+InternTable::InternTable (std::pmr::memory_resource* resource)
+    : block_resource_{resource}, strings_{resource}, handles_{resource}
+{
+}  // -----  end of method InternTable::InternTable  (constructor)  -----
+
+InternTable::InternTable (InternTable&& rhs) noexcept
+    : block_resource_{rhs.block_resource_}, blocks_{std::move(rhs.blocks_)}, next_{rhs.next_}, available_{rhs.available_},
+    strings_{std::move(rhs.strings_)}, handles_{std::move(rhs.handles_)}
+{
+    rhs.blocks_.clear();
+    rhs.next_ = nullptr;
+    rhs.available_ = 0;
+}  // -----  end of method InternTable::InternTable  (move constructor)  -----
+
+InternTable::~InternTable ()
+{
+    Release();
+}  // -----  end of method InternTable::~InternTable  (destructor)  -----
+
+/*
+ * ===  FUNCTION  ======================================================================
+ *         Name:  InternTable::operator=
+ *  Description:  if our resources differ, our containers copy rhs's views but that's
+ *                fine since the blocks they point into are ours now.
+ * =====================================================================================
+ */
+InternTable& InternTable::operator= (InternTable&& rhs) noexcept
+{
+    if (this != &rhs)
+    {
+        Release();
+        block_resource_ = rhs.block_resource_;
+        blocks_ = std::move(rhs.blocks_);
+        next_ = std::exchange(rhs.next_, nullptr);
+        available_ = std::exchange(rhs.available_, 0);
+        strings_ = std::move(rhs.strings_);
+        handles_ = std::move(rhs.handles_);
+        rhs.blocks_.clear();
+        rhs.strings_.clear();
+        rhs.handles_.clear();
+    }
+    return *this;
+}		// -----  end of method InternTable::operator=  -----
+
+InternTable::Handle InternTable::Intern (std::string_view text)
+{
+    if (auto found = handles_.find(text); found != handles_.end())
+    {
+        return found->second;
+    }
+    const auto handle = static_cast<Handle>(strings_.size());
+    auto stored = Store(text);
+    strings_.push_back(stored);
+    handles_.emplace(stored, handle);
+    return handle;
+}		// -----  end of method InternTable::Intern  -----
+
+std::string_view InternTable::Store (std::string_view text)
+{
+    if (text.empty())
+    {
+        return {};
+    }
+    if (text.size() > block_size_ / 4)
+    {
+        // leave the current block as it is. There may be plenty of room left in it.
+
+        char* own_block = AllocateBlock(text.size());
+        std::memcpy(own_block, text.data(), text.size());
+        return {own_block, text.size()};
+    }
+    if (text.size() > available_)
+    {
+        next_ = AllocateBlock(block_size_);
+        available_ = block_size_;
+    }
+    std::memcpy(next_, text.data(), text.size());
+    std::string_view result{next_, text.size()};
+    next_ += text.size();
+    available_ -= text.size();
+    return result;
+}		// -----  end of method InternTable::Store  -----
+
+char* InternTable::AllocateBlock (std::size_t size)
+{
+    blocks_.reserve(blocks_.size() + 1);
+    auto* data = static_cast<char*>(block_resource_->allocate(size, 1));
+    blocks_.push_back({data, size});
+    return data;
+}		// -----  end of method InternTable::AllocateBlock  -----
+
+void InternTable::Release ()
+{
+    for (auto [data, size] : blocks_)
+    {
+        block_resource_->deallocate(data, size, 1);
+    }
+    blocks_.clear();
+    next_ = nullptr;
+    available_ = 0;
+}		// -----  end of method InternTable::Release  -----
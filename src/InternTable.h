@@ -0,0 +1,113 @@
+// =====================================================================================
+//
+//       Filename:  InternTable.h
+//
+//    Description:  Keep 1 copy of each distinct string and hand out small handles to it
+//
+//        Version:  1.0
+//        Created:  10/17/2026 09:52:08 PM
+//       Revision:  none
+//       Compiler:  g++
+//
+//         Author:  David P. Riedel (), driedel@cox.net
+//        License:  GNU General Public License -v3
+//
+// =====================================================================================
+
+
+// =====================================================================================
+//        Class:  InternTable
+//  Description:  Text is copied into large blocks which never move so a string_view
+//                we give out stays good for as long as the table lives, even if the
+//                table itself is moved.  Interned strings are kept once and named
+//                by their position.  Stored strings are just copied.
+//
+//                Everything comes from the memory resource we are given, normally
+//                the filing's arena.
+//
+//                Not thread safe.  Each filing has its own table.
+// =====================================================================================
+
+
+#ifndef  InternTable_INC
+#define  InternTable_INC
+
+#include <cstdint>
+#include <memory_resource>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+class InternTable
+{
+public:
+
+    using Handle = uint32_t;
+
+    // ====================  LIFECYCLE     =======================================
+
+    explicit InternTable (std::pmr::memory_resource* resource = std::pmr::get_default_resource());     // constructor
+    InternTable(const InternTable& rhs) = delete;
+    InternTable(InternTable&& rhs) noexcept;
+
+    ~InternTable ();
+
+    // ====================  ACCESSORS     =======================================
+
+    [[nodiscard]] std::string_view operator[](Handle handle) const { return strings_[handle]; }
+
+    // number of distinct interned strings. Handles run from 0 to size() - 1.
+
+    [[nodiscard]] std::size_t size() const { return strings_.size(); }
+
+    // ====================  MUTATORS      =======================================
+
+    Handle Intern(std::string_view text);
+
+    // for text which is rarely repeated.
+
+    std::string_view Store(std::string_view text);
+
+    // ====================  OPERATORS     =======================================
+
+    InternTable& operator = (const InternTable& rhs) = delete;
+    InternTable& operator = (InternTable&& rhs) noexcept;
+
+protected:
+    // ====================  METHODS       =======================================
+
+    // ====================  DATA MEMBERS  =======================================
+
+private:
+
+    struct Block
+    {
+        char* data_;
+        std::size_t size_;
+    };
+
+    // ====================  METHODS       =======================================
+
+    char* AllocateBlock(std::size_t size);
+    void Release();
+
+    // ====================  DATA MEMBERS  =======================================
+
+    // anything bigger than a quarter of this gets a block of its own.
+
+    static constexpr std::size_t block_size_ = 32 * 1024;
+
+    // our blocks go wherever our text goes so they keep track of
+    // where they came from.
+
+    std::pmr::memory_resource* block_resource_;
+    std::vector<Block> blocks_;
+    char* next_ = nullptr;
+    std::size_t available_ = 0;
+
+    std::pmr::vector<std::string_view> strings_;
+    std::pmr::unordered_map<std::string_view, Handle> handles_;
+
+}; // -----  end of class InternTable  -----
+
+#endif   // ----- #ifndef InternTable_INC  -----
@@ -0,0 +1,222 @@
+// =====================================================================================
+//
+//       Filename:  MappedFile.cpp
+//
+//    Description:  Implementation of MappedFile
+//
+//        Version:  1.0
+//        Created:  10/17/2026 09:31:05 AM
+//       Revision:  none
+//       Compiler:  g++
+//
+//         Author:  David P. Riedel (), driedel@cox.net
+//        License:  GNU General Public License -v3
+//
+// =====================================================================================
+
+#include <cerrno>
+#include <system_error>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "MappedFile.h"
+#include "Extractor_Utils.h"
+
+// a small helper so we don't leak file descriptors when we throw.
+
+namespace
+{
+    class FileDescriptor
+    {
+    public:
+        explicit FileDescriptor(int fd) : fd_{fd} {}
+        ~FileDescriptor() { if (fd_ >= 0) { ::close(fd_); } }
+        FileDescriptor(const FileDescriptor& rhs) = delete;
+        FileDescriptor& operator=(const FileDescriptor& rhs) = delete;
+
+        [[nodiscard]] int get() const { return fd_; }
+
+    private:
+        int fd_;
+    };
+}
+
+//--------------------------------------------------------------------------------------
+//       Class:  MappedFile
+//      Method:  MappedFile
+// Description:  constructor
+//--------------------------------------------------------------------------------------
+MappedFile::MappedFile (const EM::FileName& file_name)
+{
+    FileDescriptor fd{::open(file_name.get().c_str(), O_RDONLY | O_CLOEXEC)};
+    if (fd.get() < 0)
+    {
+        throw std::system_error(errno, std::generic_category(), catenate("Unable to open file: ", file_name.get().string()));
+    }
+
+    struct stat file_info{};
+    if (::fstat(fd.get(), &file_info) != 0)
+    {
+        throw std::system_error(errno, std::generic_category(), catenate("Unable to stat file: ", file_name.get().string()));
+    }
+
+    // pipes, FIFOs and the like can't be mapped and report no useful size
+    // so we just read them.  Same for empty files since mmap rejects a 0 length.
+
+    if (! S_ISREG(file_info.st_mode) || file_info.st_size == 0)
+    {
+        ReadFileContent(fd.get(), file_name);
+        return;
+    }
+
+    size_ = static_cast<std::size_t>(file_info.st_size);
+    void* mapped = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd.get(), 0);
+    if (mapped == MAP_FAILED)
+    {
+        // some file systems don't support mapping. Fall back to reading.
+
+        size_ = 0;
+        ReadFileContent(fd.get(), file_name);
+        return;
+    }
+
+    // we read our files front to back so let the kernel know.
+    // this is only advice so we don't care if it fails.
+
+    ::madvise(mapped, size_, MADV_SEQUENTIAL);
+
+    data_ = static_cast<const char*>(mapped);
+    is_mapped_ = true;
+}  // -----  end of method MappedFile::MappedFile  (constructor)  -----
+
+MappedFile::MappedFile (MappedFile&& rhs) noexcept
+    : buffer_{std::move(rhs.buffer_)}, data_{rhs.data_}, size_{rhs.size_}, is_mapped_{rhs.is_mapped_}
+{
+    // small strings live inside the string object so we need to re-point.
+
+    if (! is_mapped_)
+    {
+        data_ = buffer_.data();
+    }
+    rhs.data_ = nullptr;
+    rhs.size_ = 0;
+    rhs.is_mapped_ = false;
+}  // -----  end of method MappedFile::MappedFile  (constructor)  -----
+
+MappedFile::~MappedFile ()
+{
+    Release();
+}		// -----  end of method MappedFile::~MappedFile  -----
+
+MappedFile& MappedFile::operator= (MappedFile&& rhs) noexcept
+{
+    if (this != &rhs)
+    {
+        Release();
+
+        buffer_ = std::move(rhs.buffer_);
+        size_ = rhs.size_;
+        is_mapped_ = rhs.is_mapped_;
+        data_ = is_mapped_ ? rhs.data_ : buffer_.data();
+
+        rhs.data_ = nullptr;
+        rhs.size_ = 0;
+        rhs.is_mapped_ = false;
+    }
+    return *this;
+}		// -----  end of method MappedFile::operator=  -----
+
+/*
+ * ===  FUNCTION  ======================================================================
+ *         Name:  MappedFile::ReadFileContent
+ *  Description:  read until EOF. We can't trust st_size for non-regular files.
+ * =====================================================================================
+ */
+void MappedFile::ReadFileContent (int fd, const EM::FileName& file_name)
+{
+    constexpr std::size_t read_chunk_size{64 * 1024};
+
+    std::size_t bytes_read{0};
+    while (true)
+    {
+        buffer_.resize(bytes_read + read_chunk_size);
+        auto result = ::read(fd, buffer_.data() + bytes_read, read_chunk_size);
+        if (result == 0)
+        {
+            break;
+        }
+        if (result < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            throw std::system_error(errno, std::generic_category(), catenate("Unable to read file: ", file_name.get().string()));
+        }
+        bytes_read += result;
+    }
+    buffer_.resize(bytes_read);
+
+    data_ = buffer_.data();
+    size_ = buffer_.size();
+    is_mapped_ = false;
+}		// -----  end of method MappedFile::ReadFileContent  -----
+
+/*
+ * ===  FUNCTION  ======================================================================
+ *         Name:  MappedFile::ReadFilePrefix
+ *  Description:
+ * =====================================================================================
+ */
+std::string MappedFile::ReadFilePrefix (const EM::FileName& file_name, std::size_t max_bytes)
+{
+    FileDescriptor fd{::open(file_name.get().c_str(), O_RDONLY | O_CLOEXEC)};
+    if (fd.get() < 0)
+    {
+        throw std::system_error(errno, std::generic_category(), catenate("Unable to open file: ", file_name.get().string()));
+    }
+
+    std::string prefix(max_bytes, '\0');
+    std::size_t bytes_read{0};
+    while (bytes_read < max_bytes)
+    {
+        auto result = ::read(fd.get(), prefix.data() + bytes_read, max_bytes - bytes_read);
+        if (result == 0)
+        {
+            break;
+        }
+        if (result < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            throw std::system_error(errno, std::generic_category(), catenate("Unable to read file: ", file_name.get().string()));
+        }
+        bytes_read += result;
+    }
+    prefix.resize(bytes_read);
+    return prefix;
+}		// -----  end of method MappedFile::ReadFilePrefix  -----
+
+/*
+ * ===  FUNCTION  ======================================================================
+ *         Name:  MappedFile::Release
+ *  Description:
+ * =====================================================================================
+ */
+void MappedFile::Release ()
+{
+    if (is_mapped_ && data_ != nullptr)
+    {
+        ::munmap(const_cast<char*>(data_), size_);
+    }
+    buffer_.clear();
+    data_ = nullptr;
+    size_ = 0;
+    is_mapped_ = false;
+}		// -----  end of method MappedFile::Release  -----
@@ -0,0 +1,92 @@
+// =====================================================================================
+//
+//       Filename:  MappedFile.h
+//
+//    Description:  Class to own the content of an input file for the duration of
+//                  its processing. Regular files are memory mapped. Anything else
+//                  (pipes, FIFOs, character devices) is read into memory.
+//
+//        Version:  1.0
+//        Created:  10/17/2026 09:12:44 AM
+//       Revision:  none
+//       Compiler:  g++
+//
+//         Author:  David P. Riedel (), driedel@cox.net
+//        License:  GNU General Public License -v3
+//
+// =====================================================================================
+
+// =====================================================================================
+//        Class:  MappedFile
+//  Description:  Move-only owner of a file's content.
+//
+//                We map the file read-only and tell the kernel we will be reading it
+//                sequentially so it can read ahead aggressively.  The file is never
+//                copied into user space.  Everything downstream works with string_views
+//                into the mapping so the MappedFile must outlive all of them.
+// =====================================================================================
+
+
+#ifndef  MappedFile_INC
+#define  MappedFile_INC
+
+#include <cstddef>
+#include <string>
+
+#include "Extractor.h"
+
+class MappedFile
+{
+public:
+    // ====================  LIFECYCLE     =======================================
+
+    MappedFile () = default;                             // constructor
+    explicit MappedFile (const EM::FileName& file_name);
+    MappedFile(const MappedFile& rhs) = delete;
+    MappedFile(MappedFile&& rhs) noexcept;
+
+    ~MappedFile ();
+
+    // ====================  ACCESSORS     =======================================
+
+    [[nodiscard]] EM::FileContent GetContent() const { return EM::FileContent{EM::sv{data_, size_}}; }
+    [[nodiscard]] std::size_t size() const { return size_; }
+    [[nodiscard]] bool empty() const { return size_ == 0; }
+    [[nodiscard]] bool IsMapped() const { return is_mapped_; }
+
+    // just the first 'max_bytes' of a file (or all of it if it is shorter).
+    // we don't map the file for this so the kernel doesn't read ahead for us.
+
+    [[nodiscard]] static std::string ReadFilePrefix(const EM::FileName& file_name, std::size_t max_bytes);
+
+    // ====================  MUTATORS      =======================================
+
+    // ====================  OPERATORS     =======================================
+
+    MappedFile& operator = (const MappedFile& rhs) = delete;
+    MappedFile& operator = (MappedFile&& rhs) noexcept;
+
+protected:
+    // ====================  METHODS       =======================================
+
+    // ====================  DATA MEMBERS  =======================================
+
+private:
+    // ====================  METHODS       =======================================
+
+    void ReadFileContent(int fd, const EM::FileName& file_name);
+    void Release();
+
+    // ====================  DATA MEMBERS  =======================================
+
+    // when we can't map the file, this holds its content.
+
+    std::string buffer_;
+
+    const char* data_ = nullptr;
+    std::size_t size_ = 0;
+    bool is_mapped_ = false;
+
+}; // -----  end of class MappedFile  -----
+
+#endif   // ----- #ifndef MappedFile_INC  -----
@@ -0,0 +1,156 @@
+// =====================================================================================
+//
+//       Filename:  RegexRegistry.cpp
+//
+//    Description:  Implementation of RegexRegistry
+//
+//        Version:  1.0
+//        Created:  10/17/2026 11:41:37 PM
+//       Revision:  none
+//       Compiler:  g++
+//
+//         Author:  David P. Riedel (), driedel@cox.net
+//        License:  GNU General Public License -v3
+//
+// =====================================================================================
+
+#include "spdlog/spdlog.h"
+
+#include "CoverPageMatchers.h"
+#include "Extractor_Utils.h"
+#include "RegexRegistry.h"
+
+namespace
+{
+    struct PatternDefinition
+    {
+        RegexId id_;
+        EM::sv name_;
+        const char* pattern_;
+        boost::regex::flag_type flags_;
+        CountedRegex::LinearMatcher linear_matcher_ = nullptr;
+    };
+
+    constexpr boost::regex::flag_type ICASE = boost::regex_constants::normal | boost::regex_constants::icase;
+
+    // everything in 1 place so we can see what we are paying for.
+
+    const PatternDefinition PATTERNS[]
+    {
+        {RegexId::e_SharesOutstanding, "shares outstanding",
+            R"***((\b[1-9](?:[0-9]{0,2})(?:,[0-9]{3})+\b))***", ICASE},
+        {RegexId::e_XLSSharesOutstanding, "XLS shares outstanding",
+            R"***(\t(\b[1-9](?:[0-9.]{2,})\b)\t)***", ICASE},
+        {RegexId::e_CoverPageShares, "cover page shares",
+            R"***((?:\bshares|outstanding|common\b))***", ICASE},
+        {RegexId::e_CoverPageNumber, "cover page number",
+            R"***((?:\bshares|outstanding|number\b))***", ICASE},
+        {RegexId::e_CoverPageMarketValue, "cover page market value",
+            R"***(\bmarket value\b)***", ICASE},
+        {RegexId::e_CoverPageYesNo, "cover page yes/no",
+            R"***(\byes\b.{1,10}?no.{1,1000}?\b[1-9](?:[0-9]{0,2})(?:,[0-9]{3})+\b)***", ICASE, FindYesNoShares},
+        {RegexId::e_CoverPageIndicator, "cover page indicator",
+            R"***((?:\binidcate\b|\bas of \b|\bnumber of\b).{1,200}?\b[1-9](?:[0-9]{0,2})(?:,[0-9]{3})+\b(?:.{1,100}?(?:shares|common|outstanding))?)***", ICASE, FindIndicatorShares},
+        {RegexId::e_NumberWithCommas, "number with commas",
+            R"***(([1-9](?:[0-9]{0,2})(?:,[0-9]{3})+))***", boost::regex_constants::normal},
+        {RegexId::e_DollarNumber, "dollar number",
+            R"***(\$ *\b[1-9](?:[0-9]{0,2})(?:,[0-9]{3})+\b)***", boost::regex_constants::normal}
+    };
+}
+
+std::atomic<bool> CountedRegex::counting_ = false;
+
+CountedRegex::CountedRegex (EM::sv name, const char* pattern, boost::regex::flag_type flags, LinearMatcher linear_matcher)
+    : name_{name}, regex_{pattern, flags}, linear_matcher_{linear_matcher}, use_linear_matcher_{linear_matcher != nullptr}
+{
+}  // -----  end of method CountedRegex::CountedRegex  (constructor)  -----
+
+CountedRegex::UseCounter CountedRegex::CountUse (std::size_t bytes) const
+{
+    if (! counting_.load(std::memory_order_relaxed))
+    {
+        return UseCounter{nullptr};
+    }
+    calls_.fetch_add(1, std::memory_order_relaxed);
+    bytes_.fetch_add(bytes, std::memory_order_relaxed);
+    return UseCounter{this};
+}		// -----  end of method CountedRegex::CountUse  -----
+
+std::vector<EM::sv> CountedRegex::FindAll (EM::sv text) const
+{
+    auto counter = CountUse(text.size());
+
+    std::vector<EM::sv> matches;
+    if (use_linear_matcher_.load(std::memory_order_relaxed))
+    {
+        linear_matcher_(text, matches);
+        return matches;
+    }
+    boost::cregex_iterator regex_matches(text.begin(), text.end(), regex_);
+    std::for_each(regex_matches, boost::cregex_iterator{}, [&matches] (const boost::cmatch& m)
+        {
+            matches.emplace_back(m[0].first, m.length());
+        });
+    return matches;
+}		// -----  end of method CountedRegex::FindAll  -----
+
+CountedRegex::UseCounter::~UseCounter ()
+{
+    if (regex_ != nullptr)
+    {
+        auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start_);
+        regex_->nanoseconds_.fetch_add(elapsed.count(), std::memory_order_relaxed);
+    }
+}  // -----  end of method CountedRegex::UseCounter::~UseCounter  (destructor)  -----
+
+RegexRegistry::RegexRegistry ()
+{
+    for (const auto& [id, name, pattern, flags, linear_matcher] : PATTERNS)
+    {
+        BOOST_ASSERT_MSG(static_cast<std::size_t>(id) == patterns_.size(), catenate("Regex: ", name, " is out of order.").c_str());
+        patterns_.emplace_back(name, pattern, flags, linear_matcher);
+    }
+}  // -----  end of method RegexRegistry::RegexRegistry  (constructor)  -----
+
+const RegexRegistry& RegexRegistry::Instance ()
+{
+    static const RegexRegistry registry;
+    return registry;
+}		// -----  end of method RegexRegistry::Instance  -----
+
+const CountedRegex& RegexRegistry::Get (RegexId id)
+{
+    return Instance().patterns_[static_cast<std::size_t>(id)];
+}		// -----  end of method RegexRegistry::Get  -----
+
+void RegexRegistry::Initialize ()
+{
+    Instance();
+}		// -----  end of method RegexRegistry::Initialize  -----
+
+void RegexRegistry::UseLinearMatcher (RegexId id, bool use_it)
+{
+    const auto& pattern = Get(id);
+    pattern.use_linear_matcher_.store(use_it && pattern.HasLinearMatcher(), std::memory_order_relaxed);
+}		// -----  end of method RegexRegistry::UseLinearMatcher  -----
+
+void RegexRegistry::UseLinearMatchers (bool use_them)
+{
+    for (const auto& pattern : Instance().patterns_)
+    {
+        pattern.use_linear_matcher_.store(use_them && pattern.HasLinearMatcher(), std::memory_order_relaxed);
+    }
+}		// -----  end of method RegexRegistry::UseLinearMatchers  -----
+
+void RegexRegistry::LogCounters ()
+{
+    for (const auto& pattern : Instance().patterns_)
+    {
+        if (pattern.calls() == 0)
+        {
+            continue;
+        }
+        spdlog::info(catenate("Regex: ", pattern.name(), ". Calls: ", pattern.calls(), ". Bytes: ", pattern.bytes(),
+                    ". Microseconds: ", pattern.nanoseconds() / 1'000, "."));
+    }
+}		// -----  end of method RegexRegistry::LogCounters  -----
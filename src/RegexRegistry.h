@@ -0,0 +1,212 @@
+// =====================================================================================
+//
+//       Filename:  RegexRegistry.h
+//
+//    Description:  The regexes our hot paths use, each compiled once, with optional
+//                  usage counters
+//
+//        Version:  1.0
+//        Created:  10/17/2026 11:41:37 PM
+//       Revision:  none
+//       Compiler:  g++
+//
+//         Author:  David P. Riedel (), driedel@cox.net
+//        License:  GNU General Public License -v3
+//
+// =====================================================================================
+
+
+// =====================================================================================
+//        Class:  RegexRegistry
+//  Description:  Every pattern is compiled when the registry is first used.  A compiled
+//                boost::regex may be searched by any number of threads at once so
+//                nobody needs their own copy.
+//
+//                When counting is turned on, each pattern keeps track of how often it
+//                is used, how much text it looks at and how long that takes.  With it
+//                off, all a use costs is 1 relaxed atomic load.
+//
+//                A pattern which can backtrack badly may also have a hand written
+//                matcher which finds the same matches in linear time.  FindAll uses it
+//                unless we are told to stick with the regex.
+// =====================================================================================
+
+
+#ifndef  RegexRegistry_INC
+#define  RegexRegistry_INC
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include <boost/regex.hpp>
+
+#include "Extractor.h"
+
+enum class RegexId : uint8_t
+{
+    e_SharesOutstanding,            // a number with commas
+    e_XLSSharesOutstanding,         // a number in its own cell
+    e_CoverPageShares,
+    e_CoverPageNumber,
+    e_CoverPageMarketValue,
+    e_CoverPageYesNo,
+    e_CoverPageIndicator,
+    e_NumberWithCommas,
+    e_DollarNumber
+};
+
+class CountedRegex
+{
+public:
+
+    // appends every match, as boost::regex_iterator would find them.
+
+    using LinearMatcher = void(*)(EM::sv text, std::vector<EM::sv>& matches);
+
+    // times 1 use of its pattern until it goes away.
+
+    class UseCounter
+    {
+    public:
+
+        explicit UseCounter(const CountedRegex* regex)
+            : regex_{regex}, start_{regex == nullptr ? std::chrono::steady_clock::time_point{} : std::chrono::steady_clock::now()} {}
+        UseCounter(const UseCounter& rhs) = delete;
+        UseCounter& operator = (const UseCounter& rhs) = delete;
+
+        ~UseCounter();
+
+    private:
+
+        const CountedRegex* regex_;
+        std::chrono::steady_clock::time_point start_;
+    };
+
+    // ====================  LIFECYCLE     =======================================
+
+    CountedRegex (EM::sv name, const char* pattern, boost::regex::flag_type flags, LinearMatcher linear_matcher);    // constructor
+    CountedRegex(const CountedRegex& rhs) = delete;
+    CountedRegex(CountedRegex&& rhs) = delete;
+
+    ~CountedRegex () = default;
+
+    // ====================  ACCESSORS     =======================================
+
+    [[nodiscard]] const boost::regex& get() const { return regex_; }
+    [[nodiscard]] const std::string& name() const { return name_; }
+
+    [[nodiscard]] uint64_t calls() const { return calls_.load(std::memory_order_relaxed); }
+    [[nodiscard]] uint64_t bytes() const { return bytes_.load(std::memory_order_relaxed); }
+    [[nodiscard]] uint64_t nanoseconds() const { return nanoseconds_.load(std::memory_order_relaxed); }
+
+    // counts 1 use looking at 'bytes' of text.  Keep what is returned as long as the use lasts.
+
+    [[nodiscard]] UseCounter CountUse(std::size_t bytes) const;
+
+    template<typename BidiIter>
+    bool Search(BidiIter begin, BidiIter end) const
+    {
+        auto counter = CountUse(std::distance(begin, end));
+        return boost::regex_search(begin, end, regex_);
+    }
+
+    template<typename BidiIter>
+    bool Search(BidiIter begin, BidiIter end, boost::match_results<BidiIter>& match) const
+    {
+        auto counter = CountUse(std::distance(begin, end));
+        return boost::regex_search(begin, end, match, regex_);
+    }
+
+    [[nodiscard]] std::string Replace(const std::string& text, const std::string& format) const
+    {
+        auto counter = CountUse(text.size());
+        return boost::regex_replace(text, regex_, format);
+    }
+
+    [[nodiscard]] std::vector<EM::sv> FindAll(EM::sv text) const;
+
+    [[nodiscard]] bool HasLinearMatcher() const { return linear_matcher_ != nullptr; }
+
+    // ====================  MUTATORS      =======================================
+
+    // ====================  OPERATORS     =======================================
+
+    CountedRegex& operator = (const CountedRegex& rhs) = delete;
+    CountedRegex& operator = (CountedRegex&& rhs) = delete;
+
+private:
+
+    friend class RegexRegistry;
+
+    // ====================  DATA MEMBERS  =======================================
+
+    static std::atomic<bool> counting_;
+
+    std::string name_;
+    boost::regex regex_;
+    LinearMatcher linear_matcher_;
+    mutable std::atomic<bool> use_linear_matcher_;
+
+    mutable std::atomic<uint64_t> calls_ = 0;
+    mutable std::atomic<uint64_t> bytes_ = 0;
+    mutable std::atomic<uint64_t> nanoseconds_ = 0;
+
+}; // -----  end of class CountedRegex  -----
+
+class RegexRegistry
+{
+public:
+
+    // ====================  LIFECYCLE     =======================================
+
+    RegexRegistry(const RegexRegistry& rhs) = delete;
+    RegexRegistry(RegexRegistry&& rhs) = delete;
+
+    ~RegexRegistry () = default;
+
+    // ====================  ACCESSORS     =======================================
+
+    [[nodiscard]] static const CountedRegex& Get(RegexId id);
+
+    // writes the counters of every pattern which was used to the log.
+
+    static void LogCounters();
+
+    // ====================  MUTATORS      =======================================
+
+    // compiles everything now rather than on first use.
+
+    static void Initialize();
+
+    static void CountUses(bool count) { CountedRegex::counting_.store(count, std::memory_order_relaxed); }
+
+    // only matters for patterns which have a linear matcher.
+
+    static void UseLinearMatcher(RegexId id, bool use_it);
+    static void UseLinearMatchers(bool use_them);
+
+    // ====================  OPERATORS     =======================================
+
+    RegexRegistry& operator = (const RegexRegistry& rhs) = delete;
+    RegexRegistry& operator = (RegexRegistry&& rhs) = delete;
+
+private:
+
+    RegexRegistry ();                             // constructor
+
+    static const RegexRegistry& Instance();
+
+    // ====================  DATA MEMBERS  =======================================
+
+    // in RegexId order. A deque since our patterns can't move.
+
+    std::deque<CountedRegex> patterns_;
+
+}; // -----  end of class RegexRegistry  -----
+
+#endif   // ----- #ifndef RegexRegistry_INC  -----
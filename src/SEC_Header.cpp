@@ -33,135 +33,310 @@
 
 #include "SEC_Header.h"
 
-#include <boost/regex.hpp>
+#include <algorithm>
+#include <cctype>
+#include <charconv>
 
-#include <range/v3/action/transform.hpp>
-
-#include "date/date.h"
+#include "fmt/format.h"
 
 #include "Extractor_Utils.h"
 
-//--------------------------------------------------------------------------------------
-//       Class:  SEC_Header
-//      Method:  SEC_Header
-// Description:  constructor
-//--------------------------------------------------------------------------------------
-
-void SEC_Header::UseData (EM::FileContent file_content)
-{
-    const boost::regex regex_SEC_header{R"***(^<SEC-HEADER>.+?</SEC-HEADER>$)***"};
-	boost::cmatch results;
-
-	bool found_it = boost::regex_search(file_content.get().cbegin(), file_content.get().cend(), results, regex_SEC_header);
-    BOOST_ASSERT_MSG(found_it, "Can't find SEC Header");
-
-    header_data_ = EM::sv(results[0].first, results[0].length());
-}		// -----  end of method SEC_Header::UseData  -----
-
-void SEC_Header::ExtractHeaderFields ()
-{
-	ExtractCIK();
-	ExtractSIC();
-	ExtractFormType();
-	ExtractDateFiled();
-	ExtractQuarterEnding();
-	ExtractFileName();
-	ExtractCompanyName();
-}		// -----  end of method SEC_Header::ExtractHeaderFields  -----
-
-void SEC_Header::ExtractCIK ()
+namespace
 {
-	const boost::regex ex{R"***(^\s+CENTRAL INDEX KEY:\s+([0-9]+$))***"};
+    // the header labels we look for.  Labels for the filer's company data are
+    // indented. The others start at the beginning of the line.
 
-	boost::cmatch results;
-	bool found_it = boost::regex_search(header_data_.cbegin(), header_data_.cend(), results, ex);
+    constexpr EM::sv ACCESSION_NUMBER{"ACCESSION NUMBER:"};
+    constexpr EM::sv SUBMISSION_TYPE{"CONFORMED SUBMISSION TYPE:"};
+    constexpr EM::sv PERIOD_OF_REPORT{"CONFORMED PERIOD OF REPORT:"};
+    constexpr EM::sv DATE_FILED{"FILED AS OF DATE:"};
+    constexpr EM::sv COMPANY_NAME{"COMPANY CONFORMED NAME:"};
+    constexpr EM::sv CENTRAL_INDEX_KEY{"CENTRAL INDEX KEY:"};
+    constexpr EM::sv SIC_CODE{"STANDARD INDUSTRIAL CLASSIFICATION:"};
 
-    BOOST_ASSERT_MSG(found_it, "Can't find CIK in SEC Header");
+    constexpr EM::sv WHITE_SPACE{" \t\r"};
 
-	parsed_header_data_["cik"] = results.str(1);
-}		// -----  end of method SEC_Header::ExtractCIK  -----
-
-void SEC_Header::ExtractSIC ()
-{
-	// this field is sometimes missing in my test files.  I can live without it.
+    EM::sv Trim(EM::sv text)
+    {
+        auto first = text.find_first_not_of(WHITE_SPACE);
+        if (first == EM::sv::npos)
+        {
+            return {};
+        }
+        auto last = text.find_last_not_of(WHITE_SPACE);
+        return text.substr(first, last - first + 1);
+    }
 
-	const boost::regex ex{R"***(^\s+STANDARD INDUSTRIAL CLASSIFICATION:.+?\[?([0-9]+)\]?)***"};
+    bool AllDigits(EM::sv text, EM::sv allowed_extras = {})
+    {
+        return ! text.empty() && std::all_of(text.begin(), text.end(), [allowed_extras] (char c)
+            {
+                return std::isdigit(static_cast<unsigned char>(c)) || allowed_extras.find(c) != EM::sv::npos;
+            });
+    }
 
-	boost::cmatch results;
-	bool found_it = boost::regex_search(header_data_.cbegin(), header_data_.cend(), results, ex);
+    // header dates are yyyymmdd.
 
-	if (found_it)
+    date::year_month_day ParseHeaderDate(EM::sv value, const char* which_date)
     {
-		parsed_header_data_["sic"] = results.str(1);
+        int year{0};
+        unsigned month{0};
+        unsigned day{0};
+        bool parsed = value.size() == 8 && AllDigits(value);
+        if (parsed)
+        {
+            std::from_chars(value.data(), value.data() + 4, year);
+            std::from_chars(value.data() + 4, value.data() + 6, month);
+            std::from_chars(value.data() + 6, value.data() + 8, day);
+        }
+        date::year_month_day result{date::year{year}, date::month{month}, date::day{day}};
+        BOOST_ASSERT_MSG(parsed && result.ok(), catenate("Invalid '", which_date, "' in SEC Header: ", value).c_str());
+        return result;
     }
-	else
+
+    std::string FormatDate(date::year_month_day a_date)
     {
-		parsed_header_data_["sic"] = "unknown";
+        return fmt::format("{:04}-{:02}-{:02}", static_cast<int>(a_date.year()), static_cast<unsigned>(a_date.month()),
+                static_cast<unsigned>(a_date.day()));
     }
-}		// -----  end of method SEC_Header::ExtractSIC  -----
-
-void SEC_Header::ExtractFormType ()
-{
-	const boost::regex ex{R"***(^CONFORMED SUBMISSION TYPE:\s+(.+?)$)***", boost::regex_constants::match_not_dot_newline};
 
-	boost::cmatch results;
-	bool found_it = boost::regex_search(header_data_.cbegin(), header_data_.cend(), results, ex);
+    SEC_HeaderRecord::FormType ClassifyFormType(EM::sv form_type)
+    {
+        if (form_type == "10-Q")
+        {
+            return SEC_HeaderRecord::FormType::e_10_Q;
+        }
+        if (form_type == "10-K")
+        {
+            return SEC_HeaderRecord::FormType::e_10_K;
+        }
+        if (form_type == "10-Q_A")
+        {
+            return SEC_HeaderRecord::FormType::e_10_Q_A;
+        }
+        if (form_type == "10-K_A")
+        {
+            return SEC_HeaderRecord::FormType::e_10_K_A;
+        }
+        return SEC_HeaderRecord::FormType::e_Other;
+    }
 
-    BOOST_ASSERT_MSG(found_it, "Can't find 'form type' in SEC Header");
+    // prefer the code in brackets at the end of the description.
 
-    // since we use form type as part of our file name for forms stored on disk,
-    // we can't have the '/' character in it.  Our Collect program replaces the '/' with '_'
-    // so we do the same here.
+    std::optional<EM::sv> FindSICCode(EM::sv value)
+    {
+        if (auto open_bracket = value.rfind('['); open_bracket != EM::sv::npos)
+        {
+            auto code = value.substr(open_bracket + 1);
+            code = code.substr(0, code.find(']'));
+            if (AllDigits(code))
+            {
+                return code;
+            }
+        }
+        auto first_digit = value.find_first_of("0123456789");
+        if (first_digit == EM::sv::npos)
+        {
+            return std::nullopt;
+        }
+        auto code = value.substr(first_digit);
+        return code.substr(0, code.find_first_not_of("0123456789"));
+    }
+}
 
-	parsed_header_data_["form_type"] = results.str(1) | ranges::actions::transform([](unsigned char c) { return (c == '/' ? '_' : std::toupper(c)); });
-}		// -----  end of method SEC_Header::ExtractFormNumber  -----
+//--------------------------------------------------------------------------------------
+//       Class:  SEC_Header
+//      Method:  SEC_Header
+// Description:  constructor
+//--------------------------------------------------------------------------------------
 
-void SEC_Header::ExtractDateFiled ()
+void SEC_Header::UseData (EM::FileContent file_content)
 {
-	const boost::regex ex{R"***(^FILED AS OF DATE:\s+([0-9]+?)$)***"};
-
-	boost::cmatch results;
-	bool found_it = boost::regex_search(header_data_.cbegin(), header_data_.cend(), results, ex);
-
-    BOOST_ASSERT_MSG(found_it, "Can't find 'date filed' in SEC Header");
+    auto header = FindHeader(file_content.get());
+    BOOST_ASSERT_MSG(header, "Can't find SEC Header");
 
-	auto the_date = StringToDateYMD("%Y%m%d", results.str(1));
-	parsed_header_data_["date_filed"] = date::format("%F", the_date);
-}		// -----  end of method SEC_Header::ExtractDateFiled  -----
+    header_data_ = header.value();
+    parsed_header_data_.reset();
+}		// -----  end of method SEC_Header::UseData  -----
 
-void SEC_Header::ExtractQuarterEnding ()
+/*
+ * ===  FUNCTION  ======================================================================
+ *         Name:  SEC_Header::FindHeader
+ *  Description:  the header tags are on lines by themselves.
+ * =====================================================================================
+ */
+std::optional<EM::sv> SEC_Header::FindHeader (EM::sv content)
 {
-	const boost::regex ex{R"***(^CONFORMED PERIOD OF REPORT:\s+([0-9]+?)$)***"};
-
-	boost::cmatch results;
-	bool found_it = boost::regex_search(header_data_.cbegin(), header_data_.cend(), results, ex);
+    const EM::sv header_start{"<SEC-HEADER>"};
+    const EM::sv header_end{"</SEC-HEADER>"};
 
-    BOOST_ASSERT_MSG(found_it, "Can't find 'quarter ending' in SEC Header");
+    auto start = content.find(header_start);
+    while (start != EM::sv::npos && start != 0 && content[start - 1] != '\n')
+    {
+        start = content.find(header_start, start + header_start.size());
+    }
+    if (start == EM::sv::npos)
+    {
+        return std::nullopt;
+    }
 
-	auto the_date = StringToDateYMD("%Y%m%d", results.str(1));
-	parsed_header_data_["quarter_ending"] = date::format("%F", the_date);
-}		// -----  end of method SEC_Header::ExtractQuarterEnded  -----
+    // the line may end with '\r\n'.
 
-void SEC_Header::ExtractFileName ()
+    auto end = content.find(header_end, start + header_start.size());
+    while (end != EM::sv::npos && end + header_end.size() < content.size()
+            && content[end + header_end.size()] != '\n' && content[end + header_end.size()] != '\r')
+    {
+        end = content.find(header_end, end + header_end.size());
+    }
+    if (end == EM::sv::npos)
+    {
+        return std::nullopt;
+    }
+    return content.substr(start, end + header_end.size() - start);
+}		// -----  end of method SEC_Header::FindHeader  -----
+
+/*
+ * ===  FUNCTION  ======================================================================
+ *         Name:  SEC_Header::ExtractHeaderFields
+ *  Description:  1 pass over the header lines. As before, if a label appears more than
+ *                once, the first usable value wins.
+ * =====================================================================================
+ */
+void SEC_Header::ExtractHeaderFields ()
 {
-	const boost::regex ex{R"***(^ACCESSION NUMBER:\s+([0-9-]+?)$)***"};
-
-	boost::cmatch results;
-	bool found_it = boost::regex_search(header_data_.cbegin(), header_data_.cend(), results, ex);
-
-    BOOST_ASSERT_MSG(found_it, "Can't find 'file name' in SEC Header");
+    header_record_ = SEC_HeaderRecord{};
+    parsed_header_data_.reset();
+
+    bool found_CIK{false};
+    bool found_SIC{false};
+    bool found_company_name{false};
+    bool found_form_type{false};
+    bool found_date_filed{false};
+    bool found_quarter_ending{false};
+    bool found_file_name{false};
+
+    EM::sv remaining{header_data_};
+    while (! remaining.empty())
+    {
+        auto line_end = remaining.find('\n');
+        EM::sv line = remaining.substr(0, line_end);
+        remaining.remove_prefix(line_end == EM::sv::npos ? remaining.size() : line_end + 1);
+
+        if (line.empty())
+        {
+            continue;
+        }
+
+        // need to keep track of which are which.
+
+        const bool is_indented = line.front() == ' ' || line.front() == '\t';
+        if (is_indented)
+        {
+            line = Trim(line);
+            if (! found_CIK && line.starts_with(CENTRAL_INDEX_KEY))
+            {
+                auto value = Trim(line.substr(CENTRAL_INDEX_KEY.size()));
+                if (AllDigits(value))
+                {
+                    header_record_.cik_text_ = value;
+                    std::from_chars(value.data(), value.data() + value.size(), header_record_.cik_);
+                    found_CIK = true;
+                }
+            }
+            else if (! found_SIC && line.starts_with(SIC_CODE))
+            {
+                // this field is sometimes missing in my test files.  I can live without it.
+
+                if (auto code = FindSICCode(line.substr(SIC_CODE.size())); code)
+                {
+                    header_record_.sic_ = code.value();
+                    found_SIC = true;
+                }
+            }
+            else if (! found_company_name && line.starts_with(COMPANY_NAME))
+            {
+                auto value = Trim(line.substr(COMPANY_NAME.size()));
+                if (! value.empty())
+                {
+                    header_record_.company_name_ = value;
+                    found_company_name = true;
+                }
+            }
+            continue;
+        }
+
+        if (! found_file_name && line.starts_with(ACCESSION_NUMBER))
+        {
+            auto value = Trim(line.substr(ACCESSION_NUMBER.size()));
+            if (AllDigits(value, "-"))
+            {
+                header_record_.file_name_ = catenate(value, ".txt");
+                found_file_name = true;
+            }
+        }
+        else if (! found_form_type && line.starts_with(SUBMISSION_TYPE))
+        {
+            auto value = Trim(line.substr(SUBMISSION_TYPE.size()));
+            if (! value.empty())
+            {
+                // since we use form type as part of our file name for forms stored on disk,
+                // we can't have the '/' character in it.  Our Collect program replaces the '/' with '_'
+                // so we do the same here.
+
+                header_record_.form_type_text_.reserve(value.size());
+                std::transform(value.begin(), value.end(), std::back_inserter(header_record_.form_type_text_),
+                        [](unsigned char c) { return (c == '/' ? '_' : std::toupper(c)); });
+                header_record_.form_type_ = ClassifyFormType(header_record_.form_type_text_);
+                found_form_type = true;
+            }
+        }
+        else if (! found_date_filed && line.starts_with(DATE_FILED))
+        {
+            auto value = Trim(line.substr(DATE_FILED.size()));
+            if (AllDigits(value))
+            {
+                header_record_.date_filed_ = ParseHeaderDate(value, "date filed");
+                found_date_filed = true;
+            }
+        }
+        else if (! found_quarter_ending && line.starts_with(PERIOD_OF_REPORT))
+        {
+            auto value = Trim(line.substr(PERIOD_OF_REPORT.size()));
+            if (AllDigits(value))
+            {
+                header_record_.quarter_ending_ = ParseHeaderDate(value, "quarter ending");
+                found_quarter_ending = true;
+            }
+        }
+    }
 
-	parsed_header_data_["file_name"] = results.str(1) + ".txt";
-}		// -----  end of method SEC_Header::ExtractFileName  -----
+    BOOST_ASSERT_MSG(found_CIK, "Can't find CIK in SEC Header");
+    BOOST_ASSERT_MSG(found_form_type, "Can't find 'form type' in SEC Header");
+    BOOST_ASSERT_MSG(found_date_filed, "Can't find 'date filed' in SEC Header");
+    BOOST_ASSERT_MSG(found_quarter_ending, "Can't find 'quarter ending' in SEC Header");
+    BOOST_ASSERT_MSG(found_file_name, "Can't find 'file name' in SEC Header");
+    BOOST_ASSERT_MSG(found_company_name, "Can't find 'company name' in SEC Header");
+}		// -----  end of method SEC_Header::ExtractHeaderFields  -----
 
-void SEC_Header::ExtractCompanyName ()
+/*
+ * ===  FUNCTION  ======================================================================
+ *         Name:  SEC_Header::GetFields
+ *  Description:  same keys and text formats as we have always used.
+ * =====================================================================================
+ */
+const EM::SEC_Header_fields& SEC_Header::GetFields () const
 {
-	const boost::regex ex{R"***(^\s+COMPANY CONFORMED NAME:\s+(.+?)$)***", boost::regex_constants::match_not_dot_newline};
-
-	boost::cmatch results;
-	bool found_it = boost::regex_search(header_data_.cbegin(), header_data_.cend(), results, ex);
-
-    BOOST_ASSERT_MSG(found_it, "Can't find 'company name' in SEC Header");
-
-	parsed_header_data_["company_name"] = results.str(1);
-}		// -----  end of method SEC_Header::ExtractCompanyName  -----
+    if (! parsed_header_data_)
+    {
+        parsed_header_data_ = EM::SEC_Header_fields{
+            {"cik", header_record_.cik_text_},
+            {"sic", header_record_.sic_},
+            {"form_type", header_record_.form_type_text_},
+            {"date_filed", FormatDate(header_record_.date_filed_)},
+            {"quarter_ending", FormatDate(header_record_.quarter_ending_)},
+            {"file_name", header_record_.file_name_},
+            {"company_name", header_record_.company_name_}
+        };
+    }
+    return parsed_header_data_.value();
+}		// -----  end of method SEC_Header::GetFields  -----
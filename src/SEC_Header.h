@@ -31,16 +31,59 @@
 	/* You should have received a copy of the GNU General Public License */
 	/* along with Extractor_Markup.  If not, see <http://www.gnu.org/licenses/>. */
 
-// =====================================================================================
-//        Class:  SEC_Header
-//  Description:  class which extracts needed data from header portion of SEC files
-// =====================================================================================
-
 #ifndef  _SEC_HEADER_INC_
 #define  _SEC_HEADER_INC_
 
+#include <cstdint>
+#include <optional>
+#include <string>
+
+#include "date/date.h"
+
 #include "Extractor.h"
 
+// the header fields we use, already converted to the types we use them as.
+// text fields are copied so the record can outlive the file content.
+
+struct SEC_HeaderRecord
+{
+    enum class FormType : uint8_t { e_Other, e_10_Q, e_10_K, e_10_Q_A, e_10_K_A };
+
+    [[nodiscard]] bool IsAmended() const { return form_type_text_.ends_with("_A"); }
+
+    // form type without any '_A' suffix.
+
+    [[nodiscard]] EM::sv BaseFormType() const
+    {
+        EM::sv base_form_type{form_type_text_};
+        if (IsAmended())
+        {
+            base_form_type.remove_suffix(2);
+        }
+        return base_form_type;
+    }
+
+    uint64_t cik_ = 0;
+    std::string cik_text_;                      // as in the header, with leading zeros
+    std::string sic_{"unknown"};                // sometimes missing
+    std::string company_name_;
+    std::string form_type_text_;                // upper case with '/' replaced by '_'
+    FormType form_type_ = FormType::e_Other;
+    date::year_month_day date_filed_;
+    date::year_month_day quarter_ending_;
+    std::string file_name_;                     // accession number + ".txt"
+};
+
+// =====================================================================================
+//        Class:  SEC_Header
+//  Description:  class which extracts needed data from header portion of SEC files
+//
+//                We make 1 pass over the lines of the header to fill in our record.
+//                The string keyed map of fields is still available for code which
+//                wants it but it is only built if someone asks for it.  Most files
+//                never get past our filters so they never need it.
+// =====================================================================================
+
 class SEC_Header
 {
 	public:
@@ -51,9 +94,14 @@ class SEC_Header
 
 		// ====================  ACCESSORS     =======================================
 
-		[[nodiscard]] const EM::SEC_Header_fields& GetFields() const		{ return parsed_header_data_; }
+		[[nodiscard]] const SEC_HeaderRecord& GetRecord() const		{ return header_record_; }
+		[[nodiscard]] const EM::SEC_Header_fields& GetFields() const;
         [[nodiscard]] EM::sv GetHeader(void) const     { return header_data_; }
 
+        // the complete <SEC-HEADER> block, if content has one.
+
+        [[nodiscard]] static std::optional<EM::sv> FindHeader(EM::sv content);
+
 		// ====================  MUTATORS      =======================================
 
 		void UseData(EM::FileContent file_content);
@@ -63,14 +111,6 @@ class SEC_Header
 
 	protected:
 
-		void ExtractCIK();
-		void ExtractSIC();
-		void ExtractFormType();
-		void ExtractDateFiled();
-		void ExtractQuarterEnding();
-		void ExtractFileName();
-		void ExtractCompanyName();
-
 		// ====================  DATA MEMBERS  =======================================
 
 	private:
@@ -78,7 +118,11 @@ class SEC_Header
 
 		EM::sv header_data_;
 
-		EM::SEC_Header_fields parsed_header_data_;
+		SEC_HeaderRecord header_record_;
+
+        // built from our record the first time it is asked for.
+
+		mutable std::optional<EM::SEC_Header_fields> parsed_header_data_;
 
 }; // -----  end of class SEC_Header  -----
 
@@ -19,7 +19,6 @@
 #include <charconv>
 #include <cmath>
 #include <fstream>
-#include <functional>
 #include <memory>
 #include <set>
 
@@ -42,16 +41,16 @@
 
 #include "spdlog/spdlog.h"
 
+#include "CoverPageText.h"
 #include "HTML_FromFile.h"
+#include "RegexRegistry.h"
 
 const int32_t MAX_HTML_TO_PARSE = 1'000'000;
 const int32_t MAX_TEXT_TO_CLEAN = 20'000;
 
 int64_t SharesOutstanding::operator() (EM::HTMLContent html) const
 {
-    const std::string nbr_of_shares = R"***((\b[1-9](?:[0-9]{0,2})(?:,[0-9]{3})+\b))***";
-    const boost::regex::flag_type my_flags = {boost::regex_constants::normal | boost::regex_constants::icase};
-    const boost::regex regex_share_extractor{nbr_of_shares, my_flags};
+    const auto& regex_share_extractor = RegexRegistry::Get(RegexId::e_SharesOutstanding);
 
     std::string the_text = ParseHTML(html, MAX_HTML_TO_PARSE, MAX_TEXT_TO_CLEAN);
     std::vector<EM::sv> possibilites = FindCandidates(the_text);
@@ -72,7 +71,7 @@ int64_t SharesOutstanding::operator() (EM::HTMLContent html) const
     {
         boost::cmatch the_shares;
 
-        if (bool found_it = boost::regex_search(std::begin(possible), std::end(possible), the_shares, regex_share_extractor))
+        if (bool found_it = regex_share_extractor.Search(std::begin(possible), std::end(possible), the_shares))
         {
            shares = the_shares.str(1); 
            break;
@@ -86,9 +85,7 @@ int64_t SharesOutstanding::operator() (EM::HTMLContent html) const
 
         // need to replace any commas we might have.
 
-        const std::string delete_this{""};
-        const boost::regex regex_comma{R"***(,)***"};
-        shares = boost::regex_replace(shares, regex_comma, delete_this);
+        std::erase(shares, ',');
 
         if (auto [p, ec] = std::from_chars(shares.data(), shares.data() + shares.size(), shares_outstanding); ec != std::errc())
         {
@@ -104,43 +101,6 @@ int64_t SharesOutstanding::operator() (EM::HTMLContent html) const
     return shares_outstanding;
 }		// -----  end of method SharesOutstanding::operator()  ----- 
 
-void CleanText(GumboNode* node, size_t max_length_to_clean, std::string& cleaned_text)
-{
-    //    this code is based on example code in Gumbo Parser project
-    //    I've added the ability to break out of the recursive
-    //    loop if a maximum length to parse is given.
-    //    I use a Pythonic approach...throw an exception (think 'stop iteration').
-
-    const boost::regex regex_nbr{R"***(\b[1-9](?:[0-9]{0,2})(?:,[0-9]{3})+\b)***"};
-
-    if (node->type == GUMBO_NODE_TEXT)
-    {
-        // the gumbo parse library seems to find all the actual text content in nodes
-        // here.
-
-        // sometimes, the number of shares runs together with some text so try
-        // to separate them.
-
-        EM::sv the_text{node->v.text.text};
-        cleaned_text += the_text;
-        cleaned_text += ' ';
-    }
-    if (node->type == GUMBO_NODE_ELEMENT && node->v.element.tag != GUMBO_TAG_SCRIPT && node->v.element.tag != GUMBO_TAG_STYLE)
-    {
-        std::string contents;
-        GumboVector* children = &node->v.element.children;
-
-        for (unsigned int i = 0; i < children->length; ++i)
-        {
-            CleanText((GumboNode*) children->data[i], max_length_to_clean, cleaned_text);
-        }
-        if (max_length_to_clean > 0 && cleaned_text.size() >= max_length_to_clean)
-        {
-            throw std::length_error("'stop iteration'");
-        }
-    }
-}		// -----  end of method SharesOutstanding::CleanText  ----- 
-
 std::vector<EM::sv> FindCandidates(const std::string& the_text)
 {
     // the beginning of the HTML content is actually a 'form' which almost always contains
@@ -149,27 +109,19 @@ std::vector<EM::sv> FindCandidates(const std::string& the_text)
     // this regex looks for an identifiable part of the form followed by something which
     // looks like the number of outstanding shares.
 
-    const std::string shares = R"***((?:\bshares|outstanding|common\b))***";
-    const std::string number = R"***((?:\bshares|outstanding|number\b))***";
-    const std::string market_value = R"***(\bmarket value\b)***";
-    const std::string yes_no = R"***(\byes\b.{1,10}?no.{1,1000}?\b[1-9](?:[0-9]{0,2})(?:,[0-9]{3})+\b)***";
-    const std::string indicator = R"***((?:\binidcate\b|\bas of \b|\bnumber of\b).{1,200}?\b[1-9](?:[0-9]{0,2})(?:,[0-9]{3})+\b(?:.{1,100}?(?:shares|common|outstanding))?)***";
-
-    const boost::regex regex_shares{shares, boost::regex_constants::normal | boost::regex_constants::icase};
-    const boost::regex regex_number{number, boost::regex_constants::normal | boost::regex_constants::icase};
-    const boost::regex regex_market_value{market_value, boost::regex_constants::normal | boost::regex_constants::icase};
-    const boost::regex regex_shares_yes_no{yes_no, boost::regex_constants::normal | boost::regex_constants::icase};
-    const boost::regex regex_shares_indicator{indicator, boost::regex_constants::normal | boost::regex_constants::icase};
+    const auto& regex_shares = RegexRegistry::Get(RegexId::e_CoverPageShares);
+    const auto& regex_number = RegexRegistry::Get(RegexId::e_CoverPageNumber);
+    const auto& regex_market_value = RegexRegistry::Get(RegexId::e_CoverPageMarketValue);
+    const auto& regex_shares_yes_no = RegexRegistry::Get(RegexId::e_CoverPageYesNo);
+    const auto& regex_shares_indicator = RegexRegistry::Get(RegexId::e_CoverPageIndicator);
 
     std::vector<EM::sv> results;
 
-    boost::sregex_iterator iter1(the_text.begin(), the_text.end(), regex_shares_yes_no);
-    std::for_each(iter1, boost::sregex_iterator{}, [&the_text, &results, &regex_number, &regex_market_value] (const boost::smatch& m)
+    for (auto possible : regex_shares_yes_no.FindAll(the_text))
     {
-        EM::sv possible(the_text.data() + m.position(), m.length());
-        if (boost::regex_search(possible.begin(), possible.end(), regex_market_value))
+        if (regex_market_value.Search(possible.begin(), possible.end()))
         {
-            if (boost::regex_search(possible.begin(), possible.end(), regex_number))
+            if (regex_number.Search(possible.begin(), possible.end()))
             {
                 results.push_back(possible);
             }
@@ -178,19 +130,17 @@ std::vector<EM::sv> FindCandidates(const std::string& the_text)
         {
             results.push_back(possible);
         }
-    });
+    }
 
     if (results.empty())
     {
-        boost::sregex_iterator iter2(the_text.begin(), the_text.end(), regex_shares_indicator);
-        std::for_each(iter2, boost::sregex_iterator{}, [&the_text, &results,& regex_shares] (const boost::smatch& m)
+        for (auto possible : regex_shares_indicator.FindAll(the_text))
         {
-            EM::sv possible(the_text.data() + m.position(), m.length());
-            if (boost::regex_search(possible.begin(), possible.end(), regex_shares))
+            if (regex_shares.Search(possible.begin(), possible.end()))
             {
                 results.push_back(possible);
             }
-        });
+        }
     }
 
     // prefer shortest matches
@@ -204,40 +154,23 @@ std::vector<EM::sv> FindCandidates(const std::string& the_text)
 
 std::string ParseHTML (EM::HTMLContent html, size_t max_length_to_parse, size_t max_length_to_clean)
 {
-    const boost::regex regex_hi_ascii{R"***([^\x00-\x7f])***"};
-    const boost::regex regex_control_chars{R"***([\x00-\x1f])***"};
-    const boost::regex regex_multiple_spaces{R"***( {2,})***"};
-    const boost::regex regex_nl{R"***(\n{1,})***"};
-    const std::string one_space = " ";
-    const boost::regex regex_nbr{R"***(([1-9](?:[0-9]{0,2})(?:,[0-9]{3})+))***"};
-    const boost::regex regex_dollar_number{R"***(\$ *\b[1-9](?:[0-9]{0,2})(?:,[0-9]{3})+\b)***"};
+    const auto& regex_nbr = RegexRegistry::Get(RegexId::e_NumberWithCommas);
+    const auto& regex_dollar_number = RegexRegistry::Get(RegexId::e_DollarNumber);
 
-    GumboOptions options = kGumboDefaultOptions;
+    EM::sv html_to_parse = html.get();
+    if (max_length_to_parse > 0)
+    {
+        html_to_parse = html_to_parse.substr(0, max_length_to_parse);
+    }
 
-    size_t length_HTML_to_parse = max_length_to_parse == 0 ? html.get().length() : std::min(html.get().length(), max_length_to_parse);
+    // white space, hi ascii and control characters come back as single spaces.
 
-    std::unique_ptr<GumboOutput, std::function<void(GumboOutput*)>> output(gumbo_parse_with_options(&options, html.get().data(), length_HTML_to_parse),
-            [&options](GumboOutput* output){ gumbo_destroy_output(&options, output); });
+    std::string the_text = CoverPageText(html_to_parse, max_length_to_clean);
 
-    std::string parsed_text;
-    try
-    {
-        CleanText(output->root, max_length_to_clean, parsed_text);
-    }
-    catch (std::length_error& e)
-    {
-        //   nothing to do, should be 'stop iteration' 
-    }
-    gumbo_destroy_output(&options, output.release());
-    //
     // do a little cleanup to make searching easier
 
-    std::string the_text = boost::regex_replace(parsed_text, regex_hi_ascii, one_space);
-    the_text = boost::regex_replace(the_text, regex_control_chars, one_space);
-    the_text = boost::regex_replace(the_text, regex_multiple_spaces, one_space);
-    the_text = boost::regex_replace(the_text, regex_nl, one_space);
-    the_text = boost::regex_replace(the_text, regex_nbr, " $1 ");
-    the_text = boost::regex_replace(the_text, regex_dollar_number, one_space);
+    the_text = regex_nbr.Replace(the_text, " $1 ");
+    the_text = regex_dollar_number.Replace(the_text, " ");
 
     return the_text;
 }		// -----  end of method SharesOutstanding::ParseHTML  ----- 
@@ -25,10 +25,6 @@
 
 #include "boost/regex.hpp"
 
-// gumbo-parse
-
-#include "gumbo.h"
-
 #include "Extractor_Utils.h"
 
 
@@ -68,10 +64,6 @@ private:
 
     // try a new approach
 
-// NOTE: this method can throw length_error if max_length_to_parse_ != 0
-
-void CleanText(GumboNode* node, size_t max_length_to_clean, std::string& cleaned_text);
-
 [[nodiscard]] std::string ParseHTML(EM::HTMLContent html, size_t max_length_to_parse = 0, size_t max_length_to_clean = 0);
 
 [[nodiscard]] std::vector<EM::sv> FindCandidates(const std::string& parsed_text);
@@ -0,0 +1,286 @@
+// =====================================================================================
+//
+//       Filename:  StatementClassifier.cpp
+//
+//    Description:  Implementation of ClassifyStatementTable
+//
+//        Version:  1.0
+//        Created:  10/17/2026 11:05:12 PM
+//       Revision:  none
+//       Compiler:  g++
+//
+//         Author:  David P. Riedel (), driedel@cox.net
+//        License:  GNU General Public License -v3
+//
+// =====================================================================================
+
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <initializer_list>
+#include <limits>
+#include <vector>
+
+#include "StatementClassifier.h"
+
+namespace
+{
+    // every word our patterns are built from.  Matching ignores case.
+
+    enum Word : uint8_t
+    {
+        e_total, e_asset, e_liabilities, e_members, e_holders, e_equity, e_defici, e_common, e_share,
+        e_stock, e_prepaid, e_expense, e_other, e_net, e_operat, e_income, e_revenue, e_sales, e_loss,
+        e_general, e_administ, e_costs, e_admin, e_gain, e_earning, e_member, e_interest, e_outstanding,
+        e_per, e_number, e_operating_activities, e_financing_activities, e_cash_flow, e_cash_used,
+        e_cash_provided, e_operating, e_financing, e_WordCount
+    };
+
+    constexpr std::array<EM::sv, e_WordCount> WORDS
+    {
+        "total", "asset", "liabilities", "members", "holders", "equity", "defici", "common", "share",
+        "stock", "prepaid", "expense", "other", "net", "operat", "income", "revenue", "sales", "loss",
+        "general", "administ", "costs", "admin", "gain", "earning", "member", "interest", "outstanding",
+        "per", "number", "operating activities", "financing activities", "cash flow", "cash used",
+        "cash provided", "operating", "financing"
+    };
+
+    constexpr std::ptrdiff_t NOT_FOUND = std::numeric_limits<int>::max();
+
+    // a cell is the text up to the next tab.
+
+    struct CellWords
+    {
+        std::array<std::ptrdiff_t, e_WordCount> first_end_;
+        std::array<std::ptrdiff_t, e_WordCount> last_start_;
+    };
+
+    const std::array<std::vector<Word>, 256>& WordsStartingWith()
+    {
+        static const auto words_starting_with = []
+            {
+                std::array<std::vector<Word>, 256> result;
+                for (int word = 0; word < e_WordCount; ++word)
+                {
+                    result[static_cast<unsigned char>(WORDS[word][0])].push_back(static_cast<Word>(word));
+                }
+                return result;
+            }();
+        return words_starting_with;
+    }
+
+    bool EqualNoCase(EM::sv text, EM::sv lower_case_word)
+    {
+        return text.size() == lower_case_word.size() && std::equal(text.begin(), text.end(), lower_case_word.begin(),
+                [] (unsigned char lhs, char rhs) { return std::tolower(lhs) == rhs; });
+    }
+
+    bool ContainsNoCase(EM::sv text, EM::sv lower_case_word)
+    {
+        return std::search(text.begin(), text.end(), lower_case_word.begin(), lower_case_word.end(),
+                [] (unsigned char lhs, char rhs) { return std::tolower(lhs) == rhs; }) != text.end();
+    }
+
+    void FindWords(EM::sv cell, CellWords& words)
+    {
+        words.first_end_.fill(NOT_FOUND);
+        words.last_start_.fill(-1);
+
+        const auto& words_starting_with = WordsStartingWith();
+        for (std::size_t i = 0; i < cell.size(); ++i)
+        {
+            for (auto word : words_starting_with[std::tolower(static_cast<unsigned char>(cell[i]))])
+            {
+                if (EqualNoCase(cell.substr(i, WORDS[word].size()), WORDS[word]))
+                {
+                    words.first_end_[word] = std::min<std::ptrdiff_t>(words.first_end_[word], i + WORDS[word].size());
+                    words.last_start_[word] = i;
+                }
+            }
+        }
+    }
+
+    std::ptrdiff_t FirstEnd(const CellWords& words, std::initializer_list<Word> any_of)
+    {
+        std::ptrdiff_t result = NOT_FOUND;
+        for (auto word : any_of)
+        {
+            result = std::min(result, words.first_end_[word]);
+        }
+        return result;
+    }
+
+    std::ptrdiff_t LastStart(const CellWords& words, std::initializer_list<Word> any_of)
+    {
+        std::ptrdiff_t result = -1;
+        for (auto word : any_of)
+        {
+            result = std::max(result, words.last_start_[word]);
+        }
+        return result;
+    }
+
+    // 1 of 'first' then, at least 'gap' characters later, 1 of 'second'.
+
+    bool InOrder(const CellWords& words, std::initializer_list<Word> first, std::initializer_list<Word> second, int gap)
+    {
+        return LastStart(words, second) >= FirstEnd(words, first) + gap;
+    }
+
+    // cash (flow|used|provided) ... (from|in|by) ... 'activity'
+
+    bool CashFromActivity(EM::sv cell, const CellWords& words, Word activity)
+    {
+        const auto from = FirstEnd(words, {e_cash_flow, e_cash_used, e_cash_provided});
+        const auto to = words.last_start_[activity] - 1;
+        if (from >= to)
+        {
+            return false;
+        }
+        const auto between = cell.substr(from, to - from);
+        return ContainsNoCase(between, "from") || ContainsNoCase(between, "in") || ContainsNoCase(between, "by");
+    }
+
+    // most patterns are for a line item so they only match in a cell which ends with a tab.
+
+    using PatternMatches = std::bitset<4>;
+
+    PatternMatches BalanceSheetPatterns(EM::sv /* cell */, const CellWords& words, bool ends_with_tab)
+    {
+        PatternMatches result;
+        result[0] = ends_with_tab && InOrder(words, {e_total}, {e_asset}, 1);
+        result[1] = ends_with_tab && InOrder(words, {e_total}, {e_liabilities}, 1);
+        result[2] = InOrder(words, {e_members, e_holders}, {e_equity, e_defici}, 1)
+            || InOrder(words, {e_common}, {e_share}, 1)
+            || (ends_with_tab && InOrder(words, {e_common}, {e_stock}, 1));
+        result[3] = ends_with_tab && InOrder(words, {e_prepaid}, {e_expense}, 1);
+        return result;
+    }
+
+    PatternMatches StatementOfOperationsPatterns(EM::sv /* cell */, const CellWords& words, bool ends_with_tab)
+    {
+        PatternMatches result;
+        result[0] = ends_with_tab && InOrder(words, {e_total, e_other, e_net, e_operat}, {e_income, e_revenue, e_sales, e_loss}, 0);
+        result[1] = ends_with_tab && InOrder(words, {e_operat, e_total, e_general, e_administ},
+                {e_expense, e_costs, e_loss, e_admin, e_general}, 0);
+        result[2] = ends_with_tab && InOrder(words, {e_net}, {e_gain, e_loss, e_income, e_earning}, 0);
+        result[3] = InOrder(words, {e_member}, {e_interest}, 1)
+            || InOrder(words, {e_share}, {e_outstanding}, 0)
+            || InOrder(words, {e_per}, {e_share}, 1)
+            || (ends_with_tab && InOrder(words, {e_number}, {e_share}, 0));
+        return result;
+    }
+
+    PatternMatches CashFlowsPatterns(EM::sv cell, const CellWords& words, bool ends_with_tab)
+    {
+        PatternMatches result;
+        result[0] = words.last_start_[e_operating_activities] >= 0
+            || (ends_with_tab && CashFromActivity(cell, words, e_operating));
+        result[1] = words.last_start_[e_financing_activities] >= 0
+            || (ends_with_tab && CashFromActivity(cell, words, e_financing));
+        return result;
+    }
+
+    struct StatementPatterns
+    {
+        PatternMatches (*match_)(EM::sv cell, const CellWords& words, bool ends_with_tab);
+        std::size_t matches_needed_;
+    };
+
+    // in the same order as StatementKind.
+
+    const std::array<StatementPatterns, STATEMENT_KINDS> STATEMENT_PATTERNS
+    {{
+        {BalanceSheetPatterns, 3},
+        {StatementOfOperationsPatterns, 4},
+        {CashFlowsPatterns, 2}
+    }};
+
+    // this pattern must also match on a line shorter than this.
+
+    constexpr std::size_t SHORT_LINE_PATTERN = 1;
+    constexpr std::size_t SHORT_LINE = 150;
+
+    template<typename Action>
+    void ForEachCell(EM::sv text, Action action)
+    {
+        while (true)
+        {
+            auto tab = text.find('\t');
+            if (tab == EM::sv::npos)
+            {
+                action(text, false);
+                return;
+            }
+            action(text.substr(0, tab), true);
+            text.remove_prefix(tab + 1);
+        }
+    }
+
+    bool HasShortLineMatch(EM::sv table, const StatementPatterns& patterns)
+    {
+        CellWords words;
+        while (! table.empty())
+        {
+            auto line_end = std::min(table.find('\n'), table.size());
+            auto line = table.substr(0, line_end);
+            table.remove_prefix(std::min(line_end + 1, table.size()));
+
+            if (line.size() >= SHORT_LINE)
+            {
+                continue;
+            }
+            bool found_it{false};
+            ForEachCell(line, [&] (EM::sv cell, bool ends_with_tab)
+                {
+                    if (! found_it)
+                    {
+                        FindWords(cell, words);
+                        found_it = patterns.match_(cell, words, ends_with_tab)[SHORT_LINE_PATTERN];
+                    }
+                });
+            if (found_it)
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+}
+
+/*
+ * ===  FUNCTION  ======================================================================
+ *         Name:  ClassifyStatementTable
+ *  Description:  does what searching the table with each statement's regexes did
+ *                but the cells are scanned once for all of them.  The short line
+ *                test is only done for the statements which get that far.
+ * =====================================================================================
+ */
+StatementKinds ClassifyStatementTable (EM::sv table, StatementKinds wanted)
+{
+    std::array<PatternMatches, STATEMENT_KINDS> matches;
+    CellWords words;
+
+    ForEachCell(table, [&] (EM::sv cell, bool ends_with_tab)
+        {
+            FindWords(cell, words);
+            for (std::size_t kind = 0; kind < STATEMENT_KINDS; ++kind)
+            {
+                if (wanted[kind])
+                {
+                    matches[kind] |= STATEMENT_PATTERNS[kind].match_(cell, words, ends_with_tab);
+                }
+            }
+        });
+
+    StatementKinds result;
+    for (std::size_t kind = 0; kind < STATEMENT_KINDS; ++kind)
+    {
+        if (wanted[kind] && matches[kind].count() >= STATEMENT_PATTERNS[kind].matches_needed_
+                && HasShortLineMatch(table, STATEMENT_PATTERNS[kind]))
+        {
+            result.set(kind);
+        }
+    }
+    return result;
+}		// -----  end of function ClassifyStatementTable  -----
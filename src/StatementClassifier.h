@@ -0,0 +1,50 @@
+// =====================================================================================
+//
+//       Filename:  StatementClassifier.h
+//
+//    Description:  Decide which financial statements an HTML table could be
+//
+//        Version:  1.0
+//        Created:  10/17/2026 11:05:12 PM
+//       Revision:  none
+//       Compiler:  g++
+//
+//         Author:  David P. Riedel (), driedel@cox.net
+//        License:  GNU General Public License -v3
+//
+// =====================================================================================
+
+
+// =====================================================================================
+//  Description:  Each statement has a few patterns we expect to find in its line
+//                items (text in a cell, ending with a tab) and need so many of them
+//                to match.  To weed out arbitrary blocks of text which happen to
+//                match, one of the patterns must also match on a short line.
+//
+//                All the words the patterns are built from are found in 1 pass over
+//                each cell so a table is looked at once no matter how many
+//                statements we are trying it against.
+// =====================================================================================
+
+
+#ifndef  StatementClassifier_INC
+#define  StatementClassifier_INC
+
+#include <bitset>
+#include <cstdint>
+
+#include "Extractor.h"
+
+enum class StatementKind : uint8_t { e_BalanceSheet, e_StatementOfOperations, e_CashFlows };
+
+constexpr std::size_t STATEMENT_KINDS = 3;
+
+using StatementKinds = std::bitset<STATEMENT_KINDS>;
+
+inline StatementKinds OnlyStatement(StatementKind kind) { return StatementKinds{}.set(static_cast<std::size_t>(kind)); }
+
+// which of the 'wanted' statements the parsed table could be.
+
+StatementKinds ClassifyStatementTable(EM::sv table, StatementKinds wanted);
+
+#endif   // ----- #ifndef StatementClassifier_INC  -----
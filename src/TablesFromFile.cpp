@@ -36,20 +36,248 @@
 #include "TablesFromFile.h"
 #include "Extractor_Utils.h"
 
+#include <algorithm>
+#include <cctype>
+#include <functional>
+#include <memory>
+
 using namespace std::string_literals;
 
-// gumbo-query
+// gumbo-parse
 
-#include "gq/Document.h"
-#include "gq/Node.h"
-#include "gq/Selection.h"
+#include "gumbo.h"
 
 #include "spdlog/spdlog.h"
 
 constexpr int START_WITH = 5000;
-constexpr int FOR_TBL_ROW = 1000;
 constexpr int MIN_AMOUNT_HTML = 100;
 
+namespace
+{
+    // the em dash entities come to us from gumbo as this.
+
+    const EM::sv EM_DASH{"\xE2\x80\x94"};
+    const EM::sv PSEUDO_EM_DASH{"---"};
+
+    // case insensitive search for a lower case target.
+
+    std::size_t FindNoCase(EM::sv text, EM::sv target, std::size_t from)
+    {
+        if (from >= text.size())
+        {
+            return EM::sv::npos;
+        }
+        auto found = std::search(text.begin() + from, text.end(), target.begin(), target.end(),
+                [] (char lhs, char rhs) { return std::tolower(static_cast<unsigned char>(lhs)) == rhs; });
+        return found == text.end() ? EM::sv::npos : found - text.begin();
+    }
+
+    // same as gumbo-query's CNode::ownText(): just the element's own text.
+
+    void AppendOwnText(const GumboNode* node, std::string& text)
+    {
+        const GumboVector* children = &node->v.element.children;
+        for (unsigned int i = 0; i < children->length; ++i)
+        {
+            const auto* child = static_cast<const GumboNode*>(children->data[i]);
+            if (child->type == GUMBO_NODE_TEXT)
+            {
+                text += child->v.text.text;
+            }
+        }
+    }
+
+    // same as gumbo-query's CNode::text(): all the text inside the element.
+
+    void AppendAllText(const GumboNode* node, std::string& text)
+    {
+        if (node->type == GUMBO_NODE_TEXT)
+        {
+            text += node->v.text.text;
+            return;
+        }
+        if (node->type != GUMBO_NODE_ELEMENT)
+        {
+            return;
+        }
+        const GumboVector* children = &node->v.element.children;
+        for (unsigned int i = 0; i < children->length; ++i)
+        {
+            AppendAllText(static_cast<const GumboNode*>(children->data[i]), text);
+        }
+    }
+
+    // same as gumbo-query's find(): every 'tag' element inside 'node' in document order.
+
+    void ForEachElement(const GumboNode* node, GumboTag tag, const std::function<void(const GumboNode*)>& action)
+    {
+        const GumboVector* children = &node->v.element.children;
+        for (unsigned int i = 0; i < children->length; ++i)
+        {
+            const auto* child = static_cast<const GumboNode*>(children->data[i]);
+            if (child->type != GUMBO_NODE_ELEMENT)
+            {
+                continue;
+            }
+            if (child->v.element.tag == tag)
+            {
+                action(child);
+            }
+            ForEachElement(child, tag, action);
+        }
+    }
+
+    // a ' ' followed by the own text of each 'tag' element in the cell which has some.
+
+    void AppendParagraphText(const GumboNode* a_table_cell, GumboTag tag, std::string& text)
+    {
+        ForEachElement(a_table_cell, tag, [&text] (const GumboNode* paragraph)
+            {
+                const auto mark = text.size();
+                text += ' ';
+                AppendOwnText(paragraph, text);
+                if (text.size() == mark + 1)
+                {
+                    text.resize(mark);
+                }
+            });
+    }
+
+    // each row becomes 1 line with a tab after each cell which has any text.
+    // returns false if the table has little or no text.
+
+    bool AppendTableText(const GumboNode* a_table, std::string& table_text)
+    {
+        const auto table_start = table_text.size();
+
+        ForEachElement(a_table, GUMBO_TAG_TR, [&table_text] (const GumboNode* a_table_row)
+            {
+                const auto row_start = table_text.size();
+
+                ForEachElement(a_table_row, GUMBO_TAG_TD, [&table_text] (const GumboNode* a_table_row_cell)
+                    {
+                        const auto cell_start = table_text.size();
+                        AppendParagraphText(a_table_row_cell, GUMBO_TAG_P, table_text);
+                        if (table_text.size() == cell_start)
+                        {
+                            AppendParagraphText(a_table_row_cell, GUMBO_TAG_DIV, table_text);
+                        }
+                        if (table_text.size() == cell_start)
+                        {
+                            AppendAllText(a_table_row_cell, table_text);
+                        }
+                        if (table_text.size() > cell_start)
+                        {
+                            table_text += '\t';
+                        }
+                    });
+
+                // at this point, I do not want any line breaks or returns from source data.
+                // (I'll add them where I want them.)
+
+                std::replace_if(table_text.begin() + row_start, table_text.end(), [] (char c) { return c == '\n' || c == '\r'; }, ' ');
+                if (table_text.size() > row_start)
+                {
+                    table_text += '\n';
+                }
+            });
+
+        return table_text.size() - table_start >= MIN_AMOUNT_HTML;
+    }
+
+    // does the same as these replacements, in this order, in 1 pass:
+    //
+    //  &#151; and &#8212;  -> ---
+    //  [^\x00-\x7f]        -> ' '
+    //  ' {2,}'             -> ' '
+    //  \$\t                -> $
+    //  \t[ \t]+            -> \t
+    //  \t+\)               -> )
+    //  ' \t'               -> \t
+    //  ^\t                 -> ''
+    //
+    // all but the first only change runs of spaces, tabs and hi-ascii so we
+    // look at 1 run at a time.
+
+    void CleanTableText(EM::sv table_text, std::string& clean_table_data)
+    {
+        auto is_blank([table_text] (std::size_t i)
+            {
+                const auto c = static_cast<unsigned char>(table_text[i]);
+                return c == ' ' || c == '\t' || (c > 0x7f && table_text.substr(i, EM_DASH.size()) != EM_DASH);
+            });
+
+        clean_table_data.clear();
+        clean_table_data.reserve(table_text.size());
+
+        std::size_t i = 0;
+        while (i < table_text.size())
+        {
+            if (table_text.substr(i, EM_DASH.size()) == EM_DASH)
+            {
+                clean_table_data += PSEUDO_EM_DASH;
+                i += EM_DASH.size();
+                continue;
+            }
+            if (! is_blank(i))
+            {
+                clean_table_data += table_text[i];
+                ++i;
+                continue;
+            }
+
+            const char before = i == 0 ? '\n' : table_text[i - 1];
+
+            // a tab right after a '$' just goes away.
+
+            auto run_start = i;
+            if (before == '$' && table_text[i] == '\t')
+            {
+                ++run_start;
+            }
+            auto run_end = run_start;
+            bool has_tab{false};
+            while (run_end < table_text.size() && is_blank(run_end))
+            {
+                has_tab |= table_text[run_end] == '\t';
+                ++run_end;
+            }
+            if (run_end == run_start)
+            {
+                i = std::max(run_end, i + 1);
+                continue;
+            }
+
+            // what's left is at most a space and a tab.
+
+            bool space = table_text[run_start] != '\t';
+            bool tab = has_tab;
+
+            if (tab && run_end < table_text.size() && table_text[run_end] == ')')
+            {
+                tab = false;
+            }
+            if (tab)
+            {
+                space = false;
+                if (before == '\n' || before == '\r' || before == '\f')
+                {
+                    tab = false;
+                }
+            }
+            if (space)
+            {
+                clean_table_data += ' ';
+            }
+            if (tab)
+            {
+                clean_table_data += '\t';
+            }
+            i = run_end;
+        }
+    }
+}
+
 /*
  *--------------------------------------------------------------------------------------
  *       Class:  TablesFromHTML
@@ -93,20 +321,13 @@ TablesFromHTML::table_itor::table_itor(TablesFromHTML const * tables)
     {
         return;
     }
-    html_ = tables_->html_;
-    auto html_val = html_.get();
-
-    if (html_val.empty())
-    {
-        return;
-    }
-
-    doc_ = boost::cregex_token_iterator(html_val.cbegin(), html_val.cend(), tables_->regex_table_);
     auto next_table = FindNextTable();
-    if (next_table)
+    if (! next_table)
     {
-        table_data_ = *next_table;
+        tables_ = nullptr;
+        return;
     }
+    table_data_ = std::move(next_table.value());
 }  /* -----  end of method TablesFromHTML::table_itor::table_itor  (constructor)  ----- */
 
 TablesFromHTML::table_itor& TablesFromHTML::table_itor::operator++ ()
@@ -116,10 +337,6 @@ TablesFromHTML::table_itor& TablesFromHTML::table_itor::operator++ ()
         return *this;
     }
     
-    if (doc_ != end_)
-    {
-        ++doc_;
-    }
     auto next_table = FindNextTable();
     if (! next_table)
     {
@@ -127,11 +344,18 @@ TablesFromHTML::table_itor& TablesFromHTML::table_itor::operator++ ()
         table_data_ = {};
         return *this;
     }
-    table_data_ = * next_table;
+    table_data_ = std::move(next_table.value());
 
     return *this;
 }		/* -----  end of method TablesFromHTML::table_itor::operator++  ----- */
 
+/*
+ * ===  FUNCTION  ======================================================================
+ *         Name:  TablesFromHTML::table_itor::FindNextTable
+ *  Description:  a table runs from '<table' through the first '</table>' after
+ *                the end of its start tag, ignoring case.
+ * =====================================================================================
+ */
 std::optional<TableData> TablesFromHTML::table_itor::FindNextTable ()
 {
     if (++using_saved_table_data_ < tables_->found_tables_.size())
@@ -143,18 +367,35 @@ std::optional<TableData> TablesFromHTML::table_itor::FindNextTable ()
     {
         return std::nullopt;
     }
+
+    const auto html_val = tables_->html_.get();
+
     TableData next_table;
-    while (doc_ != end_)
+    while (true)
     {
+        const auto table_begin = FindNoCase(html_val, "<table", tables_->search_from_);
+        const auto start_tag_end = table_begin == EM::sv::npos ? EM::sv::npos : html_val.find('>', table_begin + 6);
+        const auto table_end = start_tag_end == EM::sv::npos ? EM::sv::npos : FindNoCase(html_val, "</table>", start_tag_end + 1);
+        if (table_end == EM::sv::npos)
+        {
+            break;
+        }
+        tables_->search_from_ = table_end + 8;
+
         try
         {
-            next_table.current_table_html_ = EM::TableContent{EM::sv(doc_->first, doc_->length())};
-            if (TableHasMarkup(next_table.current_table_html_))
+            next_table.current_table_html_ = EM::TableContent{html_val.substr(table_begin, tables_->search_from_ - table_begin)};
+            if (! TableHasMarkup(next_table.current_table_html_))
+            {
+                spdlog::debug("Little or no HTML found in table...Skipping.");
+                continue;
+            }
+            if (CollectTableContent(next_table.current_table_html_, next_table.current_table_parsed_))
             {
-                next_table.current_table_parsed_ = CollectTableContent(next_table.current_table_html_);
-                break;
+                tables_->found_tables_.push_back(next_table);
+                return std::optional<TableData>{std::move(next_table)};
             }
-            spdlog::debug("Little or no HTML found in table...Skipping.");
+            spdlog::debug("Problem processing HTML table: table has little or no HTML.");
         }
         catch (AssertionException& e)
         {
@@ -168,12 +409,6 @@ std::optional<TableData> TablesFromHTML::table_itor::FindNextTable ()
 
             spdlog::debug(catenate("Problem processing HTML table: ", e.what()).c_str());
         }
-        ++doc_;
-    }
-    if (doc_ != end_)
-    {
-        tables_->found_tables_.push_back(next_table);
-        return std::optional<TableData>{next_table};
     }
     tables_->found_all_tables_ = true;
     return std::nullopt;
@@ -190,130 +425,39 @@ bool TablesFromHTML::table_itor::TableHasMarkup (EM::TableContent table)
     return have_td && have_tr;
 }		// -----  end of method TablesFromHTML::table_itor::TableHasMarkup  -----
 
-std::string TablesFromHTML::table_itor::CollectTableContent(EM::TableContent a_table)
+/*
+ * ===  FUNCTION  ======================================================================
+ *         Name:  TablesFromHTML::table_itor::CollectTableContent
+ *  Description:  we parse the table on its own, walk the tree to collect the text and
+ *                then clean it up.  Every table in the fragment needs some text.
+ * =====================================================================================
+ */
+bool TablesFromHTML::table_itor::CollectTableContent(EM::TableContent a_table, std::string& table_data)
 {
-
-    // let's try this...
-
-    std::string tmp;
     auto a_table_val = a_table.get();
 
-    tmp.reserve(a_table_val.size());
-    boost::regex_replace(std::back_inserter(tmp), a_table_val.begin(), a_table_val.end(),
-            tables_->regex_bogus_em_dash, tables_->pseudo_em_dash);
-    tmp = boost::regex_replace(tmp, tables_->regex_real_em_dash, tables_->pseudo_em_dash);
+    GumboOptions options = kGumboDefaultOptions;
 
-    std::string table_data;
-    table_data.reserve(START_WITH);
-    CDocument the_filing;
-    the_filing.parse(tmp);
-    CSelection all_tables = the_filing.find("table");
+    std::unique_ptr<GumboOutput, std::function<void(GumboOutput*)>> output(gumbo_parse_with_options(&options, a_table_val.data(), a_table_val.size()),
+            [&options](GumboOutput* output){ gumbo_destroy_output(&options, output); });
 
-    // loop through all tables in the html fragment
-    // (which mostly will contain just 1 table.)
-
-    for (size_t indx = 0 ; indx < all_tables.nodeNum(); ++indx)
-    {
-        // now, for each table, extract all the text
-
-        CNode a_table_val = all_tables.nodeAt(indx);
-        table_data += ExtractTextDataFromTable(a_table_val);
-    }
-
-    // after parsing, let's do a little cleanup
-
-    std::string clean_table_data = boost::regex_replace(table_data, tables_->regex_hi_ascii, tables_->one_space);
-    clean_table_data = boost::regex_replace(clean_table_data, tables_->regex_multiple_spaces, tables_->one_space);
-    clean_table_data = boost::regex_replace(clean_table_data, tables_->regex_dollar_tab, tables_->just_dollar);
-    clean_table_data = boost::regex_replace(clean_table_data, tables_->regex_tabs_spaces, tables_->one_tab);
-    clean_table_data = boost::regex_replace(clean_table_data, tables_->regex_tab_before_paren, tables_->just_paren);
-    clean_table_data = boost::regex_replace(clean_table_data, tables_->regex_space_tab, tables_->one_tab);
-    clean_table_data = boost::regex_replace(clean_table_data, tables_->regex_leading_tab, tables_->delete_this);
-
-    return clean_table_data;
-}		/* -----  end of function TablesFromHTML::table_itor::CollectTableContent  ----- */
-
-std::string TablesFromHTML::table_itor::ExtractTextDataFromTable (CNode& a_table)
-{
-    std::string table_text;
+    auto& table_text = tables_->table_text_;
+    table_text.clear();
     table_text.reserve(START_WITH);
 
-    // now, the each table, find all rows in the table.
-
-    CSelection a_table_rows = a_table.find("tr");
-
-    for (size_t indx = 0 ; indx < a_table_rows.nodeNum(); ++indx)
-    {
-        CNode a_table_row = a_table_rows.nodeAt(indx);
-
-        // for each row in the table, find all the fields.
-
-        CSelection a_table_row_cells = a_table_row.find("td");
+    // loop through all tables in the html fragment
+    // (which mostly will contain just 1 table.)
 
-        std::string new_row_data;
-        new_row_data.reserve(FOR_TBL_ROW);
-        for (size_t indx = 0 ; indx < a_table_row_cells.nodeNum(); ++indx)
+    bool has_text{true};
+    ForEachElement(output->root, GUMBO_TAG_TABLE, [&table_text, &has_text] (const GumboNode* a_table_node)
         {
-            CNode a_table_row_cell = a_table_row_cells.nodeAt(indx);
-            CSelection a_table_cell_paras = a_table_row_cell.find("p");
-            std::string text;
-            for(size_t indx = 0; indx < a_table_cell_paras.nodeNum(); ++indx)
-            {
-                CNode a_table_cell_para = a_table_cell_paras.nodeAt(indx);
-                auto content = a_table_cell_para.ownText();
-                if (! content.empty())
-                {
-                    text += ' ';
-                    text += content;
-                }
-            }
-            if (text.empty())
-            {
-                CSelection a_table_cell_divs= a_table_row_cell.find("div");
-                for(size_t indx = 0; indx < a_table_cell_divs.nodeNum(); ++indx)
-                {
-                    CNode a_table_cell_div = a_table_cell_divs.nodeAt(indx);
-                    auto content = a_table_cell_div.ownText();
-                    if (! content.empty())
-                    {
-                        text += ' ';
-                        text += content;
-                    }
-                }
-            }
-            if (text.empty())
-            {
-                text = a_table_row_cell.text();
-            }
-            if (! text.empty())
-            {
-                new_row_data += text;
-                new_row_data += '\t';
-            }
-        }
-        auto new_data = FilterFoundHTML(new_row_data);
-        if (! new_data.empty())
-        {
-            table_text += new_data;
-            table_text += '\n';
-        }
-    }
-    if (table_text.size() < MIN_AMOUNT_HTML)
+            has_text = AppendTableText(a_table_node, table_text) && has_text;
+        });
+    if (! has_text)
     {
-        throw HTMLException("table has little or no HTML.");
+        return false;
     }
-    table_text.shrink_to_fit();
-    return table_text;
-}		/* -----  end of function TablesFromHTML::table_itor::ExtractTextDataFromTable  ----- */
-
-std::string TablesFromHTML::table_itor::FilterFoundHTML (const std::string& new_row_data)
-{
-    // at this point, I do not want any line breaks or returns from source data.
-    // (I'll add them where I want them.)
-
-    static const boost::regex regex_line_breaks{R"***([\x0a\x0d])***"};
-    std::string clean_row_data = boost::regex_replace(new_row_data, regex_line_breaks, tables_->one_space);
-
-    return clean_row_data;
-}		/* -----  end of function TablesFromHTML::table_itor::FilterFoundHTML  ----- */
 
+    CleanTableText(table_text, table_data);
+    return true;
+}		/* -----  end of function TablesFromHTML::table_itor::CollectTableContent  ----- */
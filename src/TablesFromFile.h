@@ -43,12 +43,8 @@
 
 //#include <range/v3/all.hpp>
 
-#include <boost/regex.hpp>
-
 #include "Extractor.h"
 
-class CNode;
-
 // let's keep our found table content here,
 
 struct TableData
@@ -68,6 +64,11 @@ using TableDataList = std::vector<TableData>;
  * =====================================================================================
  *        Class:  TablesFromHTML
  *  Description:  Range compatible class to iterate over tables (if any) in block of text.
+ *
+ *                We find each table with a simple scan and parse just that table with
+ *                gumbo.  Our callers usually stop at the first table they like so we
+ *                never parse the rest of the document.  Tables we've already found are
+ *                kept so later iterations don't repeat the work.
  * =====================================================================================
  */
 class TablesFromHTML
@@ -114,29 +115,13 @@ private:
     mutable TableDataList found_tables_;
     mutable bool found_all_tables_ = false;
 
-    // these regexes are used to help parse the HTML.
+    // where to look for the next table we haven't found yet.
 
-    const boost::regex regex_table_{R"***(<table.*?>.*?</table>)***",
-        boost::regex_constants::normal | boost::regex_constants::icase};
+    mutable std::size_t search_from_ = 0;
 
-    // used to clean up the parsed data
+    // each table's text is collected here before we clean it up.
 
-    const boost::regex regex_bogus_em_dash{R"***(&#151;)***"};
-    const boost::regex regex_real_em_dash{R"***(&#8212;)***"};
-    const boost::regex regex_hi_ascii{R"***([^\x00-\x7f])***"};
-    const boost::regex regex_multiple_spaces{R"***( {2,})***"};
-    const boost::regex regex_space_tab{R"***( \t)***"};
-    const boost::regex regex_tab_before_paren{R"***(\t+\))***"};
-    const boost::regex regex_tabs_spaces{R"***(\t[ \t]+)***"};
-    const boost::regex regex_dollar_tab{R"***(\$\t)***"};
-    const boost::regex regex_leading_tab{R"***(^\t)***"};
-
-    const std::string pseudo_em_dash = "---";
-    const std::string delete_this = "";
-    const std::string one_space = " ";
-    const std::string one_tab = R"***(\t)***";
-    const std::string just_paren = ")";
-    const std::string just_dollar = "$";
+    mutable std::string table_text_;
 
 }; /* -----  end of class TablesFromHTML  ----- */
 
@@ -188,20 +173,14 @@ private:
     // ====================  METHODS       ======================================= 
 
     std::optional<TableData> FindNextTable();
-    std::string CollectTableContent(EM::TableContent html);
 
-    // a_table is non-const because the qumbo-query library doesn't do 'const'
+    // false if there's little or no text in the table.
 
-    std::string ExtractTextDataFromTable (CNode& a_table);
-    std::string FilterFoundHTML (const std::string& new_row_data);
+    bool CollectTableContent(EM::TableContent a_table, std::string& table_data);
 
     // ====================  DATA MEMBERS  ======================================= 
 
-    boost::cregex_token_iterator doc_;
-    boost::cregex_token_iterator end_;
-
     TablesFromHTML const * tables_ = nullptr;
-    EM::HTMLContent html_;
     
     mutable TableData table_data_;
 
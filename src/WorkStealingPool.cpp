@@ -0,0 +1,148 @@
+// =====================================================================================
+//
+//       Filename:  WorkStealingPool.cpp
+//
+//    Description:  Implementation of WorkStealingPool
+//
+//        Version:  1.0
+//        Created:  10/17/2026 11:02:37 AM
+//       Revision:  none
+//       Compiler:  g++
+//
+//         Author:  David P. Riedel (), driedel@cox.net
+//        License:  GNU General Public License -v3
+//
+// =====================================================================================
+
+#include <algorithm>
+
+#include "WorkStealingPool.h"
+#include "Extractor_Utils.h"
+
+//--------------------------------------------------------------------------------------
+//       Class:  WorkStealingPool
+//      Method:  WorkStealingPool
+// Description:  constructor
+//--------------------------------------------------------------------------------------
+WorkStealingPool::WorkStealingPool (int thread_count, TaskFunction task)
+    : task_{std::move(task)}, thread_count_{thread_count}
+{
+    BOOST_ASSERT_MSG(thread_count_ > 0, "Work stealing pool needs at least 1 thread.");
+
+    queues_.reserve(thread_count_);
+    for (int i = 0; i < thread_count_; ++i)
+    {
+        queues_.emplace_back(std::make_unique<WorkQueue>());
+    }
+}  // -----  end of method WorkStealingPool::WorkStealingPool  (constructor)  -----
+
+WorkStealingPool::~WorkStealingPool ()
+{
+    // don't leave any threads hanging if we are unwinding from an exception.
+
+    Stop();
+    Wait();
+}		// -----  end of method WorkStealingPool::~WorkStealingPool  -----
+
+/*
+ * ===  FUNCTION  ======================================================================
+ *         Name:  WorkStealingPool::Start
+ *  Description:  give each worker a contiguous block of the work list then turn
+ *                them loose.
+ * =====================================================================================
+ */
+void WorkStealingPool::Start (std::size_t work_count)
+{
+    BOOST_ASSERT_MSG(workers_.empty(), "Work stealing pool has already been started.");
+
+    const std::size_t block_size = work_count / thread_count_;
+    const std::size_t left_over = work_count % thread_count_;
+
+    std::size_t next_item{0};
+    for (std::size_t i = 0; i < queues_.size(); ++i)
+    {
+        const std::size_t this_block = block_size + (i < left_over ? 1 : 0);
+        for (std::size_t j = 0; j < this_block; ++j)
+        {
+            queues_[i]->items_.push_back(next_item++);
+        }
+    }
+
+    workers_.reserve(thread_count_);
+    for (int i = 0; i < thread_count_; ++i)
+    {
+        workers_.emplace_back(&WorkStealingPool::Worker, this, i);
+    }
+}		// -----  end of method WorkStealingPool::Start  -----
+
+/*
+ * ===  FUNCTION  ======================================================================
+ *         Name:  WorkStealingPool::Wait
+ *  Description:
+ * =====================================================================================
+ */
+void WorkStealingPool::Wait ()
+{
+    for (auto& worker : workers_)
+    {
+        if (worker.joinable())
+        {
+            worker.join();
+        }
+    }
+}		// -----  end of method WorkStealingPool::Wait  -----
+
+/*
+ * ===  FUNCTION  ======================================================================
+ *         Name:  WorkStealingPool::Worker
+ *  Description:  all the work is queued before we start so when there is
+ *                nothing left to take or steal, we are done.
+ * =====================================================================================
+ */
+void WorkStealingPool::Worker (int worker_id)
+{
+    while (! stop_requested_)
+    {
+        auto work_item = TakeOwnWork(worker_id);
+        if (! work_item)
+        {
+            work_item = StealWork(worker_id);
+        }
+        if (! work_item)
+        {
+            break;
+        }
+        task_(work_item.value());
+    }
+}		// -----  end of method WorkStealingPool::Worker  -----
+
+std::optional<std::size_t> WorkStealingPool::TakeOwnWork (int worker_id)
+{
+    auto& queue = *queues_[worker_id];
+    std::lock_guard<std::mutex> lk{queue.m_};
+    if (queue.items_.empty())
+    {
+        return std::nullopt;
+    }
+    auto work_item = queue.items_.front();
+    queue.items_.pop_front();
+    return work_item;
+}		// -----  end of method WorkStealingPool::TakeOwnWork  -----
+
+std::optional<std::size_t> WorkStealingPool::StealWork (int worker_id)
+{
+    // start with our neighbor so all the thieves don't pile onto the same victim.
+
+    for (int i = 1; i < thread_count_; ++i)
+    {
+        auto& queue = *queues_[(worker_id + i) % thread_count_];
+        std::lock_guard<std::mutex> lk{queue.m_};
+        if (! queue.items_.empty())
+        {
+            auto work_item = queue.items_.back();
+            queue.items_.pop_back();
+            return work_item;
+        }
+    }
+    return std::nullopt;
+}		// -----  end of method WorkStealingPool::StealWork  -----
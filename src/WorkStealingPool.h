@@ -0,0 +1,116 @@
+// =====================================================================================
+//
+//       Filename:  WorkStealingPool.h
+//
+//    Description:  Fixed size pool of worker threads which process a list of
+//                  work items using work-stealing deques.
+//
+//        Version:  1.0
+//        Created:  10/17/2026 10:48:19 AM
+//       Revision:  none
+//       Compiler:  g++
+//
+//         Author:  David P. Riedel (), driedel@cox.net
+//        License:  GNU General Public License -v3
+//
+// =====================================================================================
+
+// =====================================================================================
+//        Class:  WorkStealingPool
+//  Description:  Each worker owns a deque of work item indexes.  The list is split
+//                into contiguous blocks, one per worker, so workers mostly move
+//                through the list in order.  A worker takes items from the front
+//                of its own deque.  When its deque is empty, it steals from the back
+//                of another worker's deque so one very large filing doesn't leave
+//                the rest of its block waiting.
+//
+//                The task function is called with the index of the work item.
+//                It is responsible for reporting its own results.
+// =====================================================================================
+
+
+#ifndef  WorkStealingPool_INC
+#define  WorkStealingPool_INC
+
+#include <atomic>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <vector>
+
+class WorkStealingPool
+{
+public:
+
+    using TaskFunction = std::function<void(std::size_t)>;
+
+    // ====================  LIFECYCLE     =======================================
+
+    WorkStealingPool (int thread_count, TaskFunction task);    // constructor
+    WorkStealingPool(const WorkStealingPool& rhs) = delete;
+    WorkStealingPool(WorkStealingPool&& rhs) = delete;
+
+    ~WorkStealingPool ();
+
+    // ====================  ACCESSORS     =======================================
+
+    [[nodiscard]] int ThreadCount() const { return thread_count_; }
+    [[nodiscard]] bool StopRequested() const { return stop_requested_; }
+
+    // ====================  MUTATORS      =======================================
+
+    // queue up work items [0, work_count) and start the workers.
+
+    void Start(std::size_t work_count);
+
+    // no new work items will be started. tasks already running are allowed to finish.
+
+    void Stop() { stop_requested_ = true; }
+
+    // wait for all workers to finish.
+
+    void Wait();
+
+    // ====================  OPERATORS     =======================================
+
+    WorkStealingPool& operator = (const WorkStealingPool& rhs) = delete;
+    WorkStealingPool& operator = (WorkStealingPool&& rhs) = delete;
+
+protected:
+    // ====================  METHODS       =======================================
+
+    // ====================  DATA MEMBERS  =======================================
+
+private:
+
+    struct WorkQueue
+    {
+        std::mutex m_;
+        std::deque<std::size_t> items_;
+    };
+
+    // ====================  METHODS       =======================================
+
+    void Worker(int worker_id);
+
+    std::optional<std::size_t> TakeOwnWork(int worker_id);
+    std::optional<std::size_t> StealWork(int worker_id);
+
+    // ====================  DATA MEMBERS  =======================================
+
+    std::vector<std::unique_ptr<WorkQueue>> queues_;
+    std::vector<std::thread> workers_;
+
+    TaskFunction task_;
+
+    std::atomic<bool> stop_requested_{false};
+
+    int thread_count_;
+
+}; // -----  end of class WorkStealingPool  -----
+
+#endif   // ----- #ifndef WorkStealingPool_INC  -----
@@ -0,0 +1,511 @@
+// =====================================================================================
+//
+//       Filename:  XBRL_InstanceReader.cpp
+//
+//    Description:  Implementation of ExtractInstanceData
+//
+//        Version:  1.0
+//        Created:  10/17/2026 08:41:15 PM
+//       Revision:  none
+//       Compiler:  g++
+//
+//         Author:  David P. Riedel (), driedel@cox.net
+//        License:  GNU General Public License -v3
+//
+// =====================================================================================
+
+#include <algorithm>
+#include <memory>
+#include <optional>
+#include <string>
+
+#include <expat.h>
+
+#include "spdlog/spdlog.h"
+
+#include "Extractor_Utils.h"
+#include "Extractor_XBRL_FileFilter.h"
+#include "XBRL_InstanceReader.h"
+
+namespace
+{
+    const EM::sv US_GAAP_NS{"us-gaap:"};
+    const std::string US_GAAP_PFX{"us-gaap_"};
+    const std::string ALT_CONTEXT_PREFIX{"xbrli:"};
+
+    const EM::sv WHITE_SPACE{" \t\r\n"};
+
+    // same as pugixml's parse_wnorm_attribute: trim and collapse runs of white space.
+
+    void NormalizeAttribute(EM::sv value, std::string& result)
+    {
+        result.clear();
+        bool pending_space{false};
+        for (char c : value)
+        {
+            if (c == ' ' || c == '\t' || c == '\r' || c == '\n')
+            {
+                pending_space = ! result.empty();
+                continue;
+            }
+            if (pending_space)
+            {
+                result += ' ';
+                pending_space = false;
+            }
+            result += c;
+        }
+    }
+
+    // 'xbrli:' + 'context' without building a string.
+
+    bool IsPrefixedName(EM::sv name, EM::sv prefix, EM::sv local_name)
+    {
+        return name.size() == prefix.size() + local_name.size() && name.starts_with(prefix) && name.ends_with(local_name);
+    }
+
+    // the second form lets us re-use the same string for each fact.
+
+    void FindAttribute(const XML_Char** attributes, EM::sv name, std::string& result)
+    {
+        for (auto attribute = attributes; *attribute != nullptr; attribute += 2)
+        {
+            if (name == attribute[0])
+            {
+                NormalizeAttribute(attribute[1], result);
+                return;
+            }
+        }
+        result.clear();
+    }
+
+    std::string FindAttribute(const XML_Char** attributes, EM::sv name)
+    {
+        std::string result;
+        FindAttribute(attributes, name, result);
+        return result;
+    }
+
+    // =====================================================================================
+    //        Class:  InstanceHandler
+    //  Description:  expat callbacks.  Depth 1 is the <xbrl> node so the facts, contexts
+    //                and dei values we want are all at depth 2.
+    //
+    //                For an element's value we mimic pugixml's child_value(): the first
+    //                text or CDATA directly inside the element, skipping text which is
+    //                only white space.  We only collect text for the 1 element we want
+    //                at the moment and never for facts without units (text blocks)
+    //                since those would be dropped anyway.
+    // =====================================================================================
+
+    class InstanceHandler
+    {
+    public:
+        // ====================  LIFECYCLE     =======================================
+
+        explicit InstanceHandler (std::pmr::memory_resource* resource) : gaap_data_{resource} { }
+        InstanceHandler(const InstanceHandler& rhs) = delete;
+        InstanceHandler(InstanceHandler&& rhs) = delete;
+
+        ~InstanceHandler () = default;
+
+        // ====================  ACCESSORS     =======================================
+
+        // ====================  MUTATORS      =======================================
+
+        // false if expat didn't like the document.
+
+        bool Parse(EM::sv document);
+
+        XBRL_InstanceData GetResults();
+
+        // ====================  OPERATORS     =======================================
+
+        InstanceHandler& operator = (const InstanceHandler& rhs) = delete;
+        InstanceHandler& operator = (InstanceHandler&& rhs) = delete;
+
+    private:
+        // ====================  METHODS       =======================================
+
+        void StartElement(EM::sv name, const XML_Char** attributes);
+        void EndElement();
+        void AddText(EM::sv text);
+
+        // anything other than text inside the element we are collecting
+        // ends a piece of text.
+
+        void EndTextSegment(bool is_cdata);
+
+        void StartValue();
+        std::string EndValue();
+        bool CollectingText() const { return capture_ != Capture::e_None && depth_ == capture_depth_; }
+
+        static void OnStartElement(void* user_data, const XML_Char* name, const XML_Char** attributes)
+            { static_cast<InstanceHandler*>(user_data)->StartElement(name, attributes); }
+        static void OnEndElement(void* user_data, const XML_Char* /* name */)
+            { static_cast<InstanceHandler*>(user_data)->EndElement(); }
+        static void OnCharacterData(void* user_data, const XML_Char* text, int length)
+            { static_cast<InstanceHandler*>(user_data)->AddText(EM::sv{text, static_cast<std::size_t>(length)}); }
+        static void OnStartCdata(void* user_data);
+        static void OnEndCdata(void* user_data);
+        static void OnComment(void* user_data, const XML_Char* /* text */);
+        static void OnProcessingInstruction(void* user_data, const XML_Char* /* target */, const XML_Char* /* data */);
+
+        // ====================  DATA MEMBERS  =======================================
+
+        enum class Capture { e_None, e_GAAP, e_TradingSymbol, e_SharesOutstanding, e_PeriodEndDate, e_Instant, e_StartDate, e_EndDate };
+
+        struct ContextEntry
+        {
+            std::string id_;
+            EM::Extractor_TimePeriod period_;
+        };
+
+        int depth_ = 0;
+        std::string root_prefix_;
+
+        // the element whose value we are collecting.
+
+        Capture capture_ = Capture::e_None;
+        int capture_depth_ = 0;
+        std::string text_segment_;
+        std::optional<std::string> value_;
+
+        std::optional<std::string> trading_symbol_;
+        std::optional<std::string> shares_outstanding_;
+        std::optional<std::string> period_end_date_;
+
+        // the fact we are working on.
+
+        std::string gaap_label_{US_GAAP_PFX};
+        std::string gaap_context_ID_;
+        std::string gaap_units_;
+        std::string gaap_decimals_;
+
+        EM::GAAP_DataList gaap_data_;
+
+        // contexts are normally named with the same prefix as the <xbrl> node but
+        // some files only use 'xbrli:' there so we keep both until we know.
+
+        bool in_context_ = false;
+        std::string context_prefix_;
+        std::string context_id_;
+        bool in_period_ = false;
+        bool seen_period_ = false;
+        std::optional<std::string> instant_;
+        std::optional<std::string> start_date_;
+        std::optional<std::string> end_date_;
+
+        std::vector<ContextEntry> contexts_;
+        std::vector<ContextEntry> alt_contexts_;
+
+    }; // -----  end of class InstanceHandler  -----
+
+    bool InstanceHandler::Parse (EM::sv document)
+    {
+        // our content starts right after the <XBRL> tag and expat wants
+        // any XML declaration to be at the very beginning.
+
+        document.remove_prefix(std::min(document.find_first_not_of(WHITE_SPACE), document.size()));
+
+        std::unique_ptr<std::remove_pointer_t<XML_Parser>, decltype(&XML_ParserFree)> parser{XML_ParserCreate(nullptr), &XML_ParserFree};
+        BOOST_ASSERT_MSG(parser, "Unable to create XML parser.");
+
+        XML_SetUserData(parser.get(), this);
+        XML_SetElementHandler(parser.get(), &InstanceHandler::OnStartElement, &InstanceHandler::OnEndElement);
+        XML_SetCharacterDataHandler(parser.get(), &InstanceHandler::OnCharacterData);
+        XML_SetCdataSectionHandler(parser.get(), &InstanceHandler::OnStartCdata, &InstanceHandler::OnEndCdata);
+        XML_SetCommentHandler(parser.get(), &InstanceHandler::OnComment);
+        XML_SetProcessingInstructionHandler(parser.get(), &InstanceHandler::OnProcessingInstruction);
+
+        // expat takes an int length so feed it in pieces.
+
+        constexpr std::size_t chunk_size = 16 * 1024 * 1024;
+        do
+        {
+            const auto this_chunk = std::min(document.size(), chunk_size);
+            const bool is_final = this_chunk == document.size();
+            if (XML_Parse(parser.get(), document.data(), static_cast<int>(this_chunk), is_final ? XML_TRUE : XML_FALSE) != XML_STATUS_OK)
+            {
+                spdlog::debug(catenate("Streaming XBRL parse failed: ", XML_ErrorString(XML_GetErrorCode(parser.get())),
+                            " at line: ", XML_GetCurrentLineNumber(parser.get())));
+                return false;
+            }
+            document.remove_prefix(this_chunk);
+        } while (! document.empty());
+
+        return true;
+    }		// -----  end of method InstanceHandler::Parse  -----
+
+    void InstanceHandler::StartElement (EM::sv name, const XML_Char** attributes)
+    {
+        if (CollectingText())
+        {
+            EndTextSegment(false);
+        }
+        ++depth_;
+
+        if (depth_ == 1)
+        {
+            if (auto pos = name.find(':'); pos != EM::sv::npos)
+            {
+                root_prefix_ = name.substr(0, pos + 1);
+            }
+        }
+        else if (depth_ == 2)
+        {
+            if (name.starts_with(US_GAAP_NS))
+            {
+                FindAttribute(attributes, "unitRef", gaap_units_);
+                if (! gaap_units_.empty())
+                {
+                    gaap_label_.resize(US_GAAP_PFX.size());
+                    gaap_label_ += name.substr(US_GAAP_NS.size());
+                    FindAttribute(attributes, "contextRef", gaap_context_ID_);
+                    FindAttribute(attributes, "decimals", gaap_decimals_);
+                    capture_ = Capture::e_GAAP;
+                    StartValue();
+                }
+            }
+            else if (name == "dei:TradingSymbol" && ! trading_symbol_)
+            {
+                capture_ = Capture::e_TradingSymbol;
+                StartValue();
+            }
+            else if (name == "dei:EntityCommonStockSharesOutstanding" && ! shares_outstanding_)
+            {
+                capture_ = Capture::e_SharesOutstanding;
+                StartValue();
+            }
+            else if (name == "dei:DocumentPeriodEndDate" && ! period_end_date_)
+            {
+                capture_ = Capture::e_PeriodEndDate;
+                StartValue();
+            }
+            else if (IsPrefixedName(name, root_prefix_, "context") || IsPrefixedName(name, ALT_CONTEXT_PREFIX, "context"))
+            {
+                in_context_ = true;
+                context_prefix_ = name.substr(0, name.size() - 7);
+                context_id_ = FindAttribute(attributes, "id");
+                seen_period_ = false;
+                instant_.reset();
+                start_date_.reset();
+                end_date_.reset();
+            }
+        }
+        else if (depth_ == 3)
+        {
+            // only the first period counts.
+
+            if (in_context_ && ! seen_period_ && IsPrefixedName(name, context_prefix_, "period"))
+            {
+                in_period_ = true;
+                seen_period_ = true;
+            }
+        }
+        else if (depth_ == 4 && in_period_)
+        {
+            if (! instant_ && IsPrefixedName(name, context_prefix_, "instant"))
+            {
+                capture_ = Capture::e_Instant;
+                StartValue();
+            }
+            else if (! start_date_ && IsPrefixedName(name, context_prefix_, "startDate"))
+            {
+                capture_ = Capture::e_StartDate;
+                StartValue();
+            }
+            else if (! end_date_ && IsPrefixedName(name, context_prefix_, "endDate"))
+            {
+                capture_ = Capture::e_EndDate;
+                StartValue();
+            }
+        }
+    }		// -----  end of method InstanceHandler::StartElement  -----
+
+    void InstanceHandler::EndElement ()
+    {
+        if (CollectingText())
+        {
+            auto value = EndValue();
+            switch (capture_)
+            {
+                case Capture::e_GAAP:
+
+                    // need to filter out table type content.
+
+                    if (value.empty() || value.find("<table") != std::string::npos || value.find("<div") != std::string::npos
+                            || value.find("<p ") != std::string::npos)
+                    {
+                        break;
+                    }
+                    gaap_data_.Add(gaap_label_, gaap_context_ID_, gaap_units_, gaap_decimals_, value);
+                    break;
+
+                case Capture::e_TradingSymbol:
+                    trading_symbol_ = std::move(value);
+                    break;
+
+                case Capture::e_SharesOutstanding:
+                    shares_outstanding_ = std::move(value);
+                    break;
+
+                case Capture::e_PeriodEndDate:
+                    period_end_date_ = std::move(value);
+                    break;
+
+                case Capture::e_Instant:
+                    instant_ = std::move(value);
+                    break;
+
+                case Capture::e_StartDate:
+                    start_date_ = std::move(value);
+                    break;
+
+                case Capture::e_EndDate:
+                    end_date_ = std::move(value);
+                    break;
+
+                case Capture::e_None:
+                    break;
+            }
+            capture_ = Capture::e_None;
+        }
+        else if (depth_ == 3 && in_period_)
+        {
+            in_period_ = false;
+        }
+        else if (depth_ == 2 && in_context_)
+        {
+            // need to pull out begin/end values.
+
+            ContextEntry entry{std::move(context_id_), {}};
+            if (instant_)
+            {
+                entry.period_ = {instant_.value(), instant_.value()};
+            }
+            else
+            {
+                entry.period_ = {start_date_.value_or(""), end_date_.value_or("")};
+            }
+            (context_prefix_ == root_prefix_ ? contexts_ : alt_contexts_).push_back(std::move(entry));
+            in_context_ = false;
+        }
+        --depth_;
+    }		// -----  end of method InstanceHandler::EndElement  -----
+
+    void InstanceHandler::AddText (EM::sv text)
+    {
+        if (CollectingText() && ! value_)
+        {
+            text_segment_.append(text);
+        }
+    }		// -----  end of method InstanceHandler::AddText  -----
+
+    void InstanceHandler::EndTextSegment (bool is_cdata)
+    {
+        // pugixml drops text which is only white space but keeps any CDATA.
+
+        if (! value_ && (is_cdata || text_segment_.find_first_not_of(WHITE_SPACE) != std::string::npos))
+        {
+            value_ = std::move(text_segment_);
+        }
+        text_segment_.clear();
+    }		// -----  end of method InstanceHandler::EndTextSegment  -----
+
+    void InstanceHandler::StartValue ()
+    {
+        capture_depth_ = depth_;
+        text_segment_.clear();
+        value_.reset();
+    }		// -----  end of method InstanceHandler::StartValue  -----
+
+    std::string InstanceHandler::EndValue ()
+    {
+        EndTextSegment(false);
+        return value_.value_or("");
+    }		// -----  end of method InstanceHandler::EndValue  -----
+
+    void InstanceHandler::OnStartCdata (void* user_data)
+    {
+        auto* handler = static_cast<InstanceHandler*>(user_data);
+        if (handler->CollectingText())
+        {
+            handler->EndTextSegment(false);
+        }
+    }		// -----  end of method InstanceHandler::OnStartCdata  -----
+
+    void InstanceHandler::OnEndCdata (void* user_data)
+    {
+        auto* handler = static_cast<InstanceHandler*>(user_data);
+        if (handler->CollectingText())
+        {
+            handler->EndTextSegment(true);
+        }
+    }		// -----  end of method InstanceHandler::OnEndCdata  -----
+
+    void InstanceHandler::OnComment (void* user_data, const XML_Char* /* text */)
+    {
+        auto* handler = static_cast<InstanceHandler*>(user_data);
+        if (handler->CollectingText())
+        {
+            handler->EndTextSegment(false);
+        }
+    }		// -----  end of method InstanceHandler::OnComment  -----
+
+    void InstanceHandler::OnProcessingInstruction (void* user_data, const XML_Char* /* target */, const XML_Char* /* data */)
+    {
+        auto* handler = static_cast<InstanceHandler*>(user_data);
+        if (handler->CollectingText())
+        {
+            handler->EndTextSegment(false);
+        }
+    }		// -----  end of method InstanceHandler::OnProcessingInstruction  -----
+
+    XBRL_InstanceData InstanceHandler::GetResults ()
+    {
+        const auto period_end_date = period_end_date_.value_or("");
+        const auto shares_outstanding = shares_outstanding_.value_or("");
+
+        // the facts must be moved, not assigned, so they stay in their arena.
+
+        XBRL_InstanceData results{EM::FilingData{trading_symbol_.value_or(""), period_end_date,
+            ConvertPeriodEndDateToContextName(period_end_date), shares_outstanding.empty() ? "-1" : shares_outstanding},
+            std::move(gaap_data_), {}};
+
+        const auto& contexts = ! contexts_.empty() ? contexts_ : alt_contexts_;
+        if (contexts.empty())
+        {
+            throw XBRLException("Can't find 'context' section in file.");
+        }
+        for (const auto& [id, period] : contexts)
+        {
+            if (auto [it, success] = results.context_data_.try_emplace(id, period); ! success)
+            {
+                spdlog::debug(catenate("Can't insert value for label: ", id).c_str());
+            }
+        }
+        return results;
+    }		// -----  end of method InstanceHandler::GetResults  -----
+}
+
+// ===  FUNCTION  ======================================================================
+//         Name:  ExtractInstanceData
+//  Description:  
+// =====================================================================================
+XBRL_InstanceData ExtractInstanceData (EM::XBRLContent instance_document, std::pmr::memory_resource* resource)
+{
+    InstanceHandler handler{resource};
+    if (handler.Parse(instance_document.get()))
+    {
+        return handler.GetResults();
+    }
+
+    auto instance_xml = ParseXMLContent(instance_document);
+
+    auto filing_data = ExtractFilingData(instance_xml);
+    auto gaap_data = ExtractGAAPFields(instance_xml, resource);
+    auto context_data = ExtractContextDefinitions(instance_xml);
+
+    return {std::move(filing_data), std::move(gaap_data), std::move(context_data)};
+}		// -----  end of function ExtractInstanceData  -----
@@ -0,0 +1,42 @@
+// =====================================================================================
+//
+//       Filename:  XBRL_InstanceReader.h
+//
+//    Description:  Collect what we need from an XBRL instance document in 1 streaming
+//                  pass instead of building a DOM and walking it 3 times.
+//
+//        Version:  1.0
+//        Created:  10/17/2026 08:41:15 PM
+//       Revision:  none
+//       Compiler:  g++
+//
+//         Author:  David P. Riedel (), driedel@cox.net
+//        License:  GNU General Public License -v3
+//
+// =====================================================================================
+
+
+#ifndef  XBRL_InstanceReader_INC
+#define  XBRL_InstanceReader_INC
+
+#include <memory_resource>
+
+#include "Extractor.h"
+
+struct XBRL_InstanceData
+{
+    EM::FilingData filing_data_;
+    EM::GAAP_DataList gaap_data_;
+    EM::ContextPeriod context_data_;
+};
+
+// gives the same results as ExtractFilingData, ExtractGAAPFields and
+// ExtractContextDefinitions on the parsed document.  Anything expat won't
+// accept is handed to pugixml and done the old way so we are no stricter
+// than before.
+// the facts are kept in 'resource', normally the filing's arena.
+
+XBRL_InstanceData ExtractInstanceData(EM::XBRLContent instance_document,
+        std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+
+#endif   // ----- #ifndef XBRL_InstanceReader_INC  -----
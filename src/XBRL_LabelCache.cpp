@@ -0,0 +1,230 @@
+// =====================================================================================
+//
+//       Filename:  XBRL_LabelCache.cpp
+//
+//    Description:  Implementation of XBRL_LabelCache
+//
+//        Version:  1.0
+//        Created:  10/17/2026 09:27:40 PM
+//       Revision:  none
+//       Compiler:  g++
+//
+//         Author:  David P. Riedel (), driedel@cox.net
+//        License:  GNU General Public License -v3
+//
+// =====================================================================================
+
+#include <algorithm>
+#include <charconv>
+#include <filesystem>
+#include <fstream>
+
+#include "spdlog/spdlog.h"
+
+#include "Extractor_Utils.h"
+#include "MappedFile.h"
+#include "XBRL_LabelCache.h"
+
+namespace fs = std::filesystem;
+
+namespace
+{
+    // each entry is: "<name size> <label size>\n<name><label>\n"
+    // so any text at all round trips.
+
+    const EM::sv cache_file_header{"XBRL label cache 1\n"};
+
+    bool ParseSize(EM::sv digits, std::size_t& result)
+    {
+        auto [ptr, ec] = std::from_chars(digits.data(), digits.data() + digits.size(), result);
+        return ec == std::errc() && ptr == digits.data() + digits.size();
+    }
+}
+
+XBRL_LabelCache::XBRL_LabelCache ()
+{
+    auto empty = std::make_unique<const LabelMap>();
+    current_.store(empty.get());
+    snapshots_.push_back(std::move(empty));
+}  // -----  end of method XBRL_LabelCache::XBRL_LabelCache  (constructor)  -----
+
+/*
+ * ===  FUNCTION  ======================================================================
+ *         Name:  XBRL_LabelCache::Find
+ *  Description:  an empty label is no better than a missing one so we treat
+ *                them the same, just as FindOrDefault does.
+ * =====================================================================================
+ */
+EM::Extractor_Labels XBRL_LabelCache::Find (const EM::GAAP_DataList& gaap_data, std::unordered_set<EM::sv>& missing_names) const
+{
+    const LabelMap* current = current_.load(std::memory_order_acquire);
+
+    EM::Extractor_Labels result;
+    std::vector<bool> seen(gaap_data.DistinctStrings(), false);
+    for (const auto& field : gaap_data)
+    {
+        if (seen[field.label])
+        {
+            continue;
+        }
+        seen[field.label] = true;
+        auto name = gaap_data.Text(field.label);
+        auto found = current->find(name);
+        if (found == current->end())
+        {
+            missing_names.insert(name);
+            continue;
+        }
+        result.emplace(name, found->second);
+    }
+    return result;
+}		// -----  end of method XBRL_LabelCache::Find  -----
+
+std::size_t XBRL_LabelCache::size () const
+{
+    return current_.load(std::memory_order_acquire)->size();
+}		// -----  end of method XBRL_LabelCache::size  -----
+
+void XBRL_LabelCache::Add (const EM::Extractor_Labels& labels)
+{
+    std::lock_guard<std::mutex> lk{m_};
+
+    for (const auto& [name, label] : labels)
+    {
+        AddEntry(name, label);
+    }
+
+    // publishing copies everything we have so we wait for more additions
+    // as we grow.  That keeps the total copying linear in our size.
+
+    if (pending_.size() >= std::max(min_pending_entries_, current_.load(std::memory_order_relaxed)->size() / 8))
+    {
+        Publish();
+    }
+}		// -----  end of method XBRL_LabelCache::Add  -----
+
+/*
+ * ===  FUNCTION  ======================================================================
+ *         Name:  XBRL_LabelCache::Load
+ *  Description:  a damaged file is an error.  We don't want to silently start cold
+ *                and then write over it when we are done.
+ * =====================================================================================
+ */
+void XBRL_LabelCache::Load (const EM::FileName& cache_file_name)
+{
+    MappedFile cache_file{cache_file_name};
+    EM::sv content = cache_file.GetContent().get();
+
+    BOOST_ASSERT_MSG(content.starts_with(cache_file_header),
+            catenate("Not a label cache file: ", cache_file_name.get().string()).c_str());
+    content.remove_prefix(cache_file_header.size());
+
+    std::lock_guard<std::mutex> lk{m_};
+
+    while (! content.empty())
+    {
+        auto sizes_end = content.find('\n');
+        auto separator = content.find(' ');
+        std::size_t name_size{0};
+        std::size_t label_size{0};
+        if (sizes_end == EM::sv::npos || separator > sizes_end
+                || ! ParseSize(content.substr(0, separator), name_size)
+                || ! ParseSize(content.substr(separator + 1, sizes_end - separator - 1), label_size)
+                || content.size() - sizes_end - 1 <= name_size + label_size
+                || content[sizes_end + 1 + name_size + label_size] != '\n')
+        {
+            throw ExtractorException(catenate("Damaged label cache file: ", cache_file_name.get().string()));
+        }
+        content.remove_prefix(sizes_end + 1);
+        AddEntry(content.substr(0, name_size), content.substr(name_size, label_size));
+        content.remove_prefix(name_size + label_size + 1);
+    }
+    Publish();
+
+    spdlog::info(catenate("Loaded: ", size(), " XBRL labels from: ", cache_file_name.get().string()));
+}		// -----  end of method XBRL_LabelCache::Load  -----
+
+/*
+ * ===  FUNCTION  ======================================================================
+ *         Name:  XBRL_LabelCache::Save
+ *  Description:  we write to a temporary file and rename it so an interrupted
+ *                save leaves any existing cache file as it was.
+ * =====================================================================================
+ */
+void XBRL_LabelCache::Save (const EM::FileName& cache_file_name)
+{
+    std::lock_guard<std::mutex> lk{m_};
+
+    Publish();
+    const LabelMap* current = current_.load(std::memory_order_relaxed);
+
+    fs::path temp_file_name{cache_file_name.get()};
+    temp_file_name += ".tmp";
+
+    {
+        std::ofstream cache_file{temp_file_name, std::ios::out | std::ios::binary | std::ios::trunc};
+        if (! cache_file)
+        {
+            throw ExtractorException(catenate("Can't open label cache file: ", temp_file_name.string()));
+        }
+        cache_file << cache_file_header;
+        for (auto [name, label] : *current)
+        {
+            cache_file << name.size() << ' ' << label.size() << '\n' << name << label << '\n';
+        }
+        cache_file.close();
+        if (cache_file.fail())
+        {
+            throw ExtractorException(catenate("Problem writing label cache file: ", temp_file_name.string()));
+        }
+    }
+    fs::rename(temp_file_name, cache_file_name.get());
+
+    spdlog::info(catenate("Saved: ", current->size(), " XBRL labels to: ", cache_file_name.get().string()));
+}		// -----  end of method XBRL_LabelCache::Save  -----
+
+EM::sv XBRL_LabelCache::Intern (EM::sv text)
+{
+    if (auto found = interned_.find(text); found != interned_.end())
+    {
+        return *found;
+    }
+
+    // a deque never moves its elements as it grows so our views stay good.
+
+    EM::sv result{strings_.emplace_back(text)};
+    interned_.insert(result);
+    return result;
+}		// -----  end of method XBRL_LabelCache::Intern  -----
+
+void XBRL_LabelCache::AddEntry (EM::sv name, EM::sv label)
+{
+    if (name.empty() || label.empty())
+    {
+        return;
+    }
+    const LabelMap* current = current_.load(std::memory_order_relaxed);
+    if (current->find(name) != current->end() || pending_.find(name) != pending_.end())
+    {
+        return;
+    }
+    pending_.emplace(Intern(name), Intern(label));
+}		// -----  end of method XBRL_LabelCache::AddEntry  -----
+
+void XBRL_LabelCache::Publish ()
+{
+    if (pending_.empty())
+    {
+        return;
+    }
+    const LabelMap* current = current_.load(std::memory_order_relaxed);
+
+    auto next = std::make_unique<LabelMap>();
+    next->reserve(current->size() + pending_.size());
+    next->insert(current->begin(), current->end());
+    next->insert(pending_.begin(), pending_.end());
+    pending_.clear();
+
+    current_.store(next.get(), std::memory_order_release);
+    snapshots_.push_back(std::move(next));
+}		// -----  end of method XBRL_LabelCache::Publish  -----
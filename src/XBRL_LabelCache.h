@@ -0,0 +1,129 @@
+// =====================================================================================
+//
+//       Filename:  XBRL_LabelCache.h
+//
+//    Description:  us-gaap element name -> label pairs shared by every filing in a run
+//
+//        Version:  1.0
+//        Created:  10/17/2026 09:27:40 PM
+//       Revision:  none
+//       Compiler:  g++
+//
+//         Author:  David P. Riedel (), driedel@cox.net
+//        License:  GNU General Public License -v3
+//
+// =====================================================================================
+
+
+// =====================================================================================
+//        Class:  XBRL_LabelCache
+//  Description:  Most of the fields in a filing are standard us-gaap elements which
+//                carry the same label from filer to filer.  We keep every label we
+//                have seen so a filing whose fields are all known doesn't need its
+//                label document parsed at all and for any other filing we need only
+//                look up the ones we don't know.  The first label seen for a name is
+//                the one we keep.
+//
+//                Names and labels are stored once.  Readers work from an immutable
+//                snapshot they pick up with a single atomic load so they never
+//                wait.  Additions are staged and published as a new snapshot in
+//                batches.  Old snapshots are kept until we are destroyed since we
+//                can't know when the last reader is done with one.
+//
+//                The cache can be saved to and loaded from a file so later runs
+//                start warm.
+// =====================================================================================
+
+
+#ifndef  XBRL_LabelCache_INC
+#define  XBRL_LabelCache_INC
+
+#include <atomic>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "Extractor.h"
+
+class XBRL_LabelCache
+{
+public:
+
+    // ====================  LIFECYCLE     =======================================
+
+    XBRL_LabelCache ();                             // constructor
+    XBRL_LabelCache(const XBRL_LabelCache& rhs) = delete;
+    XBRL_LabelCache(XBRL_LabelCache&& rhs) = delete;
+
+    ~XBRL_LabelCache () = default;
+
+    // ====================  ACCESSORS     =======================================
+
+    // labels for the fields in a filing we know about.  The names of the others
+    // are added to 'missing_names'.
+
+    [[nodiscard]] EM::Extractor_Labels Find(const EM::GAAP_DataList& gaap_data, std::unordered_set<EM::sv>& missing_names) const;
+
+    [[nodiscard]] std::size_t size() const;
+
+    // ====================  MUTATORS      =======================================
+
+    // names we already have keep their labels.
+
+    void Add(const EM::Extractor_Labels& labels);
+
+    // adds to any existing content.
+
+    void Load(const EM::FileName& cache_file_name);
+
+    // publishes anything waiting before writing.
+
+    void Save(const EM::FileName& cache_file_name);
+
+    // ====================  OPERATORS     =======================================
+
+    XBRL_LabelCache& operator = (const XBRL_LabelCache& rhs) = delete;
+    XBRL_LabelCache& operator = (XBRL_LabelCache&& rhs) = delete;
+
+protected:
+    // ====================  METHODS       =======================================
+
+    // ====================  DATA MEMBERS  =======================================
+
+private:
+
+    using LabelMap = std::unordered_map<EM::sv, EM::sv>;
+
+    // ====================  METHODS       =======================================
+
+    // caller holds the lock for these.
+
+    EM::sv Intern(EM::sv text);
+    void AddEntry(EM::sv name, EM::sv label);
+    void Publish();
+
+    // ====================  DATA MEMBERS  =======================================
+
+    // we publish once this many additions are waiting or an eighth of
+    // our current size, whichever is larger.
+
+    static constexpr std::size_t min_pending_entries_ = 256;
+
+    std::atomic<const LabelMap*> current_;
+
+    // everything below belongs to writers.
+
+    std::mutex m_;
+
+    std::deque<std::string> strings_;
+    std::unordered_set<EM::sv> interned_;
+    LabelMap pending_;
+    std::vector<std::unique_ptr<const LabelMap>> snapshots_;
+
+}; // -----  end of class XBRL_LabelCache  -----
+
+#endif   // ----- #ifndef XBRL_LabelCache_INC  -----
@@ -26,6 +26,133 @@
 #include "Extractor_Utils.h"
 
 
+namespace
+{
+    std::string ToLower(std::string text)
+    {
+        text |= ranges::actions::transform([](unsigned char c) { return std::tolower(c); });
+        return text;
+    }
+
+    // fills in the cells of the next row in the sheet. False if we are out of rows.
+
+    bool ReadNextRow(xlsxioreadersheet sheet, XLS_Row& row)
+    {
+        row.clear();
+        if (! xlsxioread_sheet_next_row(sheet))
+        {
+            return false;
+        }
+
+        XLSXIOCHAR* next_cell = nullptr;
+        while ((next_cell = xlsxioread_sheet_next_cell(sheet)) != nullptr)
+        {
+            row.AddCell(next_cell);
+            free(next_cell);
+        }
+        return true;
+    }
+}
+
+// =====================================================================================
+//        Class:  XLS_Workbook
+//  Description:  the content has to outlive the reader since the reader works
+//                directly on our buffer.
+//
+//                Getting the title from inside a sheet means decompressing the
+//                head of it so we only do that when someone asks and then keep it.
+// =====================================================================================
+
+struct XLS_Workbook
+{
+    struct SheetEntry
+    {
+        std::string sheet_name_mc_;
+        std::string sheet_name_lc_;
+        mutable std::optional<std::string> sheet_name_inside_;
+    };
+
+    explicit XLS_Workbook(std::vector<char>&& content);
+    XLS_Workbook(const XLS_Workbook& rhs) = delete;
+    ~XLS_Workbook();
+
+    const std::string& GetSheetNameFromInside(std::size_t sheet_index) const;
+
+    XLS_Workbook& operator = (const XLS_Workbook& rhs) = delete;
+
+    std::vector<char> content_;
+    xlsxioreader xlsxioread_ = nullptr;
+    std::vector<SheetEntry> sheets_;
+};
+
+XLS_Workbook::XLS_Workbook (std::vector<char>&& content)
+    : content_{std::move(content)}
+{
+    if (content_.empty())
+    {
+        return;
+    }
+
+    // it's possible we won't be able to read the data in which case
+    // our handle will be null and we have no sheets.
+
+    xlsxioread_ = xlsxioread_open_memory (content_.data(), content_.size(), 0);
+    if (xlsxioread_ == nullptr)
+    {
+        return;
+    }
+
+    auto list_closer = [](xlsxioreadersheetlist sheet_list) { xlsxioread_sheetlist_close(sheet_list); };
+
+    std::unique_ptr<xlsxio_read_sheetlist_struct, std::function<void(xlsxioreadersheetlist)>> sheet_list =
+        {xlsxioread_sheetlist_open(xlsxioread_), list_closer};
+    if (! sheet_list)
+    {
+        return;
+    }
+    const XLSXIOCHAR* sheet_name = nullptr;
+    while ((sheet_name = xlsxioread_sheetlist_next(sheet_list.get())) != nullptr)
+    {
+        sheets_.push_back({sheet_name, ToLower(sheet_name), std::nullopt});
+    }
+}  // -----  end of method XLS_Workbook::XLS_Workbook  (constructor)  ----- 
+
+XLS_Workbook::~XLS_Workbook ()
+{
+    if (xlsxioread_ != nullptr)
+    {
+        xlsxioread_close(xlsxioread_);
+    }
+}  // -----  end of method XLS_Workbook::~XLS_Workbook  (destructor)  ----- 
+
+const std::string& XLS_Workbook::GetSheetNameFromInside (std::size_t sheet_index) const
+{
+    // we need to go and read the cells from our sheet
+    // and get the content of the first cell.
+
+    auto& sheet = sheets_[sheet_index];
+    if (sheet.sheet_name_inside_)
+    {
+        // use cached result
+
+        return sheet.sheet_name_inside_.value();
+    }
+    sheet.sheet_name_inside_.emplace();
+
+    auto sheet_closer = [](xlsxioreadersheet sheet_reader) { xlsxioread_sheet_close(sheet_reader); };
+
+    std::unique_ptr<xlsxio_read_sheet_struct, std::function<void(xlsxioreadersheet)>> temp_sheet =
+        {xlsxioread_sheet_open(xlsxioread_, sheet.sheet_name_mc_.c_str(), 0), sheet_closer};
+    if (temp_sheet)
+    {
+        if (XLS_Row first_row; ReadNextRow(temp_sheet.get(), first_row))
+        {
+            sheet.sheet_name_inside_ = ToLower(std::string{first_row[0]});
+        }
+    }
+    return sheet.sheet_name_inside_.value();
+}		// -----  end of method XLS_Workbook::GetSheetNameFromInside  ----- 
+
 //--------------------------------------------------------------------------------------
 //       Class:  XLS_File
 //      Method:  XLS_File
@@ -33,43 +160,38 @@
 //--------------------------------------------------------------------------------------
 
 XLS_File::XLS_File (const std::vector<char>& content)
-    : content_{content}
+    : workbook_{std::make_shared<XLS_Workbook>(std::vector<char>{content})}
 {
 }  // -----  end of method XLS_File::XLS_File  (constructor)  ----- 
 
 XLS_File::XLS_File (std::vector<char>&& content)
-    : content_{std::move(content)}
-{
-}  // -----  end of method XLS_File::XLS_File  (constructor)  ----- 
-
-XLS_File::XLS_File (const XLS_File& rhs)
-    : content_{rhs.content_}
+    : workbook_{std::make_shared<XLS_Workbook>(std::move(content))}
 {
 }  // -----  end of method XLS_File::XLS_File  (constructor)  ----- 
 
-XLS_File::XLS_File (XLS_File&& rhs) noexcept
-    : content_{std::move(rhs.content_)}
+bool XLS_File::empty () const
 {
-}  // -----  end of method XLS_File::XLS_File  (constructor)  ----- 
+    return ! workbook_ || workbook_->content_.empty();
+}		// -----  end of method XLS_File::empty  ----- 
 
 XLS_File::iterator XLS_File::begin ()
 {
-    if (content_.empty())
+    if (! workbook_ || workbook_->sheets_.empty())
     {
         return {};
     }
 
-    return {&content_} ;
+    return {workbook_} ;
 }		// -----  end of method XLS_File::begin  ----- 
 
 XLS_File::const_iterator XLS_File::begin () const
 {
-    if (content_.empty())
+    if (! workbook_ || workbook_->sheets_.empty())
     {
         return {};
     }
 
-    return {&content_} ;
+    return {workbook_} ;
 }		// -----  end of method XLS_File::begin  ----- 
 
 XLS_File::iterator XLS_File::end ()
@@ -84,67 +206,30 @@ XLS_File::const_iterator XLS_File::end () const
 
 }		// -----  end of method XLS_File::end  ----- 
 
-XLS_File& XLS_File::operator= (const XLS_File& rhs)
-{
-    if (&rhs != this)
-    {
-        content_ = rhs.content_;
-    }
-    return *this;
-}		// -----  end of method XLS_File::operator=  ----- 
-
-XLS_File& XLS_File::operator= (XLS_File&& rhs) noexcept
-{
-    if (&rhs != this)
-    {
-        content_ = std::move(rhs.content_);
-    }
-    return *this;
-}		// -----  end of method XLS_File::operator=  ----- 
-
 std::vector<std::string> XLS_File::GetSheetNames() const
 {
-    if (content_.empty())
+    if (! workbook_)
     {
         return {};
     }
 
-    auto file_closer = [](xlsxioreader file) { xlsxioread_close(file); };
-    std::unique_ptr<xlsxio_read_struct, std::function<void(xlsxioreader)>>
-        xlsxioread {xlsxioread_open_memory (const_cast<char*>(content_.data()), content_.size(), 0), file_closer};
-
     std::vector<std::string> results;
-
-    if (xlsxioread)
+    for (const auto& sheet : workbook_->sheets_)
     {
-        auto list_closer = [](xlsxioreadersheetlist sheet_list) { xlsxioread_sheetlist_close(sheet_list); };
-
-        std::unique_ptr<xlsxio_read_sheetlist_struct, std::function<void(xlsxioreadersheetlist)>> temp_list =
-            {xlsxioread_sheetlist_open(xlsxioread.get()), list_closer};
-        if (temp_list)
-        {
-            const XLSXIOCHAR* tempname = nullptr;
-            while ((tempname = xlsxioread_sheetlist_next(temp_list.get())) != nullptr)
-            {
-                results.emplace_back(std::string{tempname});
-                results.back() |= ranges::actions::transform([](unsigned char c) { return std::tolower(c); });
-            }
-        }
+        results.push_back(sheet.sheet_name_lc_);
     }
     return results;
 }		// -----  end of method XLS_File::GetSheetNames  ----- 
 
 std::optional<XLS_Sheet> XLS_File::FindSheetByName (EM::sv sheet_name) const
 {
-    std::string looking_for{sheet_name};
-    looking_for |= ranges::actions::transform([](unsigned char c) { return std::tolower(c); });
-
-    if (! sheet_name.empty())
+    if (! sheet_name.empty() && workbook_)
     {
-        auto pos = ranges::find_if(*this, [looking_for] (auto& x) { return x.GetSheetName() == looking_for; });
-        if (pos != this->end())
+        const auto looking_for = ToLower(std::string{sheet_name});
+        auto pos = ranges::find_if(workbook_->sheets_, [&looking_for] (const auto& x) { return x.sheet_name_lc_ == looking_for; });
+        if (pos != workbook_->sheets_.end())
         {
-            return std::optional{*pos};
+            return XLS_Sheet{workbook_, static_cast<std::size_t>(pos - workbook_->sheets_.begin())};
         }
     }
     return std::nullopt;
@@ -152,15 +237,15 @@ std::optional<XLS_Sheet> XLS_File::FindSheetByName (EM::sv sheet_name) const
 
 std::optional<XLS_Sheet> XLS_File::FindSheetByInternalName (EM::sv sheet_name) const
 {
-    std::string looking_for{sheet_name};
-    looking_for |= ranges::actions::transform([](unsigned char c) { return std::tolower(c); });
-
-    if (! sheet_name.empty())
+    if (! sheet_name.empty() && workbook_)
     {
-        auto pos = ranges::find_if(*this, [looking_for] (auto& x) { return x.GetSheetNameFromInside() == looking_for; });
-        if (pos != this->end())
+        const auto looking_for = ToLower(std::string{sheet_name});
+        for (std::size_t sheet_index = 0; sheet_index < workbook_->sheets_.size(); ++sheet_index)
         {
-            return std::optional{*pos};
+            if (workbook_->GetSheetNameFromInside(sheet_index) == looking_for)
+            {
+                return XLS_Sheet{workbook_, sheet_index};
+            }
         }
     }
     return std::nullopt;
@@ -173,216 +258,36 @@ std::optional<XLS_Sheet> XLS_File::FindSheetByInternalName (EM::sv sheet_name) c
 // Description:  constructor
 //--------------------------------------------------------------------------------------
 
-XLS_File::sheet_itor::sheet_itor (const std::vector<char>* content)
-    : content_{content}
-{
-    if (content_ == nullptr)
-    {
-        return;
-    }
-
-    // it's possible we won't be able to read the data in which case
-    // our handle will be null.  All downstream classes should be prepared for this.
-
-    xlsxioread_ = xlsxioread_open_memory (const_cast<char*>(content_->data()), content_->size(), 0);
-
-    if (xlsxioread_ == nullptr)
-    {
-        return;
-    }
-    sheet_list_ = xlsxioread_sheetlist_open(xlsxioread_);
-    if (sheet_list_ == nullptr)
-    {
-        xlsxioread_close(xlsxioread_);
-        xlsxioread_ = nullptr;
-        return;
-    }
-
-    sheet_name_ = xlsxioread_sheetlist_next(sheet_list_);
-    if (sheet_name_ == nullptr)
-    {
-        // end of sheets
-        xlsxioread_sheetlist_close(sheet_list_);
-        sheet_list_ = nullptr;
-        xlsxioread_close(xlsxioread_);
-        xlsxioread_ = nullptr;
-        return;
-    }
-
-    current_sheet_ = {content_, sheet_name_};
-
-}  // -----  end of method XLS_File::sheet_itor::sheet_itor  (constructor)  ----- 
-
-XLS_File::sheet_itor::sheet_itor (const sheet_itor& rhs)
-    : content_{rhs.content_}
+XLS_File::sheet_itor::sheet_itor (std::shared_ptr<const XLS_Workbook> workbook)
+    : workbook_{std::move(workbook)}
 {
-    if (content_ == nullptr || rhs.sheet_name_ == nullptr)
-    {
-        return;
-    }
-
-    xlsxioread_ = xlsxioread_open_memory (const_cast<char*>(content_->data()), content_->size(), 0);
-
-    if (xlsxioread_ == nullptr)
-    {
-        return;
-    }
-
-    sheet_list_ = xlsxioread_sheetlist_open(xlsxioread_);
-    if (sheet_list_ == nullptr)
+    if (! workbook_ || workbook_->sheets_.empty())
     {
-        xlsxioread_close(xlsxioread_);
-        xlsxioread_ = nullptr;
+        workbook_.reset();
         return;
     }
 
-    // need to match position of rhs.
-
-    while (current_sheet_ != rhs.current_sheet_)
-    {
-        this->operator ++();
-    }
+    current_sheet_ = {workbook_, sheet_index_};
 
 }  // -----  end of method XLS_File::sheet_itor::sheet_itor  (constructor)  ----- 
 
-XLS_File::sheet_itor::sheet_itor (sheet_itor&& rhs) noexcept
-
-{
-    content_ = rhs.content_;
-    sheet_name_ = rhs.sheet_name_;
-    xlsxioread_ = rhs.xlsxioread_;
-    sheet_list_ = rhs.sheet_list_;
-    current_sheet_ = std::move(rhs.current_sheet_);
-
-    rhs.content_ = nullptr;
-    rhs.sheet_name_ = nullptr;
-    rhs.xlsxioread_ = nullptr;
-    rhs.sheet_list_ = nullptr;
-
-}  // -----  end of method XLS_File::sheet_itor::sheet_itor  (constructor)  ----- 
-
-XLS_File::sheet_itor::~sheet_itor ()
-{
-    if (sheet_list_ != nullptr)
-    {
-        xlsxioread_sheetlist_close(sheet_list_);
-    }
-    if (xlsxioread_ != nullptr)
-    {
-        xlsxioread_close(xlsxioread_);
-    }
-}  // -----  end of method XLS_File::sheet_itor::sheet_itor  (constructor)  ----- 
-
-XLS_File::sheet_itor& XLS_File::sheet_itor::operator = (const sheet_itor& rhs)
+XLS_File::sheet_itor& XLS_File::sheet_itor::operator++ ()
 {
-    if (&rhs != this)
+    if (! workbook_)
     {
-        if (sheet_list_ != nullptr)
-        {
-            xlsxioread_sheetlist_close(sheet_list_);
-            sheet_list_ = nullptr;
-        }
-        if (xlsxioread_ != nullptr)
-        {
-            xlsxioread_close(xlsxioread_);
-            xlsxioread_ = nullptr;
-        }
-        sheet_name_ = nullptr;
-        current_sheet_ = {};
-
-        content_ = rhs.content_;
-
-        xlsxioread_ = xlsxioread_open_memory (const_cast<char*>(content_->data()), content_->size(), 0);
-
-        if (xlsxioread_ == nullptr)
-        {
-            return *this;
-        }
-
-        sheet_list_ = xlsxioread_sheetlist_open(xlsxioread_);
-        if (sheet_list_ == nullptr)
-        {
-            xlsxioread_close(xlsxioread_);
-            xlsxioread_ = nullptr;
-            return *this;
-        }
-
-        // need to match position of rhs.
-
-        while (true)
-        {
-            sheet_name_ = xlsxioread_sheetlist_next(sheet_list_);
-            if (sheet_name_ == nullptr)
-            {
-                break;
-            }
-            if (strcmp(sheet_name_, rhs.sheet_name_) == 0)
-            {
-                break;
-            }
-        };
-
-        if (sheet_name_ == nullptr)
-        {
-            // end of sheets
-            xlsxioread_sheetlist_close(sheet_list_);
-            sheet_list_ = nullptr;
-            xlsxioread_close(xlsxioread_);
-            xlsxioread_ = nullptr;
-            return *this;
-        }
-
-        current_sheet_ = {content_, sheet_name_};
+        return *this;
     }
-    return *this;
-}		// -----  end of method XLS_File::sheet_itor::operator =  ----- 
-
-XLS_File::sheet_itor& XLS_File::sheet_itor::operator = (sheet_itor&& rhs)
-{
-    if (&rhs != this)
+    if (++sheet_index_ >= workbook_->sheets_.size())
     {
-        if (sheet_list_ != nullptr)
-        {
-            xlsxioread_sheetlist_close(sheet_list_);
-            sheet_list_ = nullptr;
-        }
-        if (xlsxioread_ != nullptr)
-        {
-            xlsxioread_close(xlsxioread_);
-            xlsxioread_ = nullptr;
-        }
-        sheet_name_ = nullptr;
-        current_sheet_ = {};
-
-        content_ = rhs.content_;
-        sheet_name_ = rhs.sheet_name_;
-        xlsxioread_ = rhs.xlsxioread_;
-        sheet_list_ = rhs.sheet_list_;
-        current_sheet_ = std::move(rhs.current_sheet_);
-
-        rhs.content_ = nullptr;
-        rhs.sheet_name_ = nullptr;
-        rhs.xlsxioread_ = nullptr;
-        rhs.sheet_list_ = nullptr;
-    }
-    return *this;
-}		// -----  end of method XLS_File::sheet_itor::operator =  ----- 
-
+        // end of sheets
 
-XLS_File::sheet_itor& XLS_File::sheet_itor::operator++ ()
-{
-    sheet_name_ = xlsxioread_sheetlist_next(sheet_list_);
-    if (sheet_name_ == nullptr)
-    {
-        xlsxioread_sheetlist_close(sheet_list_);
-        sheet_list_ = nullptr;
-        xlsxioread_close(xlsxioread_);
-        xlsxioread_ = nullptr;
+        workbook_.reset();
+        sheet_index_ = 0;
         current_sheet_ = {};
         return *this;
     }
 
-    current_sheet_ = {content_, sheet_name_};
+    current_sheet_ = {workbook_, sheet_index_};
     return *this;
 }		// -----  end of method XLS_File::sheet_itor::operator++  ----- 
 
@@ -392,101 +297,35 @@ XLS_File::sheet_itor& XLS_File::sheet_itor::operator++ ()
 //      Method:  XLS_Sheet
 // Description:  constructor
 //--------------------------------------------------------------------------------------
-XLS_Sheet::XLS_Sheet (const std::vector<char>* content, const XLSXIOCHAR* sheet_name)
-    : content_{content}, sheet_name_mc_{sheet_name}
-{
-    ranges::transform(sheet_name_mc_, ranges::back_inserter(sheet_name_lc_), [](unsigned char c) { return std::tolower(c); });
-
-}  // -----  end of method XLS_Sheet::XLS_Sheet  (constructor)  ----- 
-
-XLS_Sheet::XLS_Sheet (const XLS_Sheet& rhs)
-    : content_{rhs.content_}, sheet_name_mc_{rhs.sheet_name_mc_},
-    extended_sheet_name_{rhs.extended_sheet_name_}, sheet_name_lc_{rhs.sheet_name_lc_}
-{
-}  // -----  end of method XLS_Sheet::XLS_Sheet  (constructor)  ----- 
-
-XLS_Sheet::XLS_Sheet (XLS_Sheet&& rhs) noexcept
-    : content_{rhs.content_}, extended_sheet_name_{std::move(rhs.extended_sheet_name_)},
-    sheet_name_mc_{std::move(rhs.sheet_name_mc_)}, sheet_name_lc_{std::move(rhs.sheet_name_lc_)}
+XLS_Sheet::XLS_Sheet (std::shared_ptr<const XLS_Workbook> workbook, std::size_t sheet_index)
+    : workbook_{std::move(workbook)}, sheet_index_{sheet_index}
 {
-    rhs.content_ = nullptr;
+    BOOST_ASSERT_MSG(! workbook_ || sheet_index_ < workbook_->sheets_.size(), "Sheet index is past the last sheet.");
 
 }  // -----  end of method XLS_Sheet::XLS_Sheet  (constructor)  ----- 
 
-XLS_Sheet& XLS_Sheet::operator = (const XLS_Sheet& rhs)
+const std::string& XLS_Sheet::GetSheetName () const
 {
-    if (&rhs != this)
-    {
-        content_ = rhs.content_;
-        extended_sheet_name_ = rhs.extended_sheet_name_;
-        sheet_name_mc_ = rhs.sheet_name_mc_;
-        sheet_name_lc_ = rhs.sheet_name_lc_;
-    }
-    return *this;
-}		// -----  end of method XLS_Sheet::operator =  ----- 
+    static const std::string no_name;
 
-XLS_Sheet& XLS_Sheet::operator = (XLS_Sheet&& rhs)
-{
-    if (&rhs != this)
-    {
-        content_ = rhs.content_;
-        extended_sheet_name_ = std::move(rhs.extended_sheet_name_);
-        sheet_name_mc_ = std::move(rhs.sheet_name_mc_);
-        sheet_name_lc_ = std::move(rhs.sheet_name_lc_);
-
-        rhs.content_ = nullptr;
-    }
-    return *this;
-}		// -----  end of method XLS_Sheet::operator =  ----- 
+    return workbook_ ? workbook_->sheets_[sheet_index_].sheet_name_lc_ : no_name;
+}		// -----  end of method XLS_Sheet::GetSheetName  ----- 
 
 const std::string& XLS_Sheet::GetSheetNameFromInside () const
 {
-    // we need to go and read the cells from our sheet
-    // and get the content of the first cell.
-
-    if (! extended_sheet_name_.empty())
-    {
-        // use cached result
-
-        return extended_sheet_name_;
-    }
-
-    auto file_closer = [](xlsxioreader file) { xlsxioread_close(file); };
-    std::unique_ptr<xlsxio_read_struct, std::function<void(xlsxioreader)>>
-        xlsxioread {xlsxioread_open_memory (const_cast<char*>(content_->data()), content_->size(), 0), file_closer};
+    static const std::string no_name;
 
-    auto sheet_closer = [](xlsxioreadersheet sheet_reader) { xlsxioread_sheet_close(sheet_reader); };
-
-    if (xlsxioread && ! sheet_name_mc_.empty())
-    {
-        std::unique_ptr<xlsxio_read_sheet_struct, std::function<void(xlsxioreadersheet)>> temp_sheet =
-            {xlsxioread_sheet_open(xlsxioread.get(), sheet_name_mc_.c_str(), 0), sheet_closer};
-        if (temp_sheet)
-        {
-            row_itor itor{content_, sheet_name_mc_};
-            if (itor != row_itor{})
-            {
-                // tab delimited content
-                std::string first_row = *itor;
-                if (! first_row.empty())
-                {
-                    extended_sheet_name_ = first_row.substr(0, first_row.find('\t'));
-                    extended_sheet_name_ |= ranges::actions::transform([](unsigned char c) { return std::tolower(c); });
-                }
-            }
-        }
-    }
-    return extended_sheet_name_;
+    return workbook_ ? workbook_->GetSheetNameFromInside(sheet_index_) : no_name;
 }		// -----  end of method XLS_Sheet::GetSheetNameFromInside  ----- 
 
 XLS_Sheet::iterator XLS_Sheet::begin ()
 {
-    return {content_, sheet_name_mc_};
+    return {workbook_, sheet_index_};
 }		// -----  end of method XLS_Sheet::begin  ----- 
 
 XLS_Sheet::const_iterator XLS_Sheet::begin () const
 {
-    return {content_, sheet_name_mc_};
+    return {workbook_, sheet_index_};
 }		// -----  end of method XLS_Sheet::begin  ----- 
 
 XLS_Sheet::iterator XLS_Sheet::end ()
@@ -504,53 +343,34 @@ XLS_Sheet::const_iterator XLS_Sheet::end () const
 //      Method:  XLS_Sheet::row_itor
 // Description:  constructor
 //--------------------------------------------------------------------------------------
-XLS_Sheet::row_itor::row_itor (const std::vector<char>* content, const std::string& sheet_name)
-    : content_{content}, sheet_name_mc_{sheet_name}
+XLS_Sheet::row_itor::row_itor (std::shared_ptr<const XLS_Workbook> workbook, std::size_t sheet_index)
+    : workbook_{std::move(workbook)}, sheet_index_{sheet_index}
 {
-    if (content == nullptr || sheet_name.empty())
-    {
-        content_ = nullptr;
-        sheet_name_mc_ = {};
-        return;
-    }
-    xlsxioread_ = xlsxioread_open_memory (const_cast<char*>(content_->data()), content_->size(), 0);
-
-    if (xlsxioread_ == nullptr)
-    {
-        content_ = nullptr;
-        sheet_name_mc_ = {};
-        return;
-    }
-
-    current_sheet_ = xlsxioread_sheet_open(xlsxioread_, sheet_name_mc_.c_str(), 0);
-    if (current_sheet_ == nullptr)
-    {
-        xlsxioread_close(xlsxioread_);
-        xlsxioread_ = nullptr;
-        content_ = nullptr;
-        sheet_name_mc_ = {};
-        return;
-    }
-
+    OpenSheet();
     this->operator++();
 
 }  // -----  end of method XLS_Sheet::row_itor::row_itor  (constructor)  ----- 
 
 XLS_Sheet::row_itor::row_itor (const row_itor& rhs)
-    : row_itor(rhs.content_, rhs.sheet_name_mc_)
+    : workbook_{rhs.workbook_}, sheet_index_{rhs.sheet_index_}
 {
-    while (current_row_ != rhs.current_row_)
+    // a sheet reader can't be copied so we open our own on the same
+    // workbook and catch up to rhs.
+
+    OpenSheet();
+    while (current_sheet_ != nullptr && rows_read_ < rhs.rows_read_)
     {
         this->operator++();
     }
 }  // -----  end of method XLS_Sheet::row_itor::row_itor  (constructor)  ----- 
 
 XLS_Sheet::row_itor::row_itor (row_itor&& rhs) noexcept
-    : content_{rhs.content_}, xlsxioread_{rhs.xlsxioread_}, current_sheet_{rhs.current_sheet_},   sheet_name_mc_{std::move(rhs.sheet_name_mc_)}, current_row_{std::move(rhs.current_row_)}
+    : workbook_{std::move(rhs.workbook_)}, sheet_index_{rhs.sheet_index_}, current_sheet_{rhs.current_sheet_},
+    rows_read_{rhs.rows_read_}, current_cells_{std::move(rhs.current_cells_)}, current_row_{std::move(rhs.current_row_)},
+    have_row_text_{rhs.have_row_text_}
 {
-    rhs.content_ = nullptr;
-    rhs.xlsxioread_ = nullptr;
     rhs.current_sheet_ = nullptr;
+    rhs.rows_read_ = 0;
 
 }  // -----  end of method XLS_Sheet::row_itor::row_itor  (constructor)  ----- 
 
@@ -560,12 +380,23 @@ XLS_Sheet::row_itor::~row_itor ()
     {
         xlsxioread_sheet_close(current_sheet_);
     }
-    if (xlsxioread_ != nullptr)
+
+}  // -----  end of method XLS_Sheet::XLS_Sheet  (destructor)  ----- 
+
+void XLS_Sheet::row_itor::OpenSheet ()
+{
+    if (! workbook_ || workbook_->xlsxioread_ == nullptr || sheet_index_ >= workbook_->sheets_.size())
     {
-        xlsxioread_close(xlsxioread_);
+        workbook_.reset();
+        return;
     }
 
-}  // -----  end of method XLS_Sheet::XLS_Sheet  (destructor)  ----- 
+    current_sheet_ = xlsxioread_sheet_open(workbook_->xlsxioread_, workbook_->sheets_[sheet_index_].sheet_name_mc_.c_str(), 0);
+    if (current_sheet_ == nullptr)
+    {
+        workbook_.reset();
+    }
+}		// -----  end of method XLS_Sheet::row_itor::OpenSheet  ----- 
 
 XLS_Sheet::row_itor& XLS_Sheet::row_itor::operator=(const row_itor& rhs) 
 {
@@ -576,34 +407,17 @@ XLS_Sheet::row_itor& XLS_Sheet::row_itor::operator=(const row_itor& rhs)
             xlsxioread_sheet_close(current_sheet_);
             current_sheet_ = nullptr;
         }
-        if (xlsxioread_ != nullptr)
-        {
-            xlsxioread_close(xlsxioread_);
-            xlsxioread_ = nullptr;
-        }
+        current_cells_.clear();
         current_row_.clear();
-        content_ = rhs.content_;
-        sheet_name_mc_ = rhs.sheet_name_mc_;
-
-        xlsxioread_ = xlsxioread_open_memory (const_cast<char*>(content_->data()), content_->size(), 0);
+        have_row_text_ = false;
+        rows_read_ = 0;
+        workbook_ = rhs.workbook_;
+        sheet_index_ = rhs.sheet_index_;
 
-        if (xlsxioread_ == nullptr || sheet_name_mc_.empty())
-        {
-            xlsxioread_close(xlsxioread_);
-            xlsxioread_ = nullptr;
-            return *this;
-        }
-        current_sheet_ = xlsxioread_sheet_open(xlsxioread_, sheet_name_mc_.c_str(), 0);
-        if (current_sheet_ == nullptr)
-        {
-            xlsxioread_close(xlsxioread_);
-            xlsxioread_ = nullptr;
-            sheet_name_mc_ = {};
-            return *this;
-        }
         // we need to match up to the rhs
-        //
-        while (current_row_ != rhs.current_row_)
+
+        OpenSheet();
+        while (current_sheet_ != nullptr && rows_read_ < rhs.rows_read_)
         {
             this->operator++();
         }
@@ -620,21 +434,17 @@ XLS_Sheet::row_itor& XLS_Sheet::row_itor::operator=(row_itor&& rhs) noexcept
             xlsxioread_sheet_close(current_sheet_);
             current_sheet_ = nullptr;
         }
-        if (xlsxioread_ != nullptr)
-        {
-            xlsxioread_close(xlsxioread_);
-            xlsxioread_ = nullptr;
-        }
 
-        content_ = rhs.content_;
-        xlsxioread_ = rhs.xlsxioread_;
+        workbook_ = std::move(rhs.workbook_);
+        sheet_index_ = rhs.sheet_index_;
         current_sheet_ = rhs.current_sheet_;
-        sheet_name_mc_ = std::move(rhs.sheet_name_mc_);
+        rows_read_ = rhs.rows_read_;
+        current_cells_ = std::move(rhs.current_cells_);
         current_row_ = std::move(rhs.current_row_);
+        have_row_text_ = rhs.have_row_text_;
 
-        rhs.content_ = nullptr;
-        rhs.xlsxioread_ = nullptr;
         rhs.current_sheet_ = nullptr;
+        rhs.rows_read_ = 0;
     }
     return *this;
 }
@@ -646,36 +456,52 @@ XLS_Sheet::row_itor& XLS_Sheet::row_itor::operator++ ()
         return *this;
     }
 
-    auto got_row = xlsxioread_sheet_next_row(current_sheet_);
-    if (! got_row)
+    have_row_text_ = false;
+    if (! ReadNextRow(current_sheet_, current_cells_))
     {
         xlsxioread_sheet_close(current_sheet_);
         current_sheet_ = nullptr;
-        xlsxioread_close(xlsxioread_);
-        xlsxioread_ = nullptr;
-        content_ = nullptr;
-        current_row_.clear();
-        sheet_name_mc_ = {};
+        workbook_.reset();
+        rows_read_ = 0;
         return *this;
     }
 
-    current_row_.clear();
+    ++rows_read_;
+    return *this;
+}		// -----  end of method XLS_Sheet::row_itor::operator++  ----- 
 
-    // let's build this just once
-    auto cell_deleter = [](XLSXIOCHAR* cell) { if (cell) free(cell); };
+std::string& XLS_Sheet::row_itor::GetRowText () const
+{
+    if (! have_row_text_)
+    {
+        current_row_ = current_sheet_ != nullptr ? current_cells_.AsText() : std::string{};
+        have_row_text_ = true;
+    }
+    return current_row_;
+}		// -----  end of method XLS_Sheet::row_itor::GetRowText  ----- 
 
-    while (true)
+//--------------------------------------------------------------------------------------
+//       Class:  XLS_Row
+//      Method:  XLS_Row
+// Description:  
+//--------------------------------------------------------------------------------------
+
+void XLS_Row::AddCell (const char* cell_text)
+{
+    cells_ += cell_text;
+    cell_ends_.push_back(cells_.size());
+}		// -----  end of method XLS_Row::AddCell  ----- 
+
+std::string XLS_Row::AsText () const
+{
+    std::string row;
+    row.reserve(cells_.size() + cell_ends_.size() + 1);
+    for (std::size_t column = 0; column < cell_ends_.size(); ++column)
     {
-        std::unique_ptr<XLSXIOCHAR, std::function<void(XLSXIOCHAR*)>> next_cell =
-            {xlsxioread_sheet_next_cell(current_sheet_), cell_deleter};
-        if (! next_cell)
-        {
-            break;
-        }
-        current_row_ += next_cell.get();
-        current_row_ += '\t';
+        row += this->operator[](column);
+        row += '\t';
     }
-    current_row_ += '\n';
-    return *this;
-}		// -----  end of method XLS_Sheet::row_itor::operator++  ----- 
+    row += '\n';
+    return row;
+}		// -----  end of method XLS_Row::AsText  ----- 
 
@@ -29,11 +29,22 @@
 #include "Extractor.h"
 
 class XLS_Sheet;
-class XLS_Row;
+
+// the opened archive and our index of its sheets. Shared by a file, its
+// sheets and their iterators.
+
+struct XLS_Workbook;
 
 // =====================================================================================
 //        Class:  XLS_File
 //  Description: manage access to XLS data. 
+//
+//               We open the archive once and index its sheets: the name xlsxio
+//               knows each sheet by and, once asked for, the title in its first
+//               cell.  Sheets and iterators just share that so copying them is cheap.
+//
+//               The archive has a single reader so an XLS_File and its copies
+//               should only be used on 1 thread at a time.
 // =====================================================================================
 
 class XLS_File
@@ -59,8 +70,8 @@ public:
     // ====================  LIFECYCLE     ======================================= 
 
     XLS_File () = default;                             // constructor 
-    XLS_File(const XLS_File& rhs);
-    XLS_File(XLS_File&& rhs) noexcept;
+    XLS_File(const XLS_File& rhs) = default;
+    XLS_File(XLS_File&& rhs) noexcept = default;
 
     XLS_File(const std::vector<char>& content);
     XLS_File(std::vector<char>&& content);
@@ -74,7 +85,7 @@ public:
     [[nodiscard]] iterator end();
     [[nodiscard]] const_iterator end() const;
 
-    [[nodiscard]] bool empty() const { return content_.empty(); }
+    [[nodiscard]] bool empty() const;
 
     std::vector<std::string> GetSheetNames(void) const;
 
@@ -85,8 +96,8 @@ public:
 
     // ====================  OPERATORS     ======================================= 
 
-    XLS_File& operator =(const XLS_File& rhs);
-    XLS_File& operator =(XLS_File&& rhs) noexcept;
+    XLS_File& operator =(const XLS_File& rhs) = default;
+    XLS_File& operator =(XLS_File&& rhs) noexcept = default;
 
 
 protected:
@@ -100,7 +111,7 @@ private:
 
     // ====================  DATA MEMBERS  ======================================= 
 
-    std::vector<char> content_;
+    std::shared_ptr<const XLS_Workbook> workbook_;
 
 
 }; // -----  end of class XLS_File  ----- 
@@ -131,10 +142,10 @@ public:
     // ====================  LIFECYCLE     ======================================= 
 
     XLS_Sheet () = default;                             // constructor 
-    XLS_Sheet(const std::vector<char>* content, const XLSXIOCHAR* sheet_name);
+    XLS_Sheet(std::shared_ptr<const XLS_Workbook> workbook, std::size_t sheet_index);
     
-    XLS_Sheet(const XLS_Sheet& rhs);
-    XLS_Sheet(XLS_Sheet&& rhs) noexcept;
+    XLS_Sheet(const XLS_Sheet& rhs) = default;
+    XLS_Sheet(XLS_Sheet&& rhs) noexcept = default;
 
     ~XLS_Sheet() = default;
 
@@ -145,22 +156,22 @@ public:
     [[nodiscard]] iterator end();
     [[nodiscard]] const_iterator end() const;
 
-    [[nodiscard]] bool empty() const { return sheet_name_lc_.empty(); }
+    [[nodiscard]] bool empty() const { return ! workbook_; }
 
-    const std::string& GetSheetName() const { return sheet_name_lc_ ; }
-    const std::string& GetSheetNameFromInside() const ;
+    const std::string& GetSheetName() const;
+    const std::string& GetSheetNameFromInside() const;
 
     // ====================  MUTATORS      ======================================= 
 
     // ====================  OPERATORS     ======================================= 
 
-    XLS_Sheet& operator = (const XLS_Sheet& rhs);
-    XLS_Sheet& operator = (XLS_Sheet&& rhs);
+    XLS_Sheet& operator = (const XLS_Sheet& rhs) = default;
+    XLS_Sheet& operator = (XLS_Sheet&& rhs) noexcept = default;
 
     bool operator==(const XLS_Sheet& rhs) const
         { 
-            return content_ == rhs.content_
-                && sheet_name_mc_ == rhs.sheet_name_mc_;
+            return workbook_ == rhs.workbook_
+                && sheet_index_ == rhs.sheet_index_;
         }
     bool operator!=(const XLS_Sheet& rhs) const { return !(*this == rhs); }
 
@@ -174,11 +185,8 @@ private:
 
     // ====================  DATA MEMBERS  ======================================= 
 
-    const std::vector<char>* content_ = nullptr;
-
-    mutable std::string extended_sheet_name_;
-    mutable std::string sheet_name_lc_;
-    mutable std::string sheet_name_mc_;
+    std::shared_ptr<const XLS_Workbook> workbook_;
+    std::size_t sheet_index_ = 0;
 
 }; // -----  end of class XLS_Sheet  ----- 
 
@@ -205,12 +213,12 @@ public:
     // ====================  LIFECYCLE     ======================================= 
 
     sheet_itor () = default;                             // constructor 
-    sheet_itor (const std::vector<char>* content);
+    sheet_itor (std::shared_ptr<const XLS_Workbook> workbook);
 
-    sheet_itor (const sheet_itor& rhs);
-    sheet_itor (sheet_itor&& rhs) noexcept;
+    sheet_itor (const sheet_itor& rhs) = default;
+    sheet_itor (sheet_itor&& rhs) noexcept = default;
 
-    ~sheet_itor ();
+    ~sheet_itor () = default;
 
     // ====================  ACCESSORS     ======================================= 
 
@@ -221,12 +229,12 @@ public:
 
     // ====================  OPERATORS     ======================================= 
 
-    sheet_itor& operator = (const sheet_itor& rhs);
-    sheet_itor& operator = (sheet_itor&& rhs);
+    sheet_itor& operator = (const sheet_itor& rhs) = default;
+    sheet_itor& operator = (sheet_itor&& rhs) noexcept = default;
 
     bool operator==(const sheet_itor& rhs) const
         { 
-            return sheet_list_ == rhs.sheet_list_ && sheet_name_ == rhs.sheet_name_;
+            return current_sheet_ == rhs.current_sheet_;
         }
     bool operator!=(const sheet_itor& rhs) const { return !(*this == rhs); }
 
@@ -245,17 +253,73 @@ private:
 
     // ====================  DATA MEMBERS  ======================================= 
 
-    const std::vector<char>* content_ = nullptr;
-    const XLSXIOCHAR* sheet_name_ = nullptr;
-
-    xlsxioreader xlsxioread_ = nullptr;
-    xlsxioreadersheetlist sheet_list_ = nullptr;
+    std::shared_ptr<const XLS_Workbook> workbook_;
+    std::size_t sheet_index_ = 0;
 
     mutable XLS_Sheet current_sheet_;
 
 }; // -----  end of class XLS_File::sheet_itor  ----- 
 
 
+// =====================================================================================
+//        Class:  XLS_Row
+//  Description:  the cells of 1 row.  Cell text is kept back to back in a single
+//                buffer which the row iterator reuses for every row so reading a
+//                row doesn't allocate once the buffer has grown big enough.
+//
+//                Views we hand out are good until the iterator moves.
+// =====================================================================================
+class XLS_Row
+{
+public:
+    // ====================  LIFECYCLE     ======================================= 
+
+    XLS_Row () = default;                             // constructor 
+
+    // ====================  ACCESSORS     ======================================= 
+
+    [[nodiscard]] std::size_t size() const { return cell_ends_.size(); }
+    [[nodiscard]] bool empty() const { return cell_ends_.empty(); }
+
+    // tab delimited cells with a trailing newline.
+
+    [[nodiscard]] std::string AsText() const;
+
+    // ====================  MUTATORS      ======================================= 
+
+    void clear() { cells_.clear(); cell_ends_.clear(); }
+    void AddCell(const char* cell_text);
+
+    // ====================  OPERATORS     ======================================= 
+
+    // asking for a cell past the end gives an empty cell.
+
+    EM::sv operator[](std::size_t column) const
+    {
+        if (column >= cell_ends_.size())
+        {
+            return {};
+        }
+        const auto cell_begin = column == 0 ? 0 : cell_ends_[column - 1];
+        return EM::sv{cells_}.substr(cell_begin, cell_ends_[column] - cell_begin);
+    }
+
+protected:
+    // ====================  METHODS       ======================================= 
+
+    // ====================  DATA MEMBERS  ======================================= 
+
+private:
+    // ====================  METHODS       ======================================= 
+
+    // ====================  DATA MEMBERS  ======================================= 
+
+    std::string cells_;
+    std::vector<std::size_t> cell_ends_;
+
+}; // -----  end of class XLS_Row  ----- 
+
+
 // =====================================================================================
 //        Class:  XLS_Sheet::row_itor
 //  Description:  extracts value pairs from the XLS sheet data 
@@ -276,7 +340,7 @@ public:
 public:
     // ====================  LIFECYCLE     ======================================= 
     row_itor () = default;                             // constructor 
-    row_itor(const std::vector<char>* content, const std::string& sheet_name);
+    row_itor(std::shared_ptr<const XLS_Workbook> workbook, std::size_t sheet_index);
 
     row_itor(const row_itor& rhs);
     row_itor(row_itor&& rhs) noexcept;
@@ -285,6 +349,11 @@ public:
 
     // ====================  ACCESSORS     ======================================= 
 
+    // the current row's cells.  Dereferencing gives the same row as tab
+    // delimited text.
+
+    [[nodiscard]] const XLS_Row& GetRow() const { return current_cells_; }
+
     // ====================  MUTATORS      ======================================= 
 
     row_itor& operator++();
@@ -298,14 +367,14 @@ public:
     bool operator==(const row_itor& rhs) const
     { 
         return current_sheet_ == rhs.current_sheet_
-            && current_row_ == rhs.current_row_;
+            && rows_read_ == rhs.rows_read_;
     }
     bool operator!=(const row_itor& rhs) const { return !(*this == rhs); }
 
-    reference operator*() { return current_row_; }
-    const_reference operator*() const { return current_row_; }
-    pointer operator->() { return &current_row_; }
-    const_pointer operator->() const { return &current_row_; }
+    reference operator*() { return GetRowText(); }
+    const_reference operator*() const { return GetRowText(); }
+    pointer operator->() { return &GetRowText(); }
+    const_pointer operator->() const { return &GetRowText(); }
 
 protected:
     // ====================  METHODS       ======================================= 
@@ -315,14 +384,22 @@ protected:
 private:
     // ====================  METHODS       ======================================= 
 
+    void OpenSheet();
+
+    // we only build the text version of a row if someone asks for it.
+
+    std::string& GetRowText() const;
+
     // ====================  DATA MEMBERS  ======================================= 
 
-    const std::vector<char>* content_ = nullptr;
-    xlsxioreader xlsxioread_ = nullptr;
+    std::shared_ptr<const XLS_Workbook> workbook_;
+    std::size_t sheet_index_ = 0;
     xlsxioreadersheet  current_sheet_ = nullptr;
+    std::size_t rows_read_ = 0;
     
-    mutable std::string sheet_name_mc_;
+    XLS_Row current_cells_;
     mutable std::string current_row_;
+    mutable bool have_row_text_ = false;
 
 }; // -----  end of class XLS_Sheet::row_itor  ----- 
 